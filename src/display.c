@@ -25,12 +25,12 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "display.h"
+#include "lookup.h"
 #include "tim2_task.h"
 #include "ch32fun.h"
 #include <stdlib.h>
 
 #define DISPLAY_I2C_ADDR (0x3C)
-#define DISPLAY_I2C_CLOCKRATE (100000) // SSD1306 supports up to 400kHz
 #define DISPLAY_I2C_ERROR_FLAGS (I2C_STAR1_PECERR|I2C_STAR1_OVR|I2C_STAR1_AF|I2C_STAR1_ARLO|I2C_STAR1_BERR)
 
 // Adapted from the sequence in the appendix of the SSD1306 specs
@@ -47,57 +47,128 @@ const static uint8_t display_init_array[] =
 	0xA4, // Entire Display on (0xA4 is display on, 0xA5 is display off)
 	0xA6, // Non-inverted display (0xA7 is inverted display)
 	0xD5, 0x80, // Set oscillator frequency (Fosc=1000b, Fdiv=0000b)
+	0x20, 0x01, // Set memory addressing mode (Vertical addressing mode)
+	0x22, 0x00, 0x03, // Setup page start and end address (0..3)
 	0x8D, 0x14, // Enable charge pump regulator
 	0xAF, // Display ON
 };
 
 
-#define DISPLAY_DATA_COMMAND_SIZE (20)
-#define DISPLAY_DATA_SIZE (DISPLAY_WIDTH*4)
+#define DISPLAY_PAGES (4)
+#define DISPLAY_DATA_SIZE (DISPLAY_WIDTH*DISPLAY_PAGES)
 
-// CONCURRENCY_VARIABLE: read by display_loop() via TIM2 ISR, written by display_clear() / display_draw_*()
-static uint8_t display_data_array[DISPLAY_DATA_COMMAND_SIZE+DISPLAY_DATA_SIZE] = {
-	0x00, 0x00, 0x00, // Padding to make the graphc RAM area align with uint32_t
-	0x80, 0x20, 0x80, 0x21, // Set memory addressing mode (Vertical addressing mode)
-	0x80, 0x21, 0x80, 0x00, 0x80, 0x7F, // Setup column start and end address (0..127)
-	0x80, 0x22, 0x80, 0x00, 0x80, 0x03, // Setup page start and end address (0..3)
+#if DISPLAY_STRIP_RENDERING
+// The images drawn since display_clear(), by codepoint. display_loop() renders the pages out of it.
+// The images that don't fit are dropped. The config scene has the most of them: 16.
+#define DISPLAY_DRAW_LIST_LENGTH_MAX (16)
+#define DISPLAY_DRAW_FLAG_COLUMN (1U<<7) // Internal: the codepoint of the entry is the image of display_draw_column()
+static struct {
+	uint32_t codepoint;
+	int8_t x; // The images that are entirely out of the display aren't in the list
+	int8_t y;
+	uint8_t w; // Before scaling
+	uint8_t flags;
+} display_draw_list[DISPLAY_DRAW_LIST_LENGTH_MAX];
+static uint8_t display_draw_list_length;
+// 1 from display_clear() to display_set_refresh_flag(). display_loop() doesn't render the half-drawn list meanwhile.
+// CONCURRENCY_VARIABLE: written by display_clear() / display_set_refresh_flag(), read by display_loop() via TIM2 ISR
+static uint8_t display_draw_list_recording;
+
+// Each page is divided in chunks. A chunk is sent only if its hash differs from the one of the last time it was sent.
+// There's no copy of the display in RAM to compare with.
+#define DISPLAY_CHUNK_WIDTH (32)
+#define DISPLAY_CHUNKS_PER_PAGE (DISPLAY_WIDTH/DISPLAY_CHUNK_WIDTH)
+static uint32_t display_chunk_hashes[DISPLAY_PAGES*DISPLAY_CHUNKS_PER_PAGE];
+static uint16_t display_chunk_hashes_valid; // 1 bit per chunk. Cleared to send the whole frame again.
+// A chunk with the same hash but different pixels would stay stale on the display for good. The whole frame is sent
+// again every this many frames so that the display recovers from that.
+#define DISPLAY_CHUNK_HASHES_LIFETIME (64U)
+static uint8_t display_chunk_hashes_frames; // Frames since display_chunk_hashes_valid was cleared
+static uint8_t display_strip_page; // The next page to be rendered by display_loop()
+
+// Returned by display_next_window() when there's nothing to send until the next run of display_loop()
+#define DISPLAY_WINDOW_SKIPPED (0xFFFF)
+
+// The window being sent: the commands, followed by the changed chunks of a page rendered by display_render_page().
+#define DISPLAY_WINDOW_COMMAND_SIZE (13)
+static uint8_t display_window_buffer[DISPLAY_WINDOW_COMMAND_SIZE+DISPLAY_WIDTH] = {
+	0x80, 0x21, 0x80, 0x00, 0x80, 0x7F, // Setup column start and end address
+	0x80, 0x22, 0x80, 0x00, 0x80, 0x00, // Setup page start and end address
+	0x40, // all of the subsequent bytes are for OLED graphic RAM data.
+};
+#else
+// Clean columns between two dirty ones that are sent anyway, instead of starting another window. Each window costs
+// the address byte, the start and stop bits and the commands in display_window_buffer, which is about as much as 2 columns.
+#define DISPLAY_WINDOW_MERGE_GAP (2)
+// Longest window. Longer runs of dirty columns are split. Each column costs 4 bytes of RAM in display_window_buffer.
+// Half of a glyph: the whole glyph would cost 32 bytes more, for about 10% fewer bytes on the bus.
+#define DISPLAY_WINDOW_COLUMNS_MAX (8)
+
+// One uint32_t per column, page 0 in the lowest byte. That's the order of the vertical addressing mode of the SSD1306,
+// so that any range of columns can be sent as is.
+// It's never read by the DMA. display_loop() copies each window into display_window_buffer right before sending it,
+// so the next frame can be drawn while the previous one is still being sent. There isn't enough RAM for a second frame.
+// CONCURRENCY_VARIABLE: read by display_loop() via TIM2 ISR, written by display_draw_*() / display_set_refresh_flag()
+static uint32_t display_data_buffer[DISPLAY_WIDTH];
+
+// display_clear() doesn't clear display_data_buffer. Each half of a column keeps what's on the display until it gets
+// drawn, and display_set_refresh_flag() clears the ones that haven't been. That way the columns that changed are known
+// without keeping a copy of the frame on the display. It's exact as long as no half of a column is drawn partly by
+// two images with the same pixels as before, which the scenes of ilonena.c don't do: a row of images covers either
+// half or both of them.
+// 2 bits per column: the halves drawn since display_clear(). Bit 0 is pages 0-1, bit 1 is pages 2-3.
+static uint32_t display_drawn_halves[DISPLAY_WIDTH/16];
+// 1 from display_clear() to display_set_refresh_flag(). display_loop() doesn't pick any window meanwhile, or it
+// might send a column of display_data_buffer that's half-drawn, or that still has stale pages of the previous frame.
+// CONCURRENCY_VARIABLE: written by display_clear() / display_set_refresh_flag(), read by display_loop() via TIM2 ISR
+static uint8_t display_frame_drawing;
+// Columns changed by the frame being drawn. Moved to display_dirty_columns by display_set_refresh_flag().
+static uint32_t display_changed_columns[DISPLAY_WIDTH/32];
+// Columns of display_data_buffer that differ from the display. Sent by display_loop() as windows of consecutive columns.
+// CONCURRENCY_VARIABLE: written by display_set_refresh_flag(), read/written by display_loop() via TIM2 ISR
+static uint32_t display_dirty_columns[DISPLAY_WIDTH/32];
+
+// Bytes of a column covered by each combination of halves
+static const uint32_t display_half_masks[4] = {0x00000000U, 0x0000FFFFU, 0xFFFF0000U, 0xFFFFFFFFU};
+
+// The window being sent: the commands, followed by the graphic data copied from display_data_buffer. The column range
+// is filled by display_loop(). The page range and the vertical addressing mode are set by display_init_array. After
+// sending a whole window, the page pointer of the SSD1306 is back at the start page. An aborted one gets
+// display_init_array sent again.
+#define DISPLAY_WINDOW_COMMAND_SIZE (7)
+static uint8_t display_window_buffer[DISPLAY_WINDOW_COMMAND_SIZE+DISPLAY_WINDOW_COLUMNS_MAX*sizeof(uint32_t)] = {
+	0x80, 0x21, 0x80, 0x00, 0x80, 0x7F, // Setup column start and end address
 	0x40, // all of the subsequent bytes are for OLED graphic RAM data.
-	// 512 bytes of zeros (generated with Python `print((('0x00, '*16)[:-1] + '\n') * 32)`)
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
-static uint8_t *const display_data_dma_start_address = &display_data_array[3];
-static uint32_t *const display_data_buffer = (uint32_t*)&display_data_array[DISPLAY_DATA_COMMAND_SIZE];
+// The window being sent by display_loop()
+static uint8_t display_window_start;
+static uint8_t display_window_end;
+#endif
+
+// I2C clock rates, fastest first. The SSD1306 supports up to 400kHz, but a board with long wires or weak pull-ups might
+// not. display_loop() starts with the first one and falls back to the next one after DISPLAY_I2C_DOWNSHIFT_ERRORS errors.
+// The value of I2C1->CKCFGR is precomputed because there's no hardware divider.
+// The reference manual on I2C clock rate is terrible. I just followed whatever openwch does.
+// Apparently I2C1->CKCFGR.CCR is some sort of clock divider, and the I2C1->CTLR2.FREQ doesn't do much
+// See also: https://kiedontaa.blogspot.com/2024/04/the-confusing-i2c-bit-rate-register-of.html
+#define DISPLAY_I2C_CKCFGR_FAST_MODE(clockrate) (((FUNCONF_SYSTEM_CORE_CLOCK/((clockrate)*3))&I2C_CKCFGR_CCR) | I2C_CKCFGR_FS)
+#define DISPLAY_I2C_CKCFGR_STANDARD_MODE(clockrate) ((FUNCONF_SYSTEM_CORE_CLOCK/((clockrate)*2))&I2C_CKCFGR_CCR)
+static const struct {
+	uint32_t clockrate;
+	uint16_t ckcfgr;
+} display_i2c_clockrates[] = {
+	{400000, DISPLAY_I2C_CKCFGR_FAST_MODE(400000)},
+	{200000, DISPLAY_I2C_CKCFGR_FAST_MODE(200000)},
+	{100000, DISPLAY_I2C_CKCFGR_STANDARD_MODE(100000)},
+};
+#define DISPLAY_I2C_CLOCKRATE_COUNT (sizeof(display_i2c_clockrates)/sizeof(*display_i2c_clockrates))
+// Errors and timeouts that make display_loop() switch to the next clock rate. The count is forgiven every 256 transactions,
+// so that the odd glitch doesn't slow the display down for good.
+#define DISPLAY_I2C_DOWNSHIFT_ERRORS (4)
+static uint8_t display_i2c_clockrate_index = 0;
+static uint8_t display_i2c_recent_errors = 0;
+static uint8_t display_i2c_transactions = 0;
+struct display_i2c_stats display_i2c_stats = {0};
 
 #define DISPLAY_REFRESH_FLAG_INIT (1U<<0)
 #define DISPLAY_REFRESH_FLAG_GRAPHIC (1U<<1)
@@ -118,10 +189,10 @@ enum display_loop_step {
 	DISPLAY_LOOP_STEP_RESET_I2C_SCL_HIGH,
 };
 
-#define DISPLAY_WAIT_SCL_FOR_I2C_RESET (FUNCONF_SYSTEM_CORE_CLOCK/DISPLAY_I2C_CLOCKRATE)
+#define DISPLAY_WAIT_SCL_FOR_I2C_RESET (FUNCONF_SYSTEM_CORE_CLOCK/100000) // Bitbanged at 100kHz, whatever the clock rate in use
 #define DISPLAY_WAIT_BUS_IDLE_TIMEOUT (FUNCONF_SYSTEM_CORE_CLOCK/1000 *3) // 3ms
 #define DISPLAY_TRANSFER_TIMEOUT (FUNCONF_SYSTEM_CORE_CLOCK/1000 *3) // 3ms. For start bit, address and stop bit.
-#define DISPLAY_DMA_TIMEOUT (FUNCONF_SYSTEM_CORE_CLOCK/1000 * 100) // 100ms. It takes 48ms to transfer 530 bytes at 100kHz.
+#define DISPLAY_DMA_TIMEOUT (FUNCONF_SYSTEM_CORE_CLOCK/1000 * 100) // 100ms. It takes 13ms to transfer the longest window at 100kHz, in the strip mode.
 
 // DISPLAY_CFGLR_FLAG: PC1 and PC2, 2Mhz output, open-drain alternative mode
 // DISPLAY_CFGLR_FLAG_I2C_RESET: Same as above except that PC1 (SDA) is floating input mode. For bitbanging I2C reset
@@ -132,21 +203,192 @@ enum display_loop_step {
 
 static void display_i2c_bus_init(void) {
 	DISPLAY_GPIO_PORT->CFGLR = (DISPLAY_GPIO_PORT->CFGLR & ~DISPLAY_CFGLR_MASK) | DISPLAY_CFGLR_FLAG;
-	// Set clock rate in standard I2C mode. Enable DMA mode. Enable ACK mode. Enable I2C
-	// The reference manual on I2C clock rate is terrible. I just followed whatever openwch does.
-	// Apparently I2C1->CKCFGR.CCR is some sort of clock divider, and the I2C1->CTLR2.FREQ doesn't do much
-	// See also: https://kiedontaa.blogspot.com/2024/04/the-confusing-i2c-bit-rate-register-of.html
-	#if (DISPLAY_I2C_CLOCKRATE > 100000)
-		// I2C fast mode
-		I2C1->CKCFGR = ((FUNCONF_SYSTEM_CORE_CLOCK/(DISPLAY_I2C_CLOCKRATE*3))&I2C_CKCFGR_CCR) | I2C_CKCFGR_FS;
-	#else
-		// I2C standard mode
-		I2C1->CKCFGR = (FUNCONF_SYSTEM_CORE_CLOCK/(DISPLAY_I2C_CLOCKRATE*2))&I2C_CKCFGR_CCR;
-	#endif
+	// Set clock rate. Enable DMA mode. Enable ACK mode. Enable I2C
+	I2C1->CKCFGR = display_i2c_clockrates[display_i2c_clockrate_index].ckcfgr;
+	display_i2c_stats.clockrate = display_i2c_clockrates[display_i2c_clockrate_index].clockrate;
 	I2C1->CTLR2 = ((FUNCONF_SYSTEM_CORE_CLOCK/1000000)&I2C_CTLR2_FREQ) | I2C_CTLR2_DMAEN;
 	I2C1->CTLR1 = (I2C_CTLR1_ACK | I2C_CTLR1_PE); // Do I2C enable the last!
 }
 
+// Counts a transfer error or timeout. Returns nonzero if it's time to reset the bus and switch to a slower clock rate.
+static uint8_t display_i2c_count_error(void) {
+	display_i2c_stats.errors++;
+	if(display_i2c_recent_errors < DISPLAY_I2C_DOWNSHIFT_ERRORS) {
+		display_i2c_recent_errors++;
+	}
+	return display_i2c_recent_errors >= DISPLAY_I2C_DOWNSHIFT_ERRORS && display_i2c_clockrate_index < DISPLAY_I2C_CLOCKRATE_COUNT-1;
+}
+
+// DISPLAY_DRAW_FLAG_SCALE_2x: each bit of a nibble of the image becomes 2 bits of a byte of the display
+static const uint8_t display_spread_nibble[16] = {
+	0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF,
+};
+
+// A column of 16 pixels scaled to 32
+static uint32_t display_spread_column(uint32_t column) {
+	return display_spread_nibble[column & 0xF] | (uint32_t)display_spread_nibble[(column >> 4) & 0xF] << 8 |
+		(uint32_t)display_spread_nibble[(column >> 8) & 0xF] << 16 | (uint32_t)display_spread_nibble[(column >> 12) & 0xF] << 24;
+}
+
+// The raster operations are done as (destination & ~clear) ^ image, where clear is clear_area | (image & clear_image).
+// OR clears the bits of the image, XOR clears nothing and OVERWRITE clears the whole area of the image.
+#define DISPLAY_CLEAR_AREA(flags, area) (((flags) & DISPLAY_DRAW_FLAG_RENDER_MASK) == DISPLAY_DRAW_FLAG_OVERWRITE_RENDER ? (area) : 0)
+#define DISPLAY_CLEAR_IMAGE(flags) (((flags) & DISPLAY_DRAW_FLAG_RENDER_MASK) == DISPLAY_DRAW_FLAG_OR_RENDER ? 0xFFFFFFFFU : 0)
+
+#if DISPLAY_STRIP_RENDERING
+static void display_render_page(uint8_t page, uint8_t strip[DISPLAY_WIDTH]) {
+	memset(strip, 0, DISPLAY_WIDTH);
+	for(size_t i=0; i<display_draw_list_length; i++) {
+		int32_t x = display_draw_list[i].x;
+		uint8_t flags = display_draw_list[i].flags;
+		uint8_t scale = (flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? 1 : 0; // log2
+		// Row of the image at the top of the page, after scaling
+		int32_t shift = page*8 - display_draw_list[i].y;
+		if(shift <= -8 || shift >= (16 << scale)) {
+			continue;
+		}
+		uint16_t image[LOOKUP_IMAGE_WIDTH+1] = {0}; // The extra column is blank, e.g. the border of an inverted image
+		if(flags & DISPLAY_DRAW_FLAG_COLUMN) {
+			image[0] = display_draw_list[i].codepoint;
+		} else {
+			lookup_get_image(image, display_draw_list[i].codepoint);
+		}
+		// Columns of the image on the display, after scaling
+		int32_t begin = (x < 0) ? -x : 0;
+		int32_t end = display_draw_list[i].w << scale;
+		if(x + end > DISPLAY_WIDTH) {
+			end = DISPLAY_WIDTH - x;
+		}
+		uint16_t invert = (flags & DISPLAY_DRAW_FLAG_INVERT) ? 0xFFFF : 0;
+		uint32_t area = (scale ? 0xFFFFFFFFU : 0xFFFFU);
+		uint8_t clear_area = DISPLAY_CLEAR_AREA(flags, (shift >= 0) ? area >> shift : area << -shift);
+		uint8_t clear_image = DISPLAY_CLEAR_IMAGE(flags);
+		if((shift & 7) == 0) {
+			// Page-aligned: the page is a byte of the column, or a nibble before 2x scaling
+			for(int32_t j=begin; j<end; j++) {
+				uint16_t column = image[j >> scale] ^ invert;
+				uint8_t b = scale ? display_spread_nibble[(column >> (shift/2)) & 0xF] : column >> shift;
+				strip[x+j] = (strip[x+j] & ~(clear_area | (b & clear_image))) ^ b;
+			}
+		} else {
+			for(int32_t j=begin; j<end; j++) {
+				uint32_t column = (uint16_t)(image[j >> scale] ^ invert);
+				if(scale) {
+					column = display_spread_column(column);
+				}
+				uint8_t b = (shift >= 0) ? column >> shift : column << -shift;
+				strip[x+j] = (strip[x+j] & ~(clear_area | (b & clear_image))) ^ b;
+			}
+		}
+	}
+}
+
+// djb2 with XOR. Shifts and adds only, there's no hardware multiplier.
+static uint32_t display_chunk_hash(const uint8_t *chunk) {
+	uint32_t hash = 5381;
+	for(size_t i=0; i<DISPLAY_CHUNK_WIDTH; i++) {
+		hash = ((hash << 5) + hash) ^ chunk[i];
+	}
+	return hash;
+}
+
+// Renders the next page into display_window_buffer, one page per run of display_loop() to keep the ISR short.
+// Returns the number of bytes to send, DISPLAY_WINDOW_SKIPPED if the page is the same as what's on the display, or 0
+// if the frame is done.
+static uint16_t display_next_window(void) {
+	uint8_t *strip = &display_window_buffer[DISPLAY_WINDOW_COMMAND_SIZE];
+	if(display_draw_list_recording) {
+		return 0; // display_set_refresh_flag() starts over once the frame is drawn
+	}
+	if(display_strip_page < DISPLAY_PAGES) {
+		uint8_t page = display_strip_page++;
+		display_render_page(page, strip);
+		int8_t first = -1;
+		int8_t last = -1;
+		for(size_t i=0; i<DISPLAY_CHUNKS_PER_PAGE; i++) {
+			size_t chunk = page*DISPLAY_CHUNKS_PER_PAGE+i;
+			uint32_t hash = display_chunk_hash(&strip[i*DISPLAY_CHUNK_WIDTH]);
+			if(!(display_chunk_hashes_valid & (1U << chunk)) || display_chunk_hashes[chunk] != hash) {
+				display_chunk_hashes[chunk] = hash;
+				display_chunk_hashes_valid |= 1U << chunk;
+				if(first < 0) {
+					first = i;
+				}
+				last = i;
+			}
+		}
+		if(first >= 0) {
+			uint8_t start = first*DISPLAY_CHUNK_WIDTH;
+			uint8_t end = last*DISPLAY_CHUNK_WIDTH+DISPLAY_CHUNK_WIDTH-1;
+			memmove(strip, &strip[start], end-start+1);
+			display_window_buffer[3] = start;
+			display_window_buffer[5] = end;
+			display_window_buffer[9] = page;
+			display_window_buffer[11] = page;
+			return DISPLAY_WINDOW_COMMAND_SIZE+end-start+1;
+		}
+		return DISPLAY_WINDOW_SKIPPED;
+	}
+	return 0;
+}
+
+// The window being sent got lost. Send its page again.
+static void display_invalidate_window(void) {
+	uint8_t page = display_window_buffer[9];
+	display_chunk_hashes_valid &= ~(((1U << DISPLAY_CHUNKS_PER_PAGE) - 1) << (page*DISPLAY_CHUNKS_PER_PAGE));
+	if(display_strip_page > page) {
+		display_strip_page = page;
+	}
+}
+
+static void display_invalidate_all(void) {
+	display_chunk_hashes_valid = 0;
+	display_strip_page = 0;
+}
+#else
+static void display_set_dirty_columns(uint8_t start, uint8_t end) {
+	for(uint8_t i=start; i<=end; i++) {
+		display_dirty_columns[i/32] |= 1U << (i%32);
+	}
+}
+
+// Picks the next window out of display_dirty_columns and fills display_window_buffer with it.
+// Returns the number of bytes to send, or 0 if no column is dirty.
+static uint16_t display_next_window(void) {
+	if(display_frame_drawing) {
+		return 0; // display_set_refresh_flag() resumes once the frame is drawn. The dirty columns stay dirty.
+	}
+	uint8_t i = 0;
+	while(!(display_dirty_columns[i/32] & (1U << (i%32)))) {
+		if(++i >= DISPLAY_WIDTH) {
+			return 0;
+		}
+	}
+	display_window_start = i;
+	display_window_end = i;
+	for(; i<DISPLAY_WIDTH && i<=display_window_end+DISPLAY_WINDOW_MERGE_GAP+1 && i<display_window_start+DISPLAY_WINDOW_COLUMNS_MAX; i++) {
+		if(display_dirty_columns[i/32] & (1U << (i%32))) {
+			display_dirty_columns[i/32] &= ~(1U << (i%32));
+			display_window_end = i;
+		}
+	}
+	uint16_t data_size = (display_window_end-display_window_start+1)*sizeof(*display_data_buffer);
+	display_window_buffer[3] = display_window_start;
+	display_window_buffer[5] = display_window_end;
+	memcpy(&display_window_buffer[DISPLAY_WINDOW_COMMAND_SIZE], &display_data_buffer[display_window_start], data_size);
+	return DISPLAY_WINDOW_COMMAND_SIZE+data_size;
+}
+
+// The window being sent got lost
+static void display_invalidate_window(void) {
+	display_set_dirty_columns(display_window_start, display_window_end);
+}
+
+static void display_invalidate_all(void) {
+	display_set_dirty_columns(0, DISPLAY_WIDTH-1);
+}
+#endif
+
 void display_loop(void)
 {
 	asm volatile ("" ::: "memory");
@@ -168,8 +410,19 @@ void display_loop(void)
 					DMA1_Channel6->CNTR = sizeof(display_init_array);
 					display_refresh_flag_processing = DISPLAY_REFRESH_FLAG_INIT;
 				} else if(display_refresh_flag & DISPLAY_REFRESH_FLAG_GRAPHIC) {
-					DMA1_Channel6->MADDR = (uint32_t)display_data_dma_start_address;
-					DMA1_Channel6->CNTR = sizeof(display_data_array)-(display_data_dma_start_address-display_data_array);
+					uint16_t window_size = display_next_window();
+					if(!window_size) {
+						// All of the windows have been sent
+						display_refresh_flag &= ~DISPLAY_REFRESH_FLAG_GRAPHIC;
+						goto process_again;
+					}
+#if DISPLAY_STRIP_RENDERING
+					if(window_size == DISPLAY_WINDOW_SKIPPED) {
+						break;
+					}
+#endif
+					DMA1_Channel6->MADDR = (uint32_t)display_window_buffer;
+					DMA1_Channel6->CNTR = window_size;
 					display_refresh_flag_processing = DISPLAY_REFRESH_FLAG_GRAPHIC;
 				}
 
@@ -201,18 +454,27 @@ void display_loop(void)
 			uint16_t star1 = I2C1->STAR1;
 			asm volatile ("" ::: "memory"); // prevent compiler from reordering the read between STAR1 and STAR2
 			uint16_t star2 = I2C1->STAR2;
-			if ((star1 & DISPLAY_I2C_ERROR_FLAGS) ||
+			// The expected flags are checked first. display_loop() can be late, which doesn't make a completed step time out.
+			if(star1 == display_loop_step_expected_i2c_star1 && star2 == display_loop_step_expected_i2c_star2) {
+				display_loop_step = display_loop_step_next;
+				goto process_again;
+			} else if ((star1 & DISPLAY_I2C_ERROR_FLAGS) ||
 				SysTick->CNT - display_loop_step_start_waiting_tick >= DISPLAY_TRANSFER_TIMEOUT) {
 				// First attempt to recover by sending an I2C end bit. If that failed, perform I2C bus reset.
+				// Either way, resend display_init_array and the window. It resets the page pointer of the SSD1306 as well.
+				if(display_refresh_flag_processing == DISPLAY_REFRESH_FLAG_GRAPHIC) {
+					display_invalidate_window();
+				}
+				display_refresh_flag |= DISPLAY_REFRESH_FLAG_INIT;
+				display_refresh_flag_processing = 0; // Nothing for DISPLAY_LOOP_STEP_SUCCESS to clear
 				if(!display_loop_step_reset_i2c_on_error) {
 					display_loop_step = DISPLAY_LOOP_STEP_SEND_END_BIT;
+					// Too many errors: reset the bus after the end bit as well, to slow it down
+					display_loop_step_reset_i2c_on_error = display_i2c_count_error();
 				} else {
 					display_loop_step = DISPLAY_LOOP_STEP_RESET_I2C_SETUP;
 				}
 				goto process_again;
-			} else if(star1 == display_loop_step_expected_i2c_star1 && star2 == display_loop_step_expected_i2c_star2) {
-				display_loop_step = display_loop_step_next;
-				goto process_again;
 			}
 		}
 		break;
@@ -221,6 +483,7 @@ void display_loop(void)
 				display_loop_step = DISPLAY_LOOP_STEP_SEND_START_BIT;
 				goto process_again;
 			} else if (SysTick->CNT - display_loop_step_start_waiting_tick >= DISPLAY_WAIT_BUS_IDLE_TIMEOUT) {
+				display_i2c_count_error();
 				display_loop_step = DISPLAY_LOOP_STEP_RESET_I2C_SETUP;
 				goto process_again;
 			}
@@ -255,13 +518,13 @@ void display_loop(void)
 				// If the DMA couldn't be completed properly, I assume that the I2C bus is fucked up.
 				// Let's reset that I2C bus, just in case.
 				DMA1_Channel6->CFGR &= ~DMA_CFGR6_EN;
+				display_i2c_count_error();
 				display_loop_step_reset_i2c_on_error = 1;
 				display_loop_step = DISPLAY_LOOP_STEP_SEND_END_BIT;
 				goto process_again;
 			} else if(DMA1->INTFR & DMA_TCIF6) {
 				DMA1->INTFCR = DMA_CTCIF6;
 				DMA1_Channel6->CFGR &= ~DMA_CFGR6_EN;
-
 				display_loop_step_expected_i2c_star1 = I2C_STAR1_BTF|I2C_STAR1_TXE;
 				display_loop_step_expected_i2c_star2 = I2C_STAR2_MSL|I2C_STAR2_BUSY|I2C_STAR2_TRA;
 				display_loop_step_next = DISPLAY_LOOP_STEP_SEND_END_BIT;
@@ -281,7 +544,11 @@ void display_loop(void)
 			display_loop_step = DISPLAY_LOOP_STEP_WAIT_TRANSFER;
 		break;
 		case DISPLAY_LOOP_STEP_SUCCESS:
-			display_refresh_flag &= ~display_refresh_flag_processing;
+			// DISPLAY_REFRESH_FLAG_GRAPHIC is cleared by DISPLAY_LOOP_STEP_IDLE after sending the last window
+			display_refresh_flag &= ~(display_refresh_flag_processing & ~DISPLAY_REFRESH_FLAG_GRAPHIC);
+			if(++display_i2c_transactions == 0) {
+				display_i2c_recent_errors = 0;
+			}
 			display_loop_step = DISPLAY_LOOP_STEP_IDLE;
 			goto process_again;
 		break;
@@ -304,11 +571,20 @@ void display_loop(void)
 					// Reset I2C peripheral
 					I2C1->CTLR1 |= I2C_CTLR1_SWRST;
 					I2C1->CTLR1 &= ~I2C_CTLR1_SWRST;
+					display_i2c_stats.bus_resets++;
+					if(display_i2c_recent_errors >= DISPLAY_I2C_DOWNSHIFT_ERRORS) {
+						// The bus is marginal at this clock rate. Try the next slower one, if there's any.
+						if(display_i2c_clockrate_index < DISPLAY_I2C_CLOCKRATE_COUNT-1) {
+							display_i2c_clockrate_index++;
+						}
+						display_i2c_recent_errors = 0;
+					}
 					// Configure I2C peripheral again after resetting
 					// Also configure GPIO
 					display_i2c_bus_init();
-					// Resend the init sequence for the OLED
-					display_refresh_flag |= DISPLAY_REFRESH_FLAG_INIT;
+					// Resend the init sequence for the OLED, then the whole frame
+					display_invalidate_all();
+					display_refresh_flag |= DISPLAY_REFRESH_FLAG_INIT|DISPLAY_REFRESH_FLAG_GRAPHIC;
 					display_loop_step = DISPLAY_LOOP_STEP_IDLE;
 					goto process_again;
 				}
@@ -325,40 +601,114 @@ void display_loop(void)
 	}
 }
 
+#if DISPLAY_STRIP_RENDERING
 void display_clear(void) {
-	memset(display_data_buffer, 0, DISPLAY_DATA_SIZE);
+	display_draw_list_recording = 1;
+	asm volatile ("" ::: "memory");
+	display_draw_list_length = 0;
+}
+
+static void display_draw_list_add(uint32_t codepoint, uint8_t w, int32_t x, int32_t y, uint8_t flags) {
+	if(w > LOOKUP_IMAGE_WIDTH+1) {
+		w = LOOKUP_IMAGE_WIDTH+1;
+	}
+	int32_t scale = (flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? 2 : 1;
+	if(display_draw_list_length >= DISPLAY_DRAW_LIST_LENGTH_MAX || x >= DISPLAY_WIDTH || x+w*scale <= 0 ||
+		y >= DISPLAY_PAGES*8 || y+16*scale <= 0) {
+		return;
+	}
+	display_draw_list[display_draw_list_length].codepoint = codepoint;
+	display_draw_list[display_draw_list_length].x = x;
+	display_draw_list[display_draw_list_length].y = y;
+	display_draw_list[display_draw_list_length].w = w;
+	display_draw_list[display_draw_list_length].flags = flags;
+	display_draw_list_length++;
+}
+
+void display_draw_glyph(uint32_t codepoint, uint8_t w, int32_t x, int32_t y, uint8_t flags) {
+	display_draw_list_add(codepoint, w, x, y, flags);
 }
 
+void display_draw_column(uint16_t column, int32_t x, int32_t y, uint8_t flags) {
+	display_draw_list_add(column, 1, x, y, flags | DISPLAY_DRAW_FLAG_COLUMN);
+}
+#else
+void display_clear(void) {
+	display_frame_drawing = 1;
+	asm volatile ("" ::: "memory");
+	memset(display_drawn_halves, 0, sizeof(display_drawn_halves));
+}
+
+// Combines a column of an image with display_data_buffer. See DISPLAY_CLEAR_AREA() for clear.
+// halves: the halves of the column covered by the image
+static inline void display_blit_column(size_t column, uint32_t image, uint32_t clear, uint8_t halves) {
+	// The halves that haven't been drawn since display_clear() still hold the previous frame. Clear them first.
+	uint32_t *drawn_halves = &display_drawn_halves[column/16];
+	uint8_t stale_halves = halves & ~(*drawn_halves >> (column%16*2));
+	uint32_t previous = display_data_buffer[column];
+	uint32_t current = (previous & ~(display_half_masks[stale_halves] | clear)) ^ image;
+	*drawn_halves |= (uint32_t)halves << (column%16*2);
+	if(current != previous) {
+		display_data_buffer[column] = current;
+		display_changed_columns[column/32] |= 1U << (column%32);
+	}
+}
+
+// The flags and the clipping are worked out once per image. The scaled images get a loop of their own.
 void display_draw_16(const uint16_t *image, uint8_t w, int32_t x, int32_t y, uint8_t flags) {
-	if(flags & DISPLAY_DRAW_FLAG_SCALE_2x) {
-		w *= 2;
+	uint8_t scale = (flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? 1 : 0; // log2
+	// Pages covered by the image
+	int32_t top = (y > 0) ? y : 0;
+	int32_t bottom = y + (16 << scale);
+	if(bottom > DISPLAY_PAGES*8) {
+		bottom = DISPLAY_PAGES*8;
 	}
-	for(int32_t i=0; i<w; i++) {
-		if(x+i >= DISPLAY_WIDTH) {
-			break;
-		} else if(x+i < 0) {
-			continue;
-		}
-		size_t image_index = (flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? i/2 : i;
-		uint32_t image_to_be_shown = (flags & DISPLAY_DRAW_FLAG_INVERT) ? (uint16_t)~image[image_index] : image[image_index];
-		if(flags & DISPLAY_DRAW_FLAG_SCALE_2x) {
-			uint32_t image_original = image_to_be_shown;
-			image_to_be_shown = 0;
-			for(size_t j=0; j<16; j++) {
-				if(image_original & (1 << j)) {
-					image_to_be_shown |= 0x03 << (j*2);
-				}
+	// Columns of the image on the display, after scaling
+	int32_t begin = (x < 0) ? -x : 0;
+	int32_t end = w << scale;
+	if(x + end > DISPLAY_WIDTH) {
+		end = DISPLAY_WIDTH - x;
+	}
+	if(top >= bottom || begin >= end) {
+		return;
+	}
+	uint8_t halves = ((1U << ((bottom+15)/16)) - 1) & ~((1U << (top/16)) - 1);
+	uint8_t shift_left = (y > 0) ? y : 0;
+	uint8_t shift_right = (y < 0) ? -y : 0;
+	uint16_t invert = (flags & DISPLAY_DRAW_FLAG_INVERT) ? 0xFFFF : 0;
+	uint32_t clear_area = DISPLAY_CLEAR_AREA(flags, ((scale ? 0xFFFFFFFFU : 0xFFFFU) << shift_left) >> shift_right);
+	uint32_t clear_image = DISPLAY_CLEAR_IMAGE(flags);
+	if(scale) {
+		// Each column of the image is spread once, and drawn twice
+		uint32_t column = 0;
+		for(int32_t i=begin; i<end; i++) {
+			if(i == begin || !(i & 1)) {
+				column = (display_spread_column((uint16_t)(image[i/2] ^ invert)) << shift_left) >> shift_right;
 			}
+			display_blit_column(x+i, column, clear_area | (column & clear_image), halves);
 		}
-
-		if(y > 0) {
-			display_data_buffer[x+i] |= image_to_be_shown << y;
-		} else {
-			display_data_buffer[x+i] |= image_to_be_shown >> -y;
+	} else {
+		for(int32_t i=begin; i<end; i++) {
+			uint32_t column = ((uint32_t)(uint16_t)(image[i] ^ invert) << shift_left) >> shift_right;
+			display_blit_column(x+i, column, clear_area | (column & clear_image), halves);
 		}
 	}
 }
 
+void display_draw_glyph(uint32_t codepoint, uint8_t w, int32_t x, int32_t y, uint8_t flags) {
+	uint16_t image[LOOKUP_IMAGE_WIDTH+1] = {0}; // The extra column is blank, e.g. the border of an inverted image
+	if(w > LOOKUP_IMAGE_WIDTH+1) {
+		w = LOOKUP_IMAGE_WIDTH+1;
+	}
+	lookup_get_image(image, codepoint);
+	display_draw_16(image, w, x, y, flags);
+}
+
+void display_draw_column(uint16_t column, int32_t x, int32_t y, uint8_t flags) {
+	display_draw_16(&column, 1, x, y, flags);
+}
+#endif
+
 void display_init(void) {
 	RCC->APB1PCENR |= RCC_APB1Periph_I2C1;
 	RCC->APB2PCENR |= RCC_APB2Periph_GPIOC | RCC_APB2Periph_AFIO;
@@ -371,20 +721,56 @@ void display_init(void) {
 	DMA1_Channel6->PADDR = (uint32_t)(&I2C1->DATAR);
 
 	// Initialize state variables
+#if !DISPLAY_STRIP_RENDERING
+	memset(display_data_buffer, 0, sizeof(display_data_buffer));
 	display_clear();
+#endif
+	display_invalidate_all();
 	display_refresh_flag = DISPLAY_REFRESH_FLAG_INIT|DISPLAY_REFRESH_FLAG_GRAPHIC;
 }
 
+#if DISPLAY_STRIP_RENDERING
 void display_set_refresh_flag(void) {
+	// Not sure if the write operation is atomic. Disabling interrupts just in case.
+	// A frame that's being sent is started over from the first page.
+	tim2_task_pause();
+	asm volatile ("" ::: "memory");
+	display_draw_list_recording = 0;
+	display_strip_page = 0;
+	if(++display_chunk_hashes_frames >= DISPLAY_CHUNK_HASHES_LIFETIME) {
+		display_chunk_hashes_frames = 0;
+		display_chunk_hashes_valid = 0;
+	}
+	display_refresh_flag |= DISPLAY_REFRESH_FLAG_GRAPHIC;
+	tim2_task_resume();
+}
+#else
+void display_set_refresh_flag(void) {
+	// Clear what's left of the previous frame
+	for(size_t i=0; i<DISPLAY_WIDTH; i++) {
+		uint8_t stale_halves = ~(display_drawn_halves[i/16] >> (i%16*2)) & 0x03;
+		if(display_data_buffer[i] & display_half_masks[stale_halves]) {
+			display_data_buffer[i] &= ~display_half_masks[stale_halves];
+			display_changed_columns[i/32] |= 1U << (i%32);
+		}
+	}
+
 	// Make sure that the display_data_buffer changes are written and would be seen by the DMAs
 	asm volatile("fence ow,ow");
 
 	// Not sure if the write operation is atomic. Disabling interrupts just in case.
+	// The columns changed by this frame are added to the ones that are still waiting to be sent.
 	tim2_task_pause();
 	asm volatile ("" ::: "memory");
+	for(size_t i=0; i<DISPLAY_WIDTH/32; i++) {
+		display_dirty_columns[i] |= display_changed_columns[i];
+		display_changed_columns[i] = 0;
+	}
+	display_frame_drawing = 0;
 	display_refresh_flag |= DISPLAY_REFRESH_FLAG_GRAPHIC;
 	tim2_task_resume();
 }
+#endif
 
 uint8_t display_is_idle(void) {
 	asm volatile ("" ::: "memory");
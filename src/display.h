@@ -31,12 +31,36 @@ void display_loop(void); // CONCURRENCY: can preempt other functions
 
 #define DISPLAY_WIDTH (128)
 
+// 0: display.c keeps the whole frame in RAM and sends the columns that changed.
+// 1: display.c keeps the list of the images drawn instead, and display_loop() renders each page of 128 bytes right
+// before sending it. It saves about 400 bytes of RAM, at the cost of rendering every page of each frame in the TIM2 ISR.
+#ifndef DISPLAY_STRIP_RENDERING
+#define DISPLAY_STRIP_RENDERING (0)
+#endif
+
 #define DISPLAY_DRAW_FLAG_INVERT (1U<<0)
 #define DISPLAY_DRAW_FLAG_SCALE_2x (1U<<1)
-#define DISPLAY_DRAW_FLAG_OR_RENDER (1U<<2)
+// Raster operation with what has been drawn since display_clear(). The pixels around the image stay as they are.
+#define DISPLAY_DRAW_FLAG_OR_RENDER (0U<<2) // Default. The blank pixels of the image are transparent.
+#define DISPLAY_DRAW_FLAG_XOR_RENDER (1U<<2)
+#define DISPLAY_DRAW_FLAG_OVERWRITE_RENDER (2U<<2) // The blank pixels of the image are drawn as well
+#define DISPLAY_DRAW_FLAG_RENDER_MASK (3U<<2)
 
 void display_clear(void);
 // Uses 32bit integer for locations to avoid arithematic overflow
+// The image of lookup_get_image(). The columns beyond LOOKUP_IMAGE_WIDTH are blank.
+void display_draw_glyph(uint32_t codepoint, uint8_t w, int32_t x, int32_t y, uint8_t flags);
+void display_draw_column(uint16_t column, int32_t x, int32_t y, uint8_t flags); // An image of a single column
+#if !DISPLAY_STRIP_RENDERING
 void display_draw_16(const uint16_t *image, uint8_t w, int32_t x, int32_t y, uint8_t flags);
+#endif
 void display_set_refresh_flag(void); // The display would be updated in the loop() handler
 uint8_t display_is_idle(void);
+
+// Diagnostics of the I2C bus of the display
+struct display_i2c_stats {
+	uint32_t clockrate; // Clock rate in use. Unit: Hz. Starts at 400kHz and gets lowered by the errors.
+	uint16_t errors; // Transfer errors and timeouts
+	uint16_t bus_resets;
+};
+extern struct display_i2c_stats display_i2c_stats;
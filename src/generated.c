@@ -24,196 +24,68 @@ const size_t LOOKUP_CODEPAGE_1_LENGTH = 19;
 const uint32_t LOOKUP_CODEPAGE_2_START = 0xFFFF1000U;
 const size_t LOOKUP_CODEPAGE_2_LENGTH = 3;
 
-// Intentionally not using array of string to save FLASH space. Can save 4 bytes for each entry this way.
-const char *LOOKUP_CODEPAGE_0 = 
-	"a\0"
-	"akesi\0"
-	"ala\0"
-	"alasa\0"
-	"ale\0"
-	"anpa\0"
-	"ante\0"
-	"anu\0"
-	"awen\0"
-	"e\0"
-	"en\0"
-	"esun\0"
-	"ijo\0"
-	"ike\0"
-	"ilo\0"
-	"insa\0"
-	"jaki\0"
-	"jan\0"
-	"jelo\0"
-	"jo\0"
-	"kala\0"
-	"kalama\0"
-	"kama\0"
-	"kasi\0"
-	"ken\0"
-	"kepeken\0"
-	"kili\0"
-	"kiwen\0"
-	"ko\0"
-	"kon\0"
-	"kule\0"
-	"kulupu\0"
-	"kute\0"
-	"la\0"
-	"lape\0"
-	"laso\0"
-	"lawa\0"
-	"len\0"
-	"lete\0"
-	"li\0"
-	"lili\0"
-	"linja\0"
-	"lipu\0"
-	"loje\0"
-	"lon\0"
-	"luka\0"
-	"lukin\0"
-	"lupa\0"
-	"ma\0"
-	"mama\0"
-	"mani\0"
-	"meli\0"
-	"mi\0"
-	"mije\0"
-	"moku\0"
-	"moli\0"
-	"monsi\0"
-	"mu\0"
-	"mun\0"
-	"musi\0"
-	"mute\0"
-	"nanpa\0"
-	"nasa\0"
-	"nasin\0"
-	"nena\0"
-	"ni\0"
-	"nimi\0"
-	"noka\0"
-	"o\0"
-	"olin\0"
-	"ona\0"
-	"open\0"
-	"pakala\0"
-	"pali\0"
-	"palisa\0"
-	"pan\0"
-	"pana\0"
-	"pi\0"
-	"pilin\0"
-	"pimeja\0"
-	"pini\0"
-	"pipi\0"
-	"poka\0"
-	"poki\0"
-	"pona\0"
-	"pu\0"
-	"sama\0"
-	"seli\0"
-	"selo\0"
-	"seme\0"
-	"sewi\0"
-	"sijelo\0"
-	"sike\0"
-	"sin\0"
-	"sina\0"
-	"sinpin\0"
-	"sitelen\0"
-	"sona\0"
-	"soweli\0"
-	"suli\0"
-	"suno\0"
-	"supa\0"
-	"suwi\0"
-	"tan\0"
-	"taso\0"
-	"tawa\0"
-	"telo\0"
-	"tenpo\0"
-	"toki\0"
-	"tomo\0"
-	"tu\0"
-	"unpa\0"
-	"uta\0"
-	"utala\0"
-	"walo\0"
-	"wan\0"
-	"waso\0"
-	"wawa\0"
-	"weka\0"
-	"wile\0"
-	"namako\0"
-	"kin\0"
-	"oko\0"
-	"kipisi\0"
-	"leko\0"
-	"monsuta\0"
-	"tonsi\0"
-	"jasima\0"
-	"kijetesantakalu\0"
-	"soko\0"
-	"meso\0"
-	"epiku\0"
-	"kokosila\0"
-	"lanpan\0"
-	"n\0"
-	"misikeke\0"
-	"ku\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"[\0"
-	"]\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	"\0"
-	".\0"
-	":\0"
-	"\0"
-	"\0"
-	"pake\0"
-	"apeja\0"
-	"majuna\0"
-	"powe"
-;
+// Intentionally not using array of string to save FLASH space. The strings are packed and indexed by offset instead.
+const char LOOKUP_ASCII_STRING_EXTRA_SYMBOLS[] = ":._\n";
+// Packed strings of LOOKUP_CODEPAGE_0: 468 bytes, 742 bytes unpacked. See lookup_ascii_string_next() in lookup.c
+const uint8_t LOOKUP_CODEPAGE_0[] = {
+	0x01, 0x84, 0x55, 0x66, 0x02, 0x81, 0x05, 0x10, 0x58, 0x98, 0x01, 0x04, 0x56, 0x40, 0x70, 0x30,
+	0x80, 0xE0, 0x68, 0x01, 0xC1, 0x55, 0x10, 0x6E, 0x71, 0xA0, 0x80, 0xE2, 0x40, 0x99, 0xD5, 0x81,
+	0xA4, 0x1E, 0x48, 0xAB, 0x80, 0xC4, 0x1E, 0x48, 0x6E, 0x06, 0xA0, 0xC2, 0x4A, 0x40, 0x05, 0x07,
+	0x54, 0x61, 0x0F, 0xA8, 0x07, 0x56, 0x60, 0x01, 0xAC, 0xC0, 0x42, 0x0B, 0x60, 0x85, 0x16, 0xC0,
+	0x0A, 0x33, 0x81, 0x55, 0x1C, 0x58, 0x05, 0x96, 0x55, 0x1C, 0x58, 0x89, 0x25, 0xB0, 0xD2, 0x2D,
+	0x0E, 0xAC, 0x07, 0xD6, 0x73, 0x60, 0x55, 0x56, 0xC0, 0xAA, 0xAC, 0xC2, 0x0A, 0x56, 0xA5, 0x05,
+	0xB0, 0x00, 0x58, 0x80, 0x05, 0xB0, 0x30, 0x1F, 0x60, 0xE1, 0x06, 0xC0, 0x8A, 0x03, 0xAC, 0xD0,
+	0x02, 0x58, 0x02, 0x2C, 0xB1, 0x04, 0x58, 0x72, 0x2A, 0x00, 0x96, 0x60, 0x05, 0xEC, 0xA9, 0x02,
+	0xD8, 0x73, 0x80, 0xD5, 0x15, 0x00, 0xAB, 0x2B, 0x39, 0xC0, 0x2A, 0x0C, 0xA0, 0x05, 0xD0, 0x42,
+	0x0B, 0xA0, 0x05, 0x97, 0x40, 0x2B, 0x2C, 0x81, 0x96, 0x40, 0x4B, 0xAA, 0x80, 0xF6, 0x56, 0x05,
+	0xED, 0xB1, 0x04, 0xDA, 0x73, 0x33, 0x81, 0x56, 0x41, 0xAB, 0x0E, 0xB4, 0x3A, 0x13, 0x68, 0x95,
+	0x16, 0xE0, 0x82, 0x83, 0x01, 0xB8, 0x30, 0x03, 0x70, 0x61, 0x26, 0x07, 0x5C, 0x71, 0x01, 0xB8,
+	0x04, 0x5C, 0x6A, 0x09, 0xB8, 0xB7, 0x02, 0x78, 0xE0, 0xB1, 0xE4, 0xC0, 0x73, 0x01, 0x3C, 0x58,
+	0x1C, 0x80, 0x61, 0x05, 0x16, 0x00, 0x0C, 0x2C, 0x01, 0x18, 0x58, 0x9A, 0x01, 0xC0, 0xE0, 0x00,
+	0x0C, 0x2E, 0x00, 0x98, 0x00, 0x4C, 0x2C, 0x39, 0x00, 0x53, 0x2B, 0x2A, 0x00, 0x98, 0x5C, 0x02,
+	0x30, 0xC1, 0x04, 0xE0, 0x5B, 0x01, 0xC0, 0xB7, 0x12, 0x80, 0xCF, 0x05, 0x00, 0x2B, 0x98, 0xA1,
+	0x05, 0x30, 0x0B, 0x4B, 0x60, 0x16, 0xF6, 0xC0, 0x2C, 0xAD, 0x80, 0x59, 0x6E, 0x02, 0x33, 0xA9,
+	0xC2, 0x1E, 0x98, 0x69, 0x15, 0x30, 0x93, 0x03, 0x33, 0xB9, 0x00, 0x66, 0x72, 0x30, 0x39, 0x30,
+	0x13, 0x2D, 0xAC, 0x38, 0x30, 0x9F, 0x0B, 0x60, 0xBE, 0x5B, 0x58, 0x02, 0xB3, 0xB2, 0x04, 0x66,
+	0x75, 0x0F, 0xCC, 0x0A, 0x03, 0x98, 0xF5, 0x26, 0x40, 0x83, 0x03, 0x34, 0xCC, 0x07, 0x68, 0xB8,
+	0x01, 0xD0, 0xC2, 0x1E, 0xA0, 0xC5, 0xC1, 0x07, 0xE8, 0x5B, 0x09, 0xD0, 0xD7, 0x1E, 0xA0, 0x15,
+	0x54, 0x07, 0x03, 0xA8, 0x34, 0x80, 0x4A, 0x03, 0x0B, 0xE0, 0x06, 0xF6, 0xC0, 0x0D, 0x0E, 0xDC,
+	0x30, 0x1F, 0xB8, 0xE1, 0x06, 0x70, 0xCB, 0x0A, 0xE0, 0x26, 0x56, 0x80, 0x0B, 0x2D, 0xAC, 0x07,
+	0x56, 0x72, 0xE0, 0xAD, 0x07, 0x56, 0x82, 0x69, 0x26, 0xC0, 0xCA, 0x7A, 0xA0, 0x3D, 0x37, 0x2B,
+	0x0D, 0x80, 0x3E, 0x37, 0x13, 0x50, 0x61, 0xA6, 0x16, 0xC0, 0x4A, 0xAA, 0xD0, 0x32, 0x83, 0xA3,
+	0x61, 0x05, 0x56, 0xC1, 0x7C, 0xEB, 0x81, 0x56, 0xE6, 0x03, 0x05, 0xA6, 0x55, 0xC1, 0x7A, 0xEB,
+	0xCD, 0xC4, 0x02, 0x60, 0xC1, 0xC1, 0xE0, 0x80, 0x03, 0x2D, 0xCD, 0xB4, 0xCA, 0x2A, 0x60, 0x55,
+	0x00, 0x00, 0x00, 0x00, 0x80, 0x2F, 0x36, 0xF8, 0xA2, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x38, 0xD8, 0x00, 0x00, 0x18, 0x56, 0x01, 0x01, 0x16, 0x15, 0x40, 0x0B, 0xAA, 0xBA, 0x00, 0xE0,
+	0xBB, 0x05, 0x00, 0x00,
+};
+const uint16_t LOOKUP_CODEPAGE_0_CHECKPOINT[] = {0x0000U, 0x0044U, 0x0095U, 0x00E1U, 0x012DU, 0x017BU, 0x01CCU, 0x021FU, 0x0276U, 0x02BBU, 0x02D3U};
+const uint8_t LOOKUP_CODEPAGE_0_OFFSET[] = {
+	0x00, 0x02, 0x08, 0x0C, 0x12, 0x16, 0x1B, 0x20, 0x24, 0x29, 0x2B, 0x2E, 0x33, 0x37, 0x3B, 0x3F,
+	0x00, 0x05, 0x09, 0x0E, 0x11, 0x16, 0x1D, 0x22, 0x27, 0x2B, 0x33, 0x38, 0x3E, 0x41, 0x45, 0x4A,
+	0x00, 0x05, 0x08, 0x0D, 0x12, 0x17, 0x1B, 0x20, 0x23, 0x28, 0x2E, 0x33, 0x38, 0x3C, 0x41, 0x47,
+	0x00, 0x03, 0x08, 0x0D, 0x12, 0x15, 0x1A, 0x1F, 0x24, 0x2A, 0x2D, 0x31, 0x36, 0x3B, 0x41, 0x46,
+	0x00, 0x05, 0x08, 0x0D, 0x12, 0x14, 0x19, 0x1D, 0x22, 0x29, 0x2E, 0x35, 0x39, 0x3E, 0x41, 0x47,
+	0x00, 0x05, 0x0A, 0x0F, 0x14, 0x19, 0x1C, 0x21, 0x26, 0x2B, 0x30, 0x35, 0x3C, 0x41, 0x45, 0x4A,
+	0x00, 0x08, 0x0D, 0x14, 0x19, 0x1E, 0x23, 0x28, 0x2C, 0x31, 0x36, 0x3B, 0x41, 0x46, 0x4B, 0x4E,
+	0x00, 0x04, 0x0A, 0x0F, 0x13, 0x18, 0x1D, 0x22, 0x27, 0x2E, 0x32, 0x36, 0x3D, 0x42, 0x4A, 0x50,
+	0x00, 0x10, 0x15, 0x1A, 0x20, 0x29, 0x30, 0x32, 0x3B, 0x3E, 0x3F, 0x40, 0x41, 0x42, 0x43, 0x44,
+	0x00, 0x04, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x14, 0x16, 0x17,
+	0x00, 0x05, 0x0B, 0x12,
+};
 
-// Intentionally not using array of string to save FLASH space. Can save 4 bytes for each entry this way.
-const char *LOOKUP_CODEPAGE_1 = 
-	"\n\0"
-	"-\0"
-	"\"\0"
-	"__\0"
-	"...\0"
-	":)\0"
-	":(\0"
-	":|\0"
-	":v\0"
-	"oke\0"
-	"isipin\0"
-	"kapesi\0"
-	"kiki\0"
-	"linluwi\0"
-	"mulapisu\0"
-	"Pingo\0"
-	"unu\0"
-	"wa\0"
-	","
-;
+// Packed strings of LOOKUP_CODEPAGE_1: 60 bytes, 80 bytes unpacked. See lookup_ascii_string_next() in lookup.c
+const uint8_t LOOKUP_CODEPAGE_1[] = {
+	0x1E, 0xFC, 0xD0, 0xC0, 0x0F, 0x02, 0xF4, 0x0E, 0x38, 0xE7, 0x60, 0xFF, 0x90, 0xC0, 0xFE, 0x01,
+	0x81, 0xFD, 0x07, 0x07, 0xDB, 0x82, 0xB7, 0x0A, 0x48, 0x33, 0xC1, 0xE4, 0xC0, 0x0A, 0xB0, 0xCC,
+	0x04, 0x56, 0x5A, 0x09, 0xB0, 0xE4, 0x58, 0xBD, 0x09, 0xB4, 0xCA, 0x02, 0x4C, 0xB3, 0x82, 0x2F,
+	0x60, 0x72, 0xE7, 0x81, 0xEA, 0x2A, 0xB8, 0x01, 0xFC, 0xC0, 0x00, 0x00,
+};
+const uint16_t LOOKUP_CODEPAGE_1_CHECKPOINT[] = {0x0000U, 0x0053U};
+const uint8_t LOOKUP_CODEPAGE_1_OFFSET[] = {
+	0x00, 0x02, 0x06, 0x0A, 0x0D, 0x11, 0x16, 0x1B, 0x20, 0x23, 0x27, 0x2E, 0x35, 0x3A, 0x42, 0x4B,
+	0x00, 0x04, 0x07,
+};
 
 const uint32_t *LOOKUP_CODEPAGE_2[] = {
 	(const uint32_t[]){0x00003000U,0},
@@ -222,462 +94,980 @@ const uint32_t *LOOKUP_CODEPAGE_2[] = {
 };
 
 // Covers the vast majority of the characters. Each entry fits in 32bit.
+// The entries are stored in the slot order of LOOKUP_COMPACT_TABLE_HASH.
 const struct lookup_compact_entry LOOKUP_COMPACT_TABLE[] = {
-	{.input = 0x100000U, .sitelen_pona_id=0x21U}, // 1 -> la
-	{.input = 0x110000U, .sitelen_pona_id=0x3AU}, // 11 -> mun
-	{.input = 0x111100U, .sitelen_pona_id=0x1DU}, // 1111 -> kon
-	{.input = 0x130000U, .sitelen_pona_id=0x20U}, // 13 -> kute
-	{.input = 0x133880U, .sitelen_pona_id=0x62U}, // 133ww -> soweli
-	{.input = 0x182000U, .sitelen_pona_id=0x03U}, // 1w2 -> alasa
-	{.input = 0x182A00U, .sitelen_pona_id=0x03U}, // 1w2r -> alasa
-	{.input = 0x188330U, .sitelen_pona_id=0x62U}, // 1ww33 -> soweli
-	{.input = 0x220000U, .sitelen_pona_id=0x56U}, // 22 -> sama
-	{.input = 0x222833U, .sitelen_pona_id=0x51U}, // 222w33 -> pipi
-	{.input = 0x228000U, .sitelen_pona_id=0xA0U}, // 22w -> pake
-	{.input = 0x228220U, .sitelen_pona_id=0x58U}, // 22w22 -> selo
-	{.input = 0x228800U, .sitelen_pona_id=0x3DU}, // 22ww -> nanpa
-	{.input = 0x229000U, .sitelen_pona_id=0x22U}, // 22e -> lape
-	{.input = 0x22A000U, .sitelen_pona_id=0x16U}, // 22r -> kama
-	{.input = 0x230000U, .sitelen_pona_id=0x2CU}, // 23 -> lon
-	{.input = 0x280000U, .sitelen_pona_id=0x68U}, // 2w -> taso
 	{.input = 0x282000U, .sitelen_pona_id=0x50U}, // 2w2 -> pini
+	{.input = 0x828880U, .sitelen_pona_id=0x58U}, // w2www -> selo
+	{.input = 0xB88520U, .sitelen_pona_id=0x87U}, // tww52 -> misikeke
+	{.input = 0xD20000U, .sitelen_pona_id=0x47U}, // s2 -> open
 	{.input = 0x282300U, .sitelen_pona_id=0x5FU}, // 2w23 -> sinpin
-	{.input = 0x282800U, .sitelen_pona_id=0x42U}, // 2w2w -> nimi
-	{.input = 0x288000U, .sitelen_pona_id=0x65U}, // 2ww -> supa
+	{.input = 0xA83300U, .sitelen_pona_id=0x74U}, // rw33 -> waso
+	{.input = 0x9EA200U, .sitelen_pona_id=0x12U}, // edr2 -> jelo
+	{.input = 0xA90000U, .sitelen_pona_id=0x14U}, // re -> kala
+	{.input = 0x310000U, .sitelen_pona_id=0x20U}, // 31 -> kute
+	{.input = 0x9B2000U, .sitelen_pona_id=0x13U}, // et2 -> jo
+	{.input = 0xAD0000U, .sitelen_pona_id=0x6DU}, // rs -> tomo
+	{.input = 0xA80000U, .sitelen_pona_id=0x3FU}, // rw -> nasin
+	{.input = 0x182000U, .sitelen_pona_id=0x03U}, // 1w2 -> alasa
+	{.input = 0x7B2000U, .sitelen_pona_id=0x36U}, // qt2 -> moku
+	{.input = 0x600000U, .sitelen_pona_id=0x90U}, // 6 -> [
+	{.input = 0x88B000U, .sitelen_pona_id=0x2FU}, // wwt -> lupa
+	{.input = 0x7E8000U, .sitelen_pona_id=0x19U}, // qdw -> kepeken
+	{.input = 0xF70000U, .sitelen_pona_id=0x4CU}, // fq -> pana
 	{.input = 0x288800U, .sitelen_pona_id=0x5BU}, // 2www -> sijelo
-	{.input = 0x288880U, .sitelen_pona_id=0x58U}, // 2wwww -> selo
-	{.input = 0x290000U, .sitelen_pona_id=0x46U}, // 2e -> ona
-	{.input = 0x292000U, .sitelen_pona_id=0x32U}, // 2e2 -> mani
-	{.input = 0x2A2000U, .sitelen_pona_id=0x08U}, // 2r2 -> awen
-	{.input = 0x2A2B00U, .sitelen_pona_id=0x2BU}, // 2r2t -> loje
-	{.input = 0x2A4000U, .sitelen_pona_id=0x72U}, // 2r4 -> walo
-	{.input = 0x2AB200U, .sitelen_pona_id=0x2BU}, // 2rt2 -> loje
-	{.input = 0x2B3000U, .sitelen_pona_id=0x70U}, // 2t3 -> uta
-	{.input = 0x2B7000U, .sitelen_pona_id=0x36U}, // 2tq -> moku
+	{.input = 0x820000U, .sitelen_pona_id=0x4DU}, // w2 -> pi
+	{.input = 0x58B800U, .sitelen_pona_id=0x4AU}, // 5wtw -> palisa
+	{.input = 0xB27000U, .sitelen_pona_id=0x36U}, // t2q -> moku
+	{.input = 0xAA3000U, .sitelen_pona_id=0x66U}, // rr3 -> suwi
+	{.input = 0xBB0000U, .sitelen_pona_id=0x77U}, // tt -> wile
+	{.input = 0xAAAA00U, .sitelen_pona_id=0x7DU}, // rrrr -> monsuta
+	{.input = 0x488200U, .sitelen_pona_id=0x1BU}, // 4ww2 -> kiwen
+	{.input = 0x590000U, .sitelen_pona_id=0x33U}, // 5e -> meli
+	{.input = 0x388000U, .sitelen_pona_id=0x82U}, // 3ww -> meso
+	{.input = 0x822000U, .sitelen_pona_id=0xA0U}, // w22 -> pake
+	{.input = 0x383000U, .sitelen_pona_id=0x7BU}, // 3w3 -> kipisi
 	{.input = 0x2BA200U, .sitelen_pona_id=0x2BU}, // 2tr2 -> loje
-	{.input = 0x2D0000U, .sitelen_pona_id=0x47U}, // 2s -> open
-	{.input = 0x300000U, .sitelen_pona_id=0x9CU}, // 3 -> .
-	{.input = 0x310000U, .sitelen_pona_id=0x20U}, // 31 -> kute
-	{.input = 0x320000U, .sitelen_pona_id=0x2CU}, // 32 -> lon
+	{.input = 0x500000U, .sitelen_pona_id=0x0DU}, // 5 -> ike
+	{.input = 0x588000U, .sitelen_pona_id=0x40U}, // 5ww -> nena
 	{.input = 0x328200U, .sitelen_pona_id=0x38U}, // 32w2 -> monsi
-	{.input = 0x332229U, .sitelen_pona_id=0x01U}, // 33222e -> akesi
-	{.input = 0x338222U, .sitelen_pona_id=0x51U}, // 33w222 -> pipi
-	{.input = 0x33A800U, .sitelen_pona_id=0x74U}, // 33rw -> waso
-	{.input = 0x33D330U, .sitelen_pona_id=0x0FU}, // 33s33 -> insa
-	{.input = 0x360000U, .sitelen_pona_id=0x38U}, // 36 -> monsi
-	{.input = 0x370000U, .sitelen_pona_id=0x59U}, // 3q -> seme
-	{.input = 0x383000U, .sitelen_pona_id=0x7BU}, // 3w3 -> kipisi
-	{.input = 0x388000U, .sitelen_pona_id=0x82U}, // 3ww -> meso
-	{.input = 0x390000U, .sitelen_pona_id=0x31U}, // 3e -> mama
-	{.input = 0x3AA000U, .sitelen_pona_id=0x66U}, // 3rr -> suwi
-	{.input = 0x3D3000U, .sitelen_pona_id=0x05U}, // 3s3 -> anpa
-	{.input = 0x3E0000U, .sitelen_pona_id=0x78U}, // 3d -> namako
-	{.input = 0x3F0000U, .sitelen_pona_id=0x57U}, // 3f -> seli
-	{.input = 0x400000U, .sitelen_pona_id=0x28U}, // 4 -> lili
-	{.input = 0x413000U, .sitelen_pona_id=0x7AU}, // 413 -> oko
-	{.input = 0x42A000U, .sitelen_pona_id=0x26U}, // 42r -> lete
-	{.input = 0x440000U, .sitelen_pona_id=0x63U}, // 44 -> suli
-	{.input = 0x444000U, .sitelen_pona_id=0x4BU}, // 444 -> pan
-	{.input = 0x444400U, .sitelen_pona_id=0x7DU}, // 4444 -> monsuta
+	{.input = 0x840000U, .sitelen_pona_id=0x41U}, // w4 -> ni
+	{.input = 0x2A4000U, .sitelen_pona_id=0x72U}, // 2r4 -> walo
 	{.input = 0x44A400U, .sitelen_pona_id=0x71U}, // 44r4 -> utala
-	{.input = 0x450000U, .sitelen_pona_id=0x67U}, // 45 -> tan
+	{.input = 0x5B0000U, .sitelen_pona_id=0x29U}, // 5t -> linja
+	{.input = 0xE80000U, .sitelen_pona_id=0x0EU}, // dw -> ilo
+	{.input = 0x22A000U, .sitelen_pona_id=0x16U}, // 22r -> kama
+	{.input = 0xB5B580U, .sitelen_pona_id=0x7FU}, // t5t5w -> jasima
+	{.input = 0x9A0000U, .sitelen_pona_id=0x11U}, // er -> jan
+	{.input = 0xE33000U, .sitelen_pona_id=0x60U}, // d33 -> sitelen
+	{.input = 0x950000U, .sitelen_pona_id=0x33U}, // e5 -> meli
+	{.input = 0x838000U, .sitelen_pona_id=0x82U}, // w3w -> meso
+	{.input = 0x554000U, .sitelen_pona_id=0x4EU}, // 554 -> pilin
+	{.input = 0x812A00U, .sitelen_pona_id=0x03U}, // w12r -> alasa
+	{.input = 0xA24A00U, .sitelen_pona_id=0x4FU}, // r24r -> pimeja
+	{.input = 0x922800U, .sitelen_pona_id=0x7EU}, // e22w -> tonsi
+	{.input = 0x885000U, .sitelen_pona_id=0x40U}, // ww5 -> nena
+	{.input = 0x88A000U, .sitelen_pona_id=0x83U}, // wwr -> epiku
+	{.input = 0xB88000U, .sitelen_pona_id=0x2FU}, // tww -> lupa
+	{.input = 0x893000U, .sitelen_pona_id=0x00U}, // we3 -> a
+	{.input = 0x700000U, .sitelen_pona_id=0x2DU}, // q -> luka
+	{.input = 0x588B00U, .sitelen_pona_id=0x4AU}, // 5wwt -> palisa
+	{.input = 0x390000U, .sitelen_pona_id=0x31U}, // 3e -> mama
+	{.input = 0xB50000U, .sitelen_pona_id=0x29U}, // t5 -> linja
+	{.input = 0x8B5B50U, .sitelen_pona_id=0x7FU}, // wt5t5 -> jasima
+	{.input = 0x4A4000U, .sitelen_pona_id=0x71U}, // 4r4 -> utala
+	{.input = 0x133880U, .sitelen_pona_id=0x62U}, // 133ww -> soweli
+	{.input = 0xB5B000U, .sitelen_pona_id=0x3EU}, // t5t -> nasa
 	{.input = 0x455000U, .sitelen_pona_id=0x4EU}, // 455 -> pilin
-	{.input = 0x455455U, .sitelen_pona_id=0x45U}, // 455455 -> olin
-	{.input = 0x480000U, .sitelen_pona_id=0x07U}, // 4w -> anu
-	{.input = 0x488200U, .sitelen_pona_id=0x1BU}, // 4ww2 -> kiwen
+	{.input = 0x8A4000U, .sitelen_pona_id=0xA3U}, // wr4 -> powe
+	{.input = 0x928000U, .sitelen_pona_id=0x30U}, // e2w -> ma
+	{.input = 0x939900U, .sitelen_pona_id=0x39U}, // e3ee -> mu
+	{.input = 0x730000U, .sitelen_pona_id=0x59U}, // q3 -> seme
+	{.input = 0x188330U, .sitelen_pona_id=0x62U}, // 1ww33 -> soweli
+	{.input = 0xB85800U, .sitelen_pona_id=0x4AU}, // tw5w -> palisa
+	{.input = 0x858000U, .sitelen_pona_id=0x40U}, // w5w -> nena
+	{.input = 0x830000U, .sitelen_pona_id=0x44U}, // w3 -> o
+	{.input = 0x228220U, .sitelen_pona_id=0x58U}, // 22w22 -> selo
+	{.input = 0xE42300U, .sitelen_pona_id=0x88U}, // d423 -> ku
+	{.input = 0xE4A000U, .sitelen_pona_id=0x48U}, // d4r -> pakala
+	{.input = 0xEA4000U, .sitelen_pona_id=0x48U}, // dr4 -> pakala
+	{.input = 0x828200U, .sitelen_pona_id=0x42U}, // w2w2 -> nimi
 	{.input = 0x4A0000U, .sitelen_pona_id=0x02U}, // 4r -> ala
-	{.input = 0x4A2000U, .sitelen_pona_id=0x1BU}, // 4r2 -> kiwen
-	{.input = 0x4A4000U, .sitelen_pona_id=0x71U}, // 4r4 -> utala
+	{.input = 0xD30000U, .sitelen_pona_id=0x52U}, // s3 -> poka
+	{.input = 0x818000U, .sitelen_pona_id=0x43U}, // w1w -> noka
+	{.input = 0x110000U, .sitelen_pona_id=0x3AU}, // 11 -> mun
+	{.input = 0xF92000U, .sitelen_pona_id=0x84U}, // fe2 -> kokosila
 	{.input = 0x4A4A00U, .sitelen_pona_id=0x1DU}, // 4r4r -> kon
-	{.input = 0x4AA200U, .sitelen_pona_id=0x4FU}, // 4rr2 -> pimeja
-	{.input = 0x500000U, .sitelen_pona_id=0x0DU}, // 5 -> ike
-	{.input = 0x52D000U, .sitelen_pona_id=0x81U}, // 52s -> soko
-	{.input = 0x540000U, .sitelen_pona_id=0x67U}, // 54 -> tan
-	{.input = 0x554000U, .sitelen_pona_id=0x4EU}, // 554 -> pilin
-	{.input = 0x554554U, .sitelen_pona_id=0x45U}, // 554554 -> olin
-	{.input = 0x554900U, .sitelen_pona_id=0x6FU}, // 554e -> unpa
-	{.input = 0x55B000U, .sitelen_pona_id=0x4EU}, // 55t -> pilin
-	{.input = 0x55B800U, .sitelen_pona_id=0x1AU}, // 55tw -> kili
-	{.input = 0x55B900U, .sitelen_pona_id=0x6FU}, // 55te -> unpa
-	{.input = 0x588000U, .sitelen_pona_id=0x40U}, // 5ww -> nena
-	{.input = 0x588B00U, .sitelen_pona_id=0x4AU}, // 5wwt -> palisa
-	{.input = 0x588B20U, .sitelen_pona_id=0x87U}, // 5wwt2 -> misikeke
-	{.input = 0x58B800U, .sitelen_pona_id=0x4AU}, // 5wtw -> palisa
+	{.input = 0x8E0000U, .sitelen_pona_id=0x0EU}, // wd -> ilo
+	{.input = 0xD00000U, .sitelen_pona_id=0x53U}, // s -> poki
+	{.input = 0xB85820U, .sitelen_pona_id=0x87U}, // tw5w2 -> misikeke
+	{.input = 0xF30000U, .sitelen_pona_id=0x57U}, // f3 -> seli
+	{.input = 0xA29890U, .sitelen_pona_id=0x23U}, // r2ewe -> laso
+	{.input = 0x800000U, .sitelen_pona_id=0x73U}, // w -> wan
+	{.input = 0x444000U, .sitelen_pona_id=0x4BU}, // 444 -> pan
+	{.input = 0x848000U, .sitelen_pona_id=0x63U}, // w4w -> suli
+	{.input = 0xE30000U, .sitelen_pona_id=0x78U}, // d3 -> namako
+	{.input = 0xB00000U, .sitelen_pona_id=0x54U}, // t -> pona
+	{.input = 0x880000U, .sitelen_pona_id=0x6EU}, // ww -> tu
+	{.input = 0x99A900U, .sitelen_pona_id=0xA1U}, // eere -> apeja
+	{.input = 0x130000U, .sitelen_pona_id=0x20U}, // 13 -> kute
+	{.input = 0x4A2000U, .sitelen_pona_id=0x1BU}, // 4r2 -> kiwen
+	{.input = 0x9F0000U, .sitelen_pona_id=0x6CU}, // ef -> toki
+	{.input = 0x33A800U, .sitelen_pona_id=0x74U}, // 33rw -> waso
 	{.input = 0x58B820U, .sitelen_pona_id=0x87U}, // 5wtw2 -> misikeke
-	{.input = 0x590000U, .sitelen_pona_id=0x33U}, // 5e -> meli
+	{.input = 0xB5B500U, .sitelen_pona_id=0x6AU}, // t5t5 -> telo
+	{.input = 0x884000U, .sitelen_pona_id=0x18U}, // ww4 -> ken
 	{.input = 0x59B000U, .sitelen_pona_id=0x1CU}, // 5et -> ko
-	{.input = 0x5B0000U, .sitelen_pona_id=0x29U}, // 5t -> linja
-	{.input = 0x5B5000U, .sitelen_pona_id=0x3EU}, // 5t5 -> nasa
-	{.input = 0x5B5300U, .sitelen_pona_id=0x85U}, // 5t53 -> lanpan
-	{.input = 0x5B5800U, .sitelen_pona_id=0x1AU}, // 5t5w -> kili
-	{.input = 0x5B5B00U, .sitelen_pona_id=0x6AU}, // 5t5t -> telo
-	{.input = 0x5B5B80U, .sitelen_pona_id=0x7FU}, // 5t5tw -> jasima
-	{.input = 0x600000U, .sitelen_pona_id=0x90U}, // 6 -> [
-	{.input = 0x700000U, .sitelen_pona_id=0x2DU}, // q -> luka
-	{.input = 0x72B000U, .sitelen_pona_id=0x36U}, // q2t -> moku
-	{.input = 0x730000U, .sitelen_pona_id=0x59U}, // q3 -> seme
+	{.input = 0x910000U, .sitelen_pona_id=0x04U}, // e1 -> ale
+	{.input = 0xB2A200U, .sitelen_pona_id=0x2BU}, // t2r2 -> loje
+	{.input = 0x282800U, .sitelen_pona_id=0x42U}, // 2w2w -> nimi
+	{.input = 0xA3A000U, .sitelen_pona_id=0x66U}, // r3r -> suwi
+	{.input = 0x400000U, .sitelen_pona_id=0x28U}, // 4 -> lili
+	{.input = 0xEF0000U, .sitelen_pona_id=0x61U}, // df -> sona
+	{.input = 0xA42000U, .sitelen_pona_id=0x26U}, // r42 -> lete
+	{.input = 0x833000U, .sitelen_pona_id=0x00U}, // w33 -> a
+	{.input = 0x899000U, .sitelen_pona_id=0x17U}, // wee -> kasi
+	{.input = 0x9982A0U, .sitelen_pona_id=0x23U}, // eew2r -> laso
+	{.input = 0xEE0000U, .sitelen_pona_id=0x7CU}, // dd -> leko
+	{.input = 0x930000U, .sitelen_pona_id=0x2EU}, // e3 -> lukin
+	{.input = 0x882000U, .sitelen_pona_id=0x65U}, // ww2 -> supa
+	{.input = 0xDA0000U, .sitelen_pona_id=0x6DU}, // sr -> tomo
 	{.input = 0x777000U, .sitelen_pona_id=0x10U}, // qqq -> jaki
-	{.input = 0x78E000U, .sitelen_pona_id=0x19U}, // qwd -> kepeken
+	{.input = 0xE33300U, .sitelen_pona_id=0x60U}, // d333 -> sitelen
+	{.input = 0x229000U, .sitelen_pona_id=0x22U}, // 22e -> lape
+	{.input = 0x999000U, .sitelen_pona_id=0x1FU}, // eee -> kulupu
+	{.input = 0x5B5800U, .sitelen_pona_id=0x1AU}, // 5t5w -> kili
+	{.input = 0x9B0000U, .sitelen_pona_id=0x32U}, // et -> mani
+	{.input = 0xA00000U, .sitelen_pona_id=0x27U}, // r -> li
+	{.input = 0xA22200U, .sitelen_pona_id=0x1EU}, // r222 -> kule
 	{.input = 0x790000U, .sitelen_pona_id=0x49U}, // qe -> pali
-	{.input = 0x7B2000U, .sitelen_pona_id=0x36U}, // qt2 -> moku
-	{.input = 0x7E8000U, .sitelen_pona_id=0x19U}, // qdw -> kepeken
-	{.input = 0x7F0000U, .sitelen_pona_id=0x4CU}, // qf -> pana
-	{.input = 0x800000U, .sitelen_pona_id=0x73U}, // w -> wan
+	{.input = 0x998A20U, .sitelen_pona_id=0x23U}, // eewr2 -> laso
+	{.input = 0x970000U, .sitelen_pona_id=0x49U}, // eq -> pali
+	{.input = 0x928200U, .sitelen_pona_id=0x7EU}, // e2w2 -> tonsi
+	{.input = 0x8B8000U, .sitelen_pona_id=0x2FU}, // wtw -> lupa
+	{.input = 0xF80000U, .sitelen_pona_id=0x76U}, // fw -> weka
+	{.input = 0x288000U, .sitelen_pona_id=0x65U}, // 2ww -> supa
+	{.input = 0xE429FBU, .sitelen_pona_id=0x88U}, // d42eft -> ku
+	{.input = 0xA22B00U, .sitelen_pona_id=0x2BU}, // r22t -> loje
+	{.input = 0x413000U, .sitelen_pona_id=0x7AU}, // 413 -> oko
+	{.input = 0x554554U, .sitelen_pona_id=0x45U}, // 554554 -> olin
+	{.input = 0x850000U, .sitelen_pona_id=0x86U}, // w5 -> n
+	{.input = 0x9D0000U, .sitelen_pona_id=0x81U}, // es -> soko
+	{.input = 0x9F2000U, .sitelen_pona_id=0x84U}, // ef2 -> kokosila
+	{.input = 0xA4A400U, .sitelen_pona_id=0x1DU}, // r4r4 -> kon
+	{.input = 0xA20000U, .sitelen_pona_id=0x1EU}, // r2 -> kule
 	{.input = 0x812000U, .sitelen_pona_id=0x03U}, // w12 -> alasa
+	{.input = 0xA24000U, .sitelen_pona_id=0x72U}, // r24 -> walo
+	{.input = 0x882200U, .sitelen_pona_id=0x3DU}, // ww22 -> nanpa
+	{.input = 0x55B900U, .sitelen_pona_id=0x6FU}, // 55te -> unpa
+	{.input = 0x338222U, .sitelen_pona_id=0x51U}, // 33w222 -> pipi
+	{.input = 0xAA0000U, .sitelen_pona_id=0x09U}, // rr -> e
+	{.input = 0x898000U, .sitelen_pona_id=0x75U}, // wew -> wawa
+	{.input = 0x3D3000U, .sitelen_pona_id=0x05U}, // 3s3 -> anpa
+	{.input = 0x33D330U, .sitelen_pona_id=0x0FU}, // 33s33 -> insa
+	{.input = 0xB88500U, .sitelen_pona_id=0x4AU}, // tww5 -> palisa
+	{.input = 0x990000U, .sitelen_pona_id=0x5CU}, // ee -> sike
+	{.input = 0x94A000U, .sitelen_pona_id=0x37U}, // e4r -> moli
+	{.input = 0x5B5B00U, .sitelen_pona_id=0x6AU}, // 5t5t -> telo
+	{.input = 0x2B7000U, .sitelen_pona_id=0x36U}, // 2tq -> moku
+	{.input = 0x828800U, .sitelen_pona_id=0x5BU}, // w2ww -> sijelo
+	{.input = 0x55B000U, .sitelen_pona_id=0x4EU}, // 55t -> pilin
+	{.input = 0x982200U, .sitelen_pona_id=0x7EU}, // ew22 -> tonsi
+	{.input = 0x7F0000U, .sitelen_pona_id=0x4CU}, // qf -> pana
+	{.input = 0x2A2000U, .sitelen_pona_id=0x08U}, // 2r2 -> awen
+	{.input = 0x8B8520U, .sitelen_pona_id=0x87U}, // wtw52 -> misikeke
+	{.input = 0x228000U, .sitelen_pona_id=0xA0U}, // 22w -> pake
+	{.input = 0xFE0000U, .sitelen_pona_id=0x61U}, // fd -> sona
+	{.input = 0x94A4A0U, .sitelen_pona_id=0x37U}, // e4r4r -> moli
 	{.input = 0x812800U, .sitelen_pona_id=0x43U}, // w12w -> noka
-	{.input = 0x812A00U, .sitelen_pona_id=0x03U}, // w12r -> alasa
-	{.input = 0x818000U, .sitelen_pona_id=0x43U}, // w1w -> noka
-	{.input = 0x820000U, .sitelen_pona_id=0x4DU}, // w2 -> pi
-	{.input = 0x822000U, .sitelen_pona_id=0xA0U}, // w22 -> pake
+	{.input = 0x111100U, .sitelen_pona_id=0x1DU}, // 1111 -> kon
+	{.input = 0x280000U, .sitelen_pona_id=0x68U}, // 2w -> taso
+	{.input = 0x8A0000U, .sitelen_pona_id=0x3FU}, // wr -> nasin
+	{.input = 0x588B20U, .sitelen_pona_id=0x87U}, // 5wwt2 -> misikeke
+	{.input = 0x5B5000U, .sitelen_pona_id=0x3EU}, // 5t5 -> nasa
+	{.input = 0x450000U, .sitelen_pona_id=0x67U}, // 45 -> tan
+	{.input = 0xB85000U, .sitelen_pona_id=0x0BU}, // tw5 -> esun
+	{.input = 0xD33000U, .sitelen_pona_id=0x0FU}, // s33 -> insa
+	{.input = 0x332229U, .sitelen_pona_id=0x01U}, // 33222e -> akesi
+	{.input = 0x2D0000U, .sitelen_pona_id=0x47U}, // 2s -> open
+	{.input = 0x52D000U, .sitelen_pona_id=0x81U}, // 52s -> soko
+	{.input = 0x888000U, .sitelen_pona_id=0x3CU}, // www -> mute
+	{.input = 0x2A2B00U, .sitelen_pona_id=0x2BU}, // 2r2t -> loje
+	{.input = 0xE87000U, .sitelen_pona_id=0x19U}, // dwq -> kepeken
+	{.input = 0x360000U, .sitelen_pona_id=0x38U}, // 36 -> monsi
 	{.input = 0x822233U, .sitelen_pona_id=0x51U}, // w22233 -> pipi
-	{.input = 0x828000U, .sitelen_pona_id=0x0AU}, // w2w -> en
-	{.input = 0x828200U, .sitelen_pona_id=0x42U}, // w2w2 -> nimi
-	{.input = 0x828800U, .sitelen_pona_id=0x5BU}, // w2ww -> sijelo
-	{.input = 0x828880U, .sitelen_pona_id=0x58U}, // w2www -> selo
-	{.input = 0x830000U, .sitelen_pona_id=0x44U}, // w3 -> o
-	{.input = 0x833000U, .sitelen_pona_id=0x00U}, // w33 -> a
-	{.input = 0x838000U, .sitelen_pona_id=0x82U}, // w3w -> meso
-	{.input = 0x840000U, .sitelen_pona_id=0x41U}, // w4 -> ni
-	{.input = 0x848000U, .sitelen_pona_id=0x63U}, // w4w -> suli
-	{.input = 0x84A000U, .sitelen_pona_id=0x79U}, // w4r -> kin
-	{.input = 0x84A800U, .sitelen_pona_id=0x79U}, // w4rw -> kin
-	{.input = 0x850000U, .sitelen_pona_id=0x86U}, // w5 -> n
-	{.input = 0x858000U, .sitelen_pona_id=0x40U}, // w5w -> nena
-	{.input = 0x858B00U, .sitelen_pona_id=0x4AU}, // w5wt -> palisa
-	{.input = 0x858B20U, .sitelen_pona_id=0x87U}, // w5wt2 -> misikeke
 	{.input = 0x85B5B0U, .sitelen_pona_id=0x7FU}, // w5t5t -> jasima
-	{.input = 0x880000U, .sitelen_pona_id=0x6EU}, // ww -> tu
-	{.input = 0x882000U, .sitelen_pona_id=0x65U}, // ww2 -> supa
-	{.input = 0x882200U, .sitelen_pona_id=0x3DU}, // ww22 -> nanpa
-	{.input = 0x884000U, .sitelen_pona_id=0x18U}, // ww4 -> ken
-	{.input = 0x885000U, .sitelen_pona_id=0x40U}, // ww5 -> nena
-	{.input = 0x888000U, .sitelen_pona_id=0x3CU}, // www -> mute
-	{.input = 0x888E00U, .sitelen_pona_id=0x25U}, // wwwd -> len
-	{.input = 0x88A000U, .sitelen_pona_id=0x83U}, // wwr -> epiku
-	{.input = 0x88B000U, .sitelen_pona_id=0x2FU}, // wwt -> lupa
-	{.input = 0x890000U, .sitelen_pona_id=0x34U}, // we -> mi
-	{.input = 0x893000U, .sitelen_pona_id=0x00U}, // we3 -> a
-	{.input = 0x898000U, .sitelen_pona_id=0x75U}, // wew -> wawa
-	{.input = 0x899000U, .sitelen_pona_id=0x17U}, // wee -> kasi
-	{.input = 0x8992A0U, .sitelen_pona_id=0x23U}, // wee2r -> laso
+	{.input = 0x999A00U, .sitelen_pona_id=0xA1U}, // eeer -> apeja
+	{.input = 0x9A4A40U, .sitelen_pona_id=0x37U}, // er4r4 -> moli
+	{.input = 0x540000U, .sitelen_pona_id=0x67U}, // 54 -> tan
+	{.input = 0x220000U, .sitelen_pona_id=0x56U}, // 22 -> sama
+	{.input = 0x554900U, .sitelen_pona_id=0x6FU}, // 554e -> unpa
+	{.input = 0x78E000U, .sitelen_pona_id=0x19U}, // qwd -> kepeken
+	{.input = 0x320000U, .sitelen_pona_id=0x2CU}, // 32 -> lon
+	{.input = 0x228800U, .sitelen_pona_id=0x3DU}, // 22ww -> nanpa
+	{.input = 0x888E00U, .sitelen_pona_id=0x25U}, // wwwd -> len
+	{.input = 0xE88800U, .sitelen_pona_id=0x25U}, // dwww -> len
+	{.input = 0xA9A000U, .sitelen_pona_id=0x35U}, // rer -> mije
+	{.input = 0x3F0000U, .sitelen_pona_id=0x57U}, // 3f -> seli
 	{.input = 0x899A20U, .sitelen_pona_id=0x23U}, // weer2 -> laso
-	{.input = 0x8A0000U, .sitelen_pona_id=0x3FU}, // wr -> nasin
-	{.input = 0x8A4000U, .sitelen_pona_id=0xA3U}, // wr4 -> powe
-	{.input = 0x8B5B50U, .sitelen_pona_id=0x7FU}, // wt5t5 -> jasima
-	{.input = 0x8B8000U, .sitelen_pona_id=0x2FU}, // wtw -> lupa
-	{.input = 0x8B8500U, .sitelen_pona_id=0x4AU}, // wtw5 -> palisa
-	{.input = 0x8B8520U, .sitelen_pona_id=0x87U}, // wtw52 -> misikeke
+	{.input = 0x858B00U, .sitelen_pona_id=0x4AU}, // w5wt -> palisa
+	{.input = 0x980000U, .sitelen_pona_id=0x5EU}, // ew -> sina
+	{.input = 0x290000U, .sitelen_pona_id=0x46U}, // 2e -> ona
+	{.input = 0xA88000U, .sitelen_pona_id=0x83U}, // rww -> epiku
+	{.input = 0x100000U, .sitelen_pona_id=0x21U}, // 1 -> la
+	{.input = 0x3AA000U, .sitelen_pona_id=0x66U}, // 3rr -> suwi
+	{.input = 0x300000U, .sitelen_pona_id=0x9CU}, // 3 -> .
+	{.input = 0x5B5B80U, .sitelen_pona_id=0x7FU}, // 5t5tw -> jasima
+	{.input = 0x993900U, .sitelen_pona_id=0x39U}, // ee3e -> mu
+	{.input = 0xB2F000U, .sitelen_pona_id=0x15U}, // t2f -> kalama
+	{.input = 0xB95000U, .sitelen_pona_id=0x1CU}, // te5 -> ko
+	{.input = 0xA99900U, .sitelen_pona_id=0xA1U}, // reee -> apeja
+	{.input = 0xF00000U, .sitelen_pona_id=0x5DU}, // f -> sin
+	{.input = 0x5B5300U, .sitelen_pona_id=0x85U}, // 5t53 -> lanpan
+	{.input = 0x444400U, .sitelen_pona_id=0x7DU}, // 4444 -> monsuta
+	{.input = 0x455455U, .sitelen_pona_id=0x45U}, // 455455 -> olin
+	{.input = 0x828000U, .sitelen_pona_id=0x0AU}, // w2w -> en
+	{.input = 0x982000U, .sitelen_pona_id=0x6BU}, // ew2 -> tenpo
+	{.input = 0x230000U, .sitelen_pona_id=0x2CU}, // 23 -> lon
+	{.input = 0xA22000U, .sitelen_pona_id=0x69U}, // r22 -> tawa
+	{.input = 0xE9FB00U, .sitelen_pona_id=0x55U}, // deft -> pu
+	{.input = 0x890000U, .sitelen_pona_id=0x34U}, // we -> mi
+	{.input = 0x370000U, .sitelen_pona_id=0x59U}, // 3q -> seme
+	{.input = 0x84A000U, .sitelen_pona_id=0x79U}, // w4r -> kin
+	{.input = 0xE78000U, .sitelen_pona_id=0x19U}, // dqw -> kepeken
+	{.input = 0x440000U, .sitelen_pona_id=0x63U}, // 44 -> suli
 	{.input = 0x8BB800U, .sitelen_pona_id=0x5AU}, // wttw -> sewi
-	{.input = 0x8E0000U, .sitelen_pona_id=0x0EU}, // wd -> ilo
-	{.input = 0x8E7000U, .sitelen_pona_id=0x19U}, // wdq -> kepeken
 	{.input = 0x900000U, .sitelen_pona_id=0x0CU}, // e -> ijo
-	{.input = 0x910000U, .sitelen_pona_id=0x04U}, // e1 -> ale
+	{.input = 0xBB8000U, .sitelen_pona_id=0x5AU}, // ttw -> sewi
+	{.input = 0xC30000U, .sitelen_pona_id=0x5FU}, // y3 -> sinpin
+	{.input = 0x9E0000U, .sitelen_pona_id=0x64U}, // ed -> suno
+	{.input = 0x72B000U, .sitelen_pona_id=0x36U}, // q2t -> moku
+	{.input = 0x8E7000U, .sitelen_pona_id=0x19U}, // wdq -> kepeken
+	{.input = 0x8B8500U, .sitelen_pona_id=0x4AU}, // wtw5 -> palisa
 	{.input = 0x920000U, .sitelen_pona_id=0x24U}, // e2 -> lawa
+	{.input = 0x42A000U, .sitelen_pona_id=0x26U}, // 42r -> lete
 	{.input = 0x922233U, .sitelen_pona_id=0x01U}, // e22233 -> akesi
-	{.input = 0x922800U, .sitelen_pona_id=0x7EU}, // e22w -> tonsi
-	{.input = 0x928000U, .sitelen_pona_id=0x30U}, // e2w -> ma
-	{.input = 0x928200U, .sitelen_pona_id=0x7EU}, // e2w2 -> tonsi
-	{.input = 0x930000U, .sitelen_pona_id=0x2EU}, // e3 -> lukin
-	{.input = 0x939900U, .sitelen_pona_id=0x39U}, // e3ee -> mu
-	{.input = 0x94A000U, .sitelen_pona_id=0x37U}, // e4r -> moli
-	{.input = 0x94A4A0U, .sitelen_pona_id=0x37U}, // e4r4r -> moli
-	{.input = 0x950000U, .sitelen_pona_id=0x33U}, // e5 -> meli
-	{.input = 0x970000U, .sitelen_pona_id=0x49U}, // eq -> pali
-	{.input = 0x980000U, .sitelen_pona_id=0x5EU}, // ew -> sina
-	{.input = 0x982000U, .sitelen_pona_id=0x6BU}, // ew2 -> tenpo
-	{.input = 0x982200U, .sitelen_pona_id=0x7EU}, // ew22 -> tonsi
-	{.input = 0x989000U, .sitelen_pona_id=0x17U}, // ewe -> kasi
-	{.input = 0x990000U, .sitelen_pona_id=0x5CU}, // ee -> sike
-	{.input = 0x993900U, .sitelen_pona_id=0x39U}, // ee3e -> mu
-	{.input = 0x998000U, .sitelen_pona_id=0x17U}, // eew -> kasi
-	{.input = 0x9982A0U, .sitelen_pona_id=0x23U}, // eew2r -> laso
-	{.input = 0x998A20U, .sitelen_pona_id=0x23U}, // eewr2 -> laso
-	{.input = 0x999000U, .sitelen_pona_id=0x1FU}, // eee -> kulupu
-	{.input = 0x999300U, .sitelen_pona_id=0x39U}, // eee3 -> mu
-	{.input = 0x999A00U, .sitelen_pona_id=0xA1U}, // eeer -> apeja
-	{.input = 0x99A900U, .sitelen_pona_id=0xA1U}, // eere -> apeja
-	{.input = 0x9A0000U, .sitelen_pona_id=0x11U}, // er -> jan
-	{.input = 0x9A4A40U, .sitelen_pona_id=0x37U}, // er4r4 -> moli
-	{.input = 0x9A9900U, .sitelen_pona_id=0xA1U}, // eree -> apeja
-	{.input = 0x9B0000U, .sitelen_pona_id=0x32U}, // et -> mani
-	{.input = 0x9B2000U, .sitelen_pona_id=0x13U}, // et2 -> jo
-	{.input = 0x9B9000U, .sitelen_pona_id=0x3BU}, // ete -> musi
-	{.input = 0x9D0000U, .sitelen_pona_id=0x81U}, // es -> soko
-	{.input = 0x9E0000U, .sitelen_pona_id=0x64U}, // ed -> suno
-	{.input = 0x9EA200U, .sitelen_pona_id=0x12U}, // edr2 -> jelo
-	{.input = 0x9F0000U, .sitelen_pona_id=0x6CU}, // ef -> toki
-	{.input = 0x9F2000U, .sitelen_pona_id=0x84U}, // ef2 -> kokosila
-	{.input = 0xA00000U, .sitelen_pona_id=0x27U}, // r -> li
-	{.input = 0xA20000U, .sitelen_pona_id=0x1EU}, // r2 -> kule
-	{.input = 0xA22000U, .sitelen_pona_id=0x69U}, // r22 -> tawa
-	{.input = 0xA22200U, .sitelen_pona_id=0x1EU}, // r222 -> kule
-	{.input = 0xA22B00U, .sitelen_pona_id=0x2BU}, // r22t -> loje
-	{.input = 0xA24000U, .sitelen_pona_id=0x72U}, // r24 -> walo
-	{.input = 0xA24A00U, .sitelen_pona_id=0x4FU}, // r24r -> pimeja
+	{.input = 0x3E0000U, .sitelen_pona_id=0x78U}, // 3d -> namako
 	{.input = 0xA28990U, .sitelen_pona_id=0x23U}, // r2wee -> laso
-	{.input = 0xA29890U, .sitelen_pona_id=0x23U}, // r2ewe -> laso
-	{.input = 0xA2B200U, .sitelen_pona_id=0x2BU}, // r2t2 -> loje
-	{.input = 0xA3A000U, .sitelen_pona_id=0x66U}, // r3r -> suwi
-	{.input = 0xA40000U, .sitelen_pona_id=0x06U}, // r4 -> ante
-	{.input = 0xA42000U, .sitelen_pona_id=0x26U}, // r42 -> lete
-	{.input = 0xA4A400U, .sitelen_pona_id=0x1DU}, // r4r4 -> kon
-	{.input = 0xA80000U, .sitelen_pona_id=0x3FU}, // rw -> nasin
-	{.input = 0xA83300U, .sitelen_pona_id=0x74U}, // rw33 -> waso
-	{.input = 0xA88000U, .sitelen_pona_id=0x83U}, // rww -> epiku
-	{.input = 0xA90000U, .sitelen_pona_id=0x14U}, // re -> kala
-	{.input = 0xA99900U, .sitelen_pona_id=0xA1U}, // reee -> apeja
-	{.input = 0xA9A000U, .sitelen_pona_id=0x35U}, // rer -> mije
-	{.input = 0xAA0000U, .sitelen_pona_id=0x09U}, // rr -> e
-	{.input = 0xAA3000U, .sitelen_pona_id=0x66U}, // rr3 -> suwi
-	{.input = 0xAAAA00U, .sitelen_pona_id=0x7DU}, // rrrr -> monsuta
-	{.input = 0xAD0000U, .sitelen_pona_id=0x6DU}, // rs -> tomo
-	{.input = 0xB00000U, .sitelen_pona_id=0x54U}, // t -> pona
+	{.input = 0x222833U, .sitelen_pona_id=0x51U}, // 222w33 -> pipi
+	{.input = 0x4AA200U, .sitelen_pona_id=0x4FU}, // 4rr2 -> pimeja
+	{.input = 0x2AB200U, .sitelen_pona_id=0x2BU}, // 2rt2 -> loje
 	{.input = 0xB23000U, .sitelen_pona_id=0x70U}, // t23 -> uta
-	{.input = 0xB27000U, .sitelen_pona_id=0x36U}, // t2q -> moku
-	{.input = 0xB2A200U, .sitelen_pona_id=0x2BU}, // t2r2 -> loje
-	{.input = 0xB2F000U, .sitelen_pona_id=0x15U}, // t2f -> kalama
-	{.input = 0xB50000U, .sitelen_pona_id=0x29U}, // t5 -> linja
-	{.input = 0xB5B000U, .sitelen_pona_id=0x3EU}, // t5t -> nasa
-	{.input = 0xB5B500U, .sitelen_pona_id=0x6AU}, // t5t5 -> telo
-	{.input = 0xB5B580U, .sitelen_pona_id=0x7FU}, // t5t5w -> jasima
-	{.input = 0xB85000U, .sitelen_pona_id=0x0BU}, // tw5 -> esun
-	{.input = 0xB85800U, .sitelen_pona_id=0x4AU}, // tw5w -> palisa
-	{.input = 0xB85820U, .sitelen_pona_id=0x87U}, // tw5w2 -> misikeke
-	{.input = 0xB88000U, .sitelen_pona_id=0x2FU}, // tww -> lupa
-	{.input = 0xB88500U, .sitelen_pona_id=0x4AU}, // tww5 -> palisa
-	{.input = 0xB88520U, .sitelen_pona_id=0x87U}, // tww52 -> misikeke
-	{.input = 0xB95000U, .sitelen_pona_id=0x1CU}, // te5 -> ko
-	{.input = 0xBB0000U, .sitelen_pona_id=0x77U}, // tt -> wile
-	{.input = 0xBB8000U, .sitelen_pona_id=0x5AU}, // ttw -> sewi
 	{.input = 0xC00000U, .sitelen_pona_id=0x91U}, // y -> ]
-	{.input = 0xC30000U, .sitelen_pona_id=0x5FU}, // y3 -> sinpin
-	{.input = 0xD00000U, .sitelen_pona_id=0x53U}, // s -> poki
-	{.input = 0xD20000U, .sitelen_pona_id=0x47U}, // s2 -> open
-	{.input = 0xD30000U, .sitelen_pona_id=0x52U}, // s3 -> poka
-	{.input = 0xD33000U, .sitelen_pona_id=0x0FU}, // s33 -> insa
-	{.input = 0xDA0000U, .sitelen_pona_id=0x6DU}, // sr -> tomo
+	{.input = 0x999300U, .sitelen_pona_id=0x39U}, // eee3 -> mu
+	{.input = 0x292000U, .sitelen_pona_id=0x32U}, // 2e2 -> mani
+	{.input = 0x998000U, .sitelen_pona_id=0x17U}, // eew -> kasi
+	{.input = 0xA40000U, .sitelen_pona_id=0x06U}, // r4 -> ante
+	{.input = 0x8992A0U, .sitelen_pona_id=0x23U}, // wee2r -> laso
+	{.input = 0xA2B200U, .sitelen_pona_id=0x2BU}, // r2t2 -> loje
+	{.input = 0x858B20U, .sitelen_pona_id=0x87U}, // w5wt2 -> misikeke
+	{.input = 0x480000U, .sitelen_pona_id=0x07U}, // 4w -> anu
+	{.input = 0x288880U, .sitelen_pona_id=0x58U}, // 2wwww -> selo
+	{.input = 0x9B9000U, .sitelen_pona_id=0x3BU}, // ete -> musi
+	{.input = 0x989000U, .sitelen_pona_id=0x17U}, // ewe -> kasi
 	{.input = 0xE00000U, .sitelen_pona_id=0x2AU}, // d -> lipu
-	{.input = 0xE30000U, .sitelen_pona_id=0x78U}, // d3 -> namako
-	{.input = 0xE33000U, .sitelen_pona_id=0x60U}, // d33 -> sitelen
-	{.input = 0xE33300U, .sitelen_pona_id=0x60U}, // d333 -> sitelen
-	{.input = 0xE42300U, .sitelen_pona_id=0x88U}, // d423 -> ku
-	{.input = 0xE429FBU, .sitelen_pona_id=0x88U}, // d42eft -> ku
-	{.input = 0xE4A000U, .sitelen_pona_id=0x48U}, // d4r -> pakala
-	{.input = 0xE78000U, .sitelen_pona_id=0x19U}, // dqw -> kepeken
-	{.input = 0xE80000U, .sitelen_pona_id=0x0EU}, // dw -> ilo
-	{.input = 0xE87000U, .sitelen_pona_id=0x19U}, // dwq -> kepeken
-	{.input = 0xE88800U, .sitelen_pona_id=0x25U}, // dwww -> len
-	{.input = 0xE9FB00U, .sitelen_pona_id=0x55U}, // deft -> pu
-	{.input = 0xEA4000U, .sitelen_pona_id=0x48U}, // dr4 -> pakala
-	{.input = 0xEE0000U, .sitelen_pona_id=0x7CU}, // dd -> leko
-	{.input = 0xEF0000U, .sitelen_pona_id=0x61U}, // df -> sona
-	{.input = 0xF00000U, .sitelen_pona_id=0x5DU}, // f -> sin
-	{.input = 0xF30000U, .sitelen_pona_id=0x57U}, // f3 -> seli
-	{.input = 0xF70000U, .sitelen_pona_id=0x4CU}, // fq -> pana
-	{.input = 0xF80000U, .sitelen_pona_id=0x76U}, // fw -> weka
-	{.input = 0xF92000U, .sitelen_pona_id=0x84U}, // fe2 -> kokosila
-	{.input = 0xFE0000U, .sitelen_pona_id=0x61U}, // fd -> sona
+	{.input = 0x2B3000U, .sitelen_pona_id=0x70U}, // 2t3 -> uta
+	{.input = 0x9A9900U, .sitelen_pona_id=0xA1U}, // eree -> apeja
+	{.input = 0x182A00U, .sitelen_pona_id=0x03U}, // 1w2r -> alasa
+	{.input = 0x84A800U, .sitelen_pona_id=0x79U}, // w4rw -> kin
+	{.input = 0x55B800U, .sitelen_pona_id=0x1AU}, // 55tw -> kili
 };
 
 const size_t LOOKUP_COMPACT_TABLE_LENGTH = sizeof(LOOKUP_COMPACT_TABLE)/sizeof(*LOOKUP_COMPACT_TABLE);
 
+// Minimal perfect hash of LOOKUP_COMPACT_TABLE. See lookup_hash_slot() in lookup.c
+static const uint8_t LOOKUP_COMPACT_TABLE_HASH_DISPLACEMENT[] = {
+	0x09, 0x02, 0x17, 0x00, 0x00, 0x06, 0x0E, 0x00, 0x06, 0x3C, 0x09, 0x12, 0x03, 0x1B, 0x07, 0x00,
+	0x13, 0x2F, 0x00, 0x16, 0x00, 0x22, 0x00, 0x03, 0x00, 0x01, 0x00, 0x33, 0x17, 0x03, 0x0C, 0x0A,
+	0x00, 0x04, 0x00, 0x01, 0x00, 0x3F, 0x00, 0x05, 0x10, 0x04, 0x0A, 0x06, 0x00, 0x00, 0x03, 0x00,
+	0x09, 0x01, 0x60, 0x10, 0x01, 0x01, 0x00, 0x45, 0x00, 0x04, 0x04, 0x01, 0x00, 0x00, 0x16, 0x00,
+	0x00, 0x2E, 0x26, 0x2F, 0x4E, 0x00, 0x05, 0x00, 0x15, 0x00, 0x0C, 0x01, 0x02, 0x04, 0x00, 0x3B,
+	0x0E, 0x01, 0x4C, 0x09, 0x0F, 0x52, 0x01, 0x00, 0x07, 0x37, 0x0D, 0x01, 0x1C, 0x08, 0x00, 0x00,
+	0x1B, 0x09, 0x04, 0x0C, 0x01, 0x00, 0x26, 0x1B, 0x19, 0x0C, 0x05, 0x01, 0x4F, 0x01, 0x03, 0x02,
+	0x00, 0x00, 0x34, 0x4D, 0x03, 0x03, 0x5A, 0x2D, 0x2A, 0x00, 0x05, 0x00, 0x78, 0x3E, 0x04, 0x24,
+};
+const struct lookup_perfect_hash LOOKUP_COMPACT_TABLE_HASH = {.seed=0x00000000U, .slot_mask=0xFFU, .displacement=LOOKUP_COMPACT_TABLE_HASH_DISPLACEMENT, .displacement_mask=0x7FU};
+
 // Covers the other characters/strings that requires up to 12 input letters. Can encode Each entry is 64bit.
+// The entries are stored in the slot order of LOOKUP_FULL_TABLE_HASH.
 const struct lookup_full_entry LOOKUP_FULL_TABLE[] = {
-	{.input_u52 = 0x0112A00000000ULL, .codepage=1, .code_id=0x10U}, // 112r -> unu
-	{.input_u52 = 0x011A200000000ULL, .codepage=1, .code_id=0x10U}, // 11r2 -> unu
-	{.input_u52 = 0x0133888800000ULL, .codepage=0, .code_id=0x62U}, // 133wwww -> soweli
-	{.input_u52 = 0x0188883300000ULL, .codepage=0, .code_id=0x62U}, // 1wwww33 -> soweli
-	{.input_u52 = 0x0200000000000ULL, .codepage=1, .code_id=0x03U}, // 2 -> __
+	{.input_u52 = 0x9AB0000000000ULL, .codepage=1, .code_id=0x05U}, // at -> :)
+	{.input_u52 = 0x9A40000000000ULL, .codepage=1, .code_id=0x08U}, // a4 -> :v
+	{.input_u52 = 0x9A10000000000ULL, .codepage=1, .code_id=0x05U}, // a1 -> :)
+	{.input_u52 = 0x08BB000000000ULL, .codepage=1, .code_id=0x11U}, // wtt -> wa
+	{.input_u52 = 0x09992A0000000ULL, .codepage=1, .code_id=0x0EU}, // eee2r -> mulapisu
+	{.input_u52 = 0x0928A20000000ULL, .codepage=1, .code_id=0x0BU}, // e2wr2 -> kapesi
+	{.input_u52 = 0x098885A888330ULL, .codepage=0, .code_id=0x80U}, // ewww5rwww33 -> kijetesantakalu
 	{.input_u52 = 0x0213388880000ULL, .codepage=0, .code_id=0x62U}, // 2133wwww -> soweli
-	{.input_u52 = 0x02A1100000000ULL, .codepage=1, .code_id=0x10U}, // 2r11 -> unu
-	{.input_u52 = 0x02A9280000000ULL, .codepage=1, .code_id=0x0BU}, // 2re2w -> kapesi
-	{.input_u52 = 0x02A9820000000ULL, .codepage=1, .code_id=0x0BU}, // 2rew2 -> kapesi
 	{.input_u52 = 0x02A9990000000ULL, .codepage=1, .code_id=0x0EU}, // 2reee -> mulapisu
-	{.input_u52 = 0x0333000000000ULL, .codepage=1, .code_id=0x04U}, // 333 -> ...
-	{.input_u52 = 0x0489000000000ULL, .codepage=1, .code_id=0x09U}, // 4we -> oke
-	{.input_u52 = 0x0666000000000ULL, .codepage=1, .code_id=0x00U}, // 666 -> \n
+	{.input_u52 = 0x09282A0000000ULL, .codepage=1, .code_id=0x0BU}, // e2w2r -> kapesi
+	{.input_u52 = 0x0838300000000ULL, .codepage=2, .code_id=0x02U}, // w3w3 -> a a a
+	{.input_u52 = 0x0AAA444000000ULL, .codepage=1, .code_id=0x0CU}, // rrr444 -> kiki
+	{.input_u52 = 0x0A29280000000ULL, .codepage=1, .code_id=0x0BU}, // r2e2w -> kapesi
+	{.input_u52 = 0x0999A20000000ULL, .codepage=1, .code_id=0x0EU}, // eeer2 -> mulapisu
+	{.input_u52 = 0x09822A0000000ULL, .codepage=1, .code_id=0x0BU}, // ew22r -> kapesi
+	{.input_u52 = 0x02A9820000000ULL, .codepage=1, .code_id=0x0BU}, // 2rew2 -> kapesi
+	{.input_u52 = 0x9AC0000000000ULL, .codepage=1, .code_id=0x05U}, // ay -> :)
+	{.input_u52 = 0x0AAAA44440000ULL, .codepage=1, .code_id=0x0CU}, // rrrr4444 -> kiki
 	{.input_u52 = 0x06C0000000000ULL, .codepage=2, .code_id=0x00U}, // 6y -> /sp
-	{.input_u52 = 0x0821000000000ULL, .codepage=1, .code_id=0x0FU}, // w21 -> Pingo
-	{.input_u52 = 0x0828333B58000ULL, .codepage=1, .code_id=0x0DU}, // w2w333t5w -> linluwi
-	{.input_u52 = 0x08288333B5000ULL, .codepage=1, .code_id=0x0DU}, // w2ww333t5 -> linluwi
 	{.input_u52 = 0x08288B5333000ULL, .codepage=1, .code_id=0x0DU}, // w2wwt5333 -> linluwi
+	{.input_u52 = 0x0A29990000000ULL, .codepage=1, .code_id=0x0EU}, // r2eee -> mulapisu
 	{.input_u52 = 0x0828B58333000ULL, .codepage=1, .code_id=0x0DU}, // w2wt5w333 -> linluwi
-	{.input_u52 = 0x0838300000000ULL, .codepage=2, .code_id=0x02U}, // w3w3 -> a a a
-	{.input_u52 = 0x08BB000000000ULL, .codepage=1, .code_id=0x11U}, // wtt -> wa
-	{.input_u52 = 0x08E4000000000ULL, .codepage=2, .code_id=0x01U}, // wd4 -> mi sona ala
-	{.input_u52 = 0x0922F00000000ULL, .codepage=1, .code_id=0x0AU}, // e22f -> isipin
-	{.input_u52 = 0x09282A0000000ULL, .codepage=1, .code_id=0x0BU}, // e2w2r -> kapesi
-	{.input_u52 = 0x0928A20000000ULL, .codepage=1, .code_id=0x0BU}, // e2wr2 -> kapesi
-	{.input_u52 = 0x0948000000000ULL, .codepage=1, .code_id=0x09U}, // e4w -> oke
-	{.input_u52 = 0x09822A0000000ULL, .codepage=1, .code_id=0x0BU}, // ew22r -> kapesi
-	{.input_u52 = 0x0982A20000000ULL, .codepage=1, .code_id=0x0BU}, // ew2r2 -> kapesi
-	{.input_u52 = 0x098885A888330ULL, .codepage=0, .code_id=0x80U}, // ewww5rwww33 -> kijetesantakalu
-	{.input_u52 = 0x09992A0000000ULL, .codepage=1, .code_id=0x0EU}, // eee2r -> mulapisu
-	{.input_u52 = 0x0999A20000000ULL, .codepage=1, .code_id=0x0EU}, // eeer2 -> mulapisu
-	{.input_u52 = 0x09F2200000000ULL, .codepage=1, .code_id=0x0AU}, // ef22 -> isipin
+	{.input_u52 = 0x0133888800000ULL, .codepage=0, .code_id=0x62U}, // 133wwww -> soweli
+	{.input_u52 = 0x0666000000000ULL, .codepage=1, .code_id=0x00U}, // 666 -> \n
+	{.input_u52 = 0x02A1100000000ULL, .codepage=1, .code_id=0x10U}, // 2r11 -> unu
 	{.input_u52 = 0x0A21100000000ULL, .codepage=1, .code_id=0x10U}, // r211 -> unu
-	{.input_u52 = 0x0A29280000000ULL, .codepage=1, .code_id=0x0BU}, // r2e2w -> kapesi
-	{.input_u52 = 0x0A29820000000ULL, .codepage=1, .code_id=0x0BU}, // r2ew2 -> kapesi
-	{.input_u52 = 0x0A29990000000ULL, .codepage=1, .code_id=0x0EU}, // r2eee -> mulapisu
-	{.input_u52 = 0x0AAA444000000ULL, .codepage=1, .code_id=0x0CU}, // rrr444 -> kiki
-	{.input_u52 = 0x0AAAA44440000ULL, .codepage=1, .code_id=0x0CU}, // rrrr4444 -> kiki
+	{.input_u52 = 0xA310000000000ULL, .codepage=1, .code_id=0x02U}, // gg -> \"
+	{.input_u52 = 0x09F2200000000ULL, .codepage=1, .code_id=0x0AU}, // ef22 -> isipin
+	{.input_u52 = 0x08288333B5000ULL, .codepage=1, .code_id=0x0DU}, // w2ww333t5 -> linluwi
 	{.input_u52 = 0x0F92200000000ULL, .codepage=1, .code_id=0x0AU}, // fe22 -> isipin
+	{.input_u52 = 0x0828333B58000ULL, .codepage=1, .code_id=0x0DU}, // w2w333t5w -> linluwi
+	{.input_u52 = 0x0112A00000000ULL, .codepage=1, .code_id=0x10U}, // 112r -> unu
+	{.input_u52 = 0x9AD0000000000ULL, .codepage=1, .code_id=0x01U}, // aa -> -
 	{.input_u52 = 0x9A00000000000ULL, .codepage=0, .code_id=0x9DU}, // a -> :
-	{.input_u52 = 0x9A10000000000ULL, .codepage=1, .code_id=0x05U}, // a1 -> :)
-	{.input_u52 = 0x9A20000000000ULL, .codepage=1, .code_id=0x07U}, // a2 -> :|
-	{.input_u52 = 0x9A40000000000ULL, .codepage=1, .code_id=0x08U}, // a4 -> :v
 	{.input_u52 = 0x9A50000000000ULL, .codepage=1, .code_id=0x06U}, // a5 -> :(
-	{.input_u52 = 0x9A60000000000ULL, .codepage=1, .code_id=0x06U}, // a6 -> :(
+	{.input_u52 = 0x08E4000000000ULL, .codepage=2, .code_id=0x01U}, // wd4 -> mi sona ala
+	{.input_u52 = 0x0200000000000ULL, .codepage=1, .code_id=0x03U}, // 2 -> __
+	{.input_u52 = 0x0333000000000ULL, .codepage=1, .code_id=0x04U}, // 333 -> ...
+	{.input_u52 = 0x0A29820000000ULL, .codepage=1, .code_id=0x0BU}, // r2ew2 -> kapesi
+	{.input_u52 = 0x0821000000000ULL, .codepage=1, .code_id=0x0FU}, // w21 -> Pingo
+	{.input_u52 = 0x02A9280000000ULL, .codepage=1, .code_id=0x0BU}, // 2re2w -> kapesi
+	{.input_u52 = 0x011A200000000ULL, .codepage=1, .code_id=0x10U}, // 11r2 -> unu
+	{.input_u52 = 0x0489000000000ULL, .codepage=1, .code_id=0x09U}, // 4we -> oke
+	{.input_u52 = 0x0948000000000ULL, .codepage=1, .code_id=0x09U}, // e4w -> oke
 	{.input_u52 = 0x9A80000000000ULL, .codepage=1, .code_id=0x07U}, // aw -> :|
-	{.input_u52 = 0x9AB0000000000ULL, .codepage=1, .code_id=0x05U}, // at -> :)
-	{.input_u52 = 0x9AC0000000000ULL, .codepage=1, .code_id=0x05U}, // ay -> :)
-	{.input_u52 = 0x9AD0000000000ULL, .codepage=1, .code_id=0x01U}, // aa -> -
+	{.input_u52 = 0x0982A20000000ULL, .codepage=1, .code_id=0x0BU}, // ew2r2 -> kapesi
+	{.input_u52 = 0x0188883300000ULL, .codepage=0, .code_id=0x62U}, // 1wwww33 -> soweli
+	{.input_u52 = 0x9A60000000000ULL, .codepage=1, .code_id=0x06U}, // a6 -> :(
 	{.input_u52 = 0xA200000000000ULL, .codepage=1, .code_id=0x12U}, // g -> ,
-	{.input_u52 = 0xA310000000000ULL, .codepage=1, .code_id=0x02U}, // gg -> \"
+	{.input_u52 = 0x0922F00000000ULL, .codepage=1, .code_id=0x0AU}, // e22f -> isipin
+	{.input_u52 = 0x9A20000000000ULL, .codepage=1, .code_id=0x07U}, // a2 -> :|
 };
 
 const size_t LOOKUP_FULL_TABLE_LENGTH = sizeof(LOOKUP_FULL_TABLE)/sizeof(*LOOKUP_FULL_TABLE);
 
+// Minimal perfect hash of LOOKUP_FULL_TABLE. See lookup_hash_slot() in lookup.c
+static const uint8_t LOOKUP_FULL_TABLE_HASH_DISPLACEMENT[] = {
+	0x2C, 0x00, 0x0A, 0x09, 0x06, 0x0A, 0x01, 0x03, 0x00, 0x0B, 0x06, 0x03, 0x01, 0x2A, 0x1D, 0x0C,
+};
+const struct lookup_perfect_hash LOOKUP_FULL_TABLE_HASH = {.seed=0x0000018EU, .slot_mask=0x3FU, .displacement=LOOKUP_FULL_TABLE_HASH_DISPLACEMENT, .displacement_mask=0xFU};
+
+// Trie of the input sequences of LOOKUP_COMPACT_TABLE and LOOKUP_FULL_TABLE, in breadth-first order. The root is the first node.
+// Format of each node: first_child:9 (0 if none), terminal:1, last_sibling:1, key_id:5. See lookup_trie_next() in lookup.c
+const uint16_t LOOKUP_TRIE[] = {
+	0x00A0U, // (root)
+	0x0941U, // 1
+	0x0AC2U, // 2
+	0x0EC3U, // 3
+	0x1444U, // 4
+	0x1745U, // 5
+	0x1A46U, // 6
+	0x1B47U, // q
+	0x1F48U, // w
+	0x2449U, // e
+	0x2ACAU, // r
+	0x2E4BU, // t
+	0x30CCU, // y
+	0x314DU, // a
+	0x35CEU, // s
+	0x374FU, // d
+	0x3B50U, // f
+	0x3DF1U, // g
+	0x3E41U, // 11
+	0x3FC3U, // 13
+	0x4028U, // 1w
+	0x4101U, // 21
+	0x41C2U, // 22
+	0x0043U, // 23
+	0x43C8U, // 2w
+	0x44C9U, // 2e
+	0x450AU, // 2r
+	0x478BU, // 2t
+	0x006EU, // 2s
+	0x0041U, // 31
+	0x4942U, // 32
+	0x4983U, // 33
+	0x0046U, // 36
+	0x0047U, // 3q
+	0x4C08U, // 3w
+	0x0049U, // 3e
+	0x4D0AU, // 3r
+	0x4D8EU, // 3s
+	0x004FU, // 3d
+	0x0070U, // 3f
+	0x4E01U, // 41
+	0x4E82U, // 42
+	0x4F44U, // 44
+	0x5045U, // 45
+	0x50C8U, // 4w
+	0x51EAU, // 4r
+	0x5302U, // 52
+	0x0044U, // 54
+	0x5385U, // 55
+	0x5488U, // 5w
+	0x55C9U, // 5e
+	0x566BU, // 5t
+	0x5686U, // 66
+	0x006CU, // 6y
+	0x5702U, // q2
+	0x0043U, // q3
+	0x5787U, // qq
+	0x5808U, // qw
+	0x0049U, // qe
+	0x588BU, // qt
+	0x590FU, // qd
+	0x0070U, // qf
+	0x5981U, // w1
+	0x5AC2U, // w2
+	0x5C43U, // w3
+	0x5D44U, // w4
+	0x5E45U, // w5
+	0x5F48U, // ww
+	0x6249U, // we
+	0x63CAU, // wr
+	0x640BU, // wt
+	0x65EFU, // wd
+	0x0041U, // e1
+	0x66C2U, // e2
+	0x67C3U, // e3
+	0x6804U, // e4
+	0x0045U, // e5
+	0x0047U, // eq
+	0x6948U, // ew
+	0x6AC9U, // ee
+	0x6CCAU, // er
+	0x6DCBU, // et
+	0x004EU, // es
+	0x6ECFU, // ed
+	0x6F70U, // ef
+	0x6FC2U, // r2
+	0x7283U, // r3
+	0x7344U, // r4
+	0x7448U, // rw
+	0x7549U, // re
+	0x764AU, // rr
+	0x006EU, // rs
+	0x7702U, // t2
+	0x7945U, // t5
+	0x7988U, // tw
+	0x7A89U, // te
+	0x7B6BU, // tt
+	0x0063U, // y3
+	0x0041U, // a1
+	0x0042U, // a2
+	0x0044U, // a4
+	0x0045U, // a5
+	0x0046U, // a6
+	0x0048U, // aw
+	0x004BU, // at
+	0x004CU, // ay
+	0x006DU, // aa
+	0x0042U, // s2
+	0x7BC3U, // s3
+	0x006AU, // sr
+	0x7C43U, // d3
+	0x7C84U, // d4
+	0x7D87U, // dq
+	0x7E48U, // dw
+	0x7F09U, // de
+	0x7F8AU, // dr
+	0x004FU, // dd
+	0x0070U, // df
+	0x0043U, // f3
+	0x0047U, // fq
+	0x0048U, // fw
+	0x8009U, // fe
+	0x006FU, // fd
+	0x0071U, // gg
+	0x8081U, // 111
+	0x8102U, // 112
+	0x81AAU, // 11r
+	0x8223U, // 133
+	0x82C2U, // 1w2
+	0x8328U, // 1ww
+	0x8423U, // 213
+	0x8482U, // 222
+	0x8548U, // 22w
+	0x0049U, // 22e
+	0x006AU, // 22r
+	0x8642U, // 2w2
+	0x8768U, // 2ww
+	0x0062U, // 2e2
+	0x8781U, // 2r1
+	0x8842U, // 2r2
+	0x0044U, // 2r4
+	0x8889U, // 2re
+	0x8A2BU, // 2rt
+	0x0043U, // 2t3
+	0x0047U, // 2tq
+	0x8AAAU, // 2tr
+	0x8B28U, // 32w
+	0x8B82U, // 332
+	0x0043U, // 333
+	0x8C08U, // 33w
+	0x8C8AU, // 33r
+	0x8D2EU, // 33s
+	0x0043U, // 3w3
+	0x0068U, // 3ww
+	0x006AU, // 3rr
+	0x0063U, // 3s3
+	0x0063U, // 413
+	0x006AU, // 42r
+	0x8DC4U, // 444
+	0x8E2AU, // 44r
+	0x8EE5U, // 455
+	0x8F08U, // 4ww
+	0x0069U, // 4we
+	0x0042U, // 4r2
+	0x8FC4U, // 4r4
+	0x902AU, // 4rr
+	0x006EU, // 52s
+	0x90C4U, // 554
+	0x91EBU, // 55t
+	0x92C8U, // 5ww
+	0x932BU, // 5wt
+	0x006BU, // 5et
+	0x93E5U, // 5t5
+	0x0066U, // 666
+	0x006BU, // q2t
+	0x0067U, // qqq
+	0x006FU, // qwd
+	0x0062U, // qt2
+	0x0068U, // qdw
+	0x9542U, // w12
+	0x0068U, // w1w
+	0x0041U, // w21
+	0x9642U, // w22
+	0x96E8U, // w2w
+	0x0043U, // w33
+	0x98E8U, // w3w
+	0x0048U, // w4w
+	0x996AU, // w4r
+	0x99C8U, // w5w
+	0x9A2BU, // w5t
+	0x9AC2U, // ww2
+	0x0044U, // ww4
+	0x0045U, // ww5
+	0x9B48U, // www
+	0x004AU, // wwr
+	0x006BU, // wwt
+	0x0043U, // we3
+	0x0048U, // wew
+	0x9BE9U, // wee
+	0x0064U, // wr4
+	0x9C85U, // wt5
+	0x9D48U, // wtw
+	0x9DEBU, // wtt
+	0x0044U, // wd4
+	0x0067U, // wdq
+	0x9E02U, // e22
+	0x9FE8U, // e2w
+	0xA0A9U, // e3e
+	0x0048U, // e4w
+	0xA16AU, // e4r
+	0xA1C2U, // ew2
+	0xA288U, // eww
+	0x0069U, // ewe
+	0xA303U, // ee3
+	0xA3C8U, // eew
+	0xA4C9U, // eee
+	0xA62AU, // eer
+	0xA684U, // er4
+	0xA729U, // ere
+	0x0042U, // et2
+	0x0069U, // ete
+	0xA7AAU, // edr
+	0xA862U, // ef2
+	0xA881U, // r21
+	0xA942U, // r22
+	0xAA44U, // r24
+	0xAA88U, // r2w
+	0xAB09U, // r2e
+	0xACABU, // r2t
+	0x006AU, // r3r
+	0x0042U, // r42
+	0xAD2AU, // r4r
+	0xAD83U, // rw3
+	0x0068U, // rww
+	0xAE09U, // ree
+	0x006AU, // rer
+	0x0043U, // rr3
+	0xAEAAU, // rrr
+	0x0043U, // t23
+	0x0047U, // t2q
+	0xAF8AU, // t2r
+	0x0070U, // t2f
+	0xB06BU, // t5t
+	0xB0C5U, // tw5
+	0xB168U, // tww
+	0x0065U, // te5
+	0x0068U, // ttw
+	0x0063U, // s33
+	0xB1E3U, // d33
+	0xB202U, // d42
+	0x006AU, // d4r
+	0x0068U, // dqw
+	0x0047U, // dwq
+	0xB328U, // dww
+	0xB3B0U, // def
+	0x0064U, // dr4
+	0xB462U, // fe2
+	0x0061U, // 1111
+	0x006AU, // 112r
+	0x0062U, // 11r2
+	0xB4A8U, // 133w
+	0x006AU, // 1w2r
+	0xB503U, // 1ww3
+	0xB5A8U, // 1www
+	0xB623U, // 2133
+	0xB6A8U, // 222w
+	0xB702U, // 22w2
+	0x0068U, // 22ww
+	0x0043U, // 2w23
+	0x0068U, // 2w2w
+	0xB7E8U, // 2www
+	0x0061U, // 2r11
+	0x006BU, // 2r2t
+	0xB802U, // 2re2
+	0xB888U, // 2rew
+	0xB929U, // 2ree
+	0x0062U, // 2rt2
+	0x0062U, // 2tr2
+	0x0062U, // 32w2
+	0xB9A2U, // 3322
+	0xBA22U, // 33w2
+	0x0068U, // 33rw
+	0xBAA3U, // 33s3
+	0x0064U, // 4444
+	0x0064U, // 44r4
+	0xBB24U, // 4554
+	0x0062U, // 4ww2
+	0x006AU, // 4r4r
+	0x0062U, // 4rr2
+	0xBB85U, // 5545
+	0x0069U, // 554e
+	0x0048U, // 55tw
+	0x0069U, // 55te
+	0xBC6BU, // 5wwt
+	0xBCE8U, // 5wtw
+	0x0043U, // 5t53
+	0x0048U, // 5t5w
+	0xBD6BU, // 5t5t
+	0x0048U, // w12w
+	0x006AU, // w12r
+	0xBDA2U, // w222
+	0x0042U, // w2w2
+	0xBE03U, // w2w3
+	0xBEC8U, // w2ww
+	0xC02BU, // w2wt
+	0x0063U, // w3w3
+	0x0068U, // w4rw
+	0xC0EBU, // w5wt
+	0xC125U, // w5t5
+	0x0062U, // ww22
+	0x006FU, // wwwd
+	0xC182U, // wee2
+	0xC22AU, // weer
+	0xC2ABU, // wt5t
+	0xC365U, // wtw5
+	0x0068U, // wttw
+	0xC382U, // e222
+	0x0048U, // e22w
+	0x0070U, // e22f
+	0xC442U, // e2w2
+	0xC4AAU, // e2wr
+	0x0069U, // e3ee
+	0xC524U, // e4r4
+	0xC5C2U, // ew22
+	0xC62AU, // ew2r
+	0xC6A8U, // ewww
+	0x0069U, // ee3e
+	0xC702U, // eew2
+	0xC7AAU, // eewr
+	0xC802U, // eee2
+	0x0043U, // eee3
+	0xC8EAU, // eeer
+	0x0069U, // eere
+	0xC92AU, // er4r
+	0x0069U, // eree
+	0x0062U, // edr2
+	0x0062U, // ef22
+	0x0061U, // r211
+	0x0042U, // r222
+	0x006BU, // r22t
+	0x006AU, // r24r
+	0xC9A9U, // r2we
+	0xCA02U, // r2e2
+	0xCA88U, // r2ew
+	0xCBA9U, // r2ee
+	0x0062U, // r2t2
+	0x0064U, // r4r4
+	0x0063U, // rw33
+	0x0069U, // reee
+	0xCC04U, // rrr4
+	0xCCEAU, // rrrr
+	0x0062U, // t2r2
+	0xCD65U, // t5t5
+	0xCDE8U, // tw5w
+	0xCE65U, // tww5
+	0x0063U, // d333
+	0x0043U, // d423
+	0xCEA9U, // d42e
+	0x0068U, // dwww
+	0x006BU, // deft
+	0x0062U, // fe22
+	0xCF68U, // 133ww
+	0x0063U, // 1ww33
+	0xCFA8U, // 1wwww
+	0xD028U, // 2133w
+	0xD0A3U, // 222w3
+	0x0062U, // 22w22
+	0x0068U, // 2wwww
+	0x0068U, // 2re2w
+	0x0062U, // 2rew2
+	0x0069U, // 2reee
+	0xD122U, // 33222
+	0xD1A2U, // 33w22
+	0x0063U, // 33s33
+	0xD225U, // 45545
+	0xD2A5U, // 55455
+	0x0062U, // 5wwt2
+	0x0062U, // 5wtw2
+	0x0068U, // 5t5tw
+	0xD323U, // w2223
+	0xD3A3U, // w2w33
+	0xD403U, // w2ww3
+	0x0048U, // w2www
+	0xD4ABU, // w2wwt
+	0xD525U, // w2wt5
+	0x0062U, // w5wt2
+	0x006BU, // w5t5t
+	0x006AU, // wee2r
+	0x0062U, // weer2
+	0x0065U, // wt5t5
+	0x0062U, // wtw52
+	0xD5A3U, // e2223
+	0x006AU, // e2w2r
+	0x0062U, // e2wr2
+	0x006AU, // e4r4r
+	0x006AU, // ew22r
+	0x0062U, // ew2r2
+	0xD625U, // ewww5
+	0x006AU, // eew2r
+	0x0062U, // eewr2
+	0x006AU, // eee2r
+	0x0062U, // eeer2
+	0x0064U, // er4r4
+	0x0069U, // r2wee
+	0x0068U, // r2e2w
+	0x0042U, // r2ew2
+	0x0069U, // r2ewe
+	0x0069U, // r2eee
+	0xD6A4U, // rrr44
+	0xD724U, // rrrr4
+	0x0068U, // t5t5w
+	0x0062U, // tw5w2
+	0x0062U, // tww52
+	0xD7B0U, // d42ef
+	0xD828U, // 133www
+	0xD8A3U, // 1wwww3
+	0xD928U, // 2133ww
+	0x0063U, // 222w33
+	0x0069U, // 33222e
+	0x0062U, // 33w222
+	0x0065U, // 455455
+	0x0064U, // 554554
+	0x0063U, // w22233
+	0xD9A3U, // w2w333
+	0xDA23U, // w2ww33
+	0xDAA5U, // w2wwt5
+	0xDB28U, // w2wt5w
+	0x0063U, // e22233
+	0xDBAAU, // ewww5r
+	0x0064U, // rrr444
+	0xDC24U, // rrrr44
+	0x006BU, // d42eft
+	0x0068U, // 133wwww
+	0x0063U, // 1wwww33
+	0xDCA8U, // 2133www
+	0xDD2BU, // w2w333t
+	0xDDA3U, // w2ww333
+	0xDE23U, // w2wwt53
+	0xDEA3U, // w2wt5w3
+	0xDF28U, // ewww5rw
+	0xDFA4U, // rrrr444
+	0x0068U, // 2133wwww
+	0xE025U, // w2w333t5
+	0xE0ABU, // w2ww333t
+	0xE123U, // w2wwt533
+	0xE1A3U, // w2wt5w33
+	0xE228U, // ewww5rww
+	0x0064U, // rrrr4444
+	0x0068U, // w2w333t5w
+	0x0065U, // w2ww333t5
+	0x0063U, // w2wwt5333
+	0x0063U, // w2wt5w333
+	0xE2A8U, // ewww5rwww
+	0xE323U, // ewww5rwww3
+	0x0063U, // ewww5rwww33
+};
+
+// Keys of the ASCII characters typed by the firmware that aren't on the same key in every layout, for each layout of
+// enum keyboard_layout after KEYBOARD_LAYOUT_QWERTY. See keyboard_get_key() in keyboard.c
+const char LOOKUP_LAYOUT_CHARS[] = "\"(),-.0123456789:?P[]_abcdefghijklmnopqstuvw|";
+const size_t LOOKUP_LAYOUT_CHARS_LENGTH = 45;
+const uint8_t LOOKUP_LAYOUT_KEYS[] = {
+	// AZERTY
+	0x20, 0x22, 0x2D, 0x10, 0x23, 0xB6, 0xA7, 0x9E, 0x9F, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6,
+	0x37, 0x90, 0x93, 0x62, 0x6D, 0x25, 0x14, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D,
+	0x0E, 0x0F, 0x33, 0x11, 0x12, 0x13, 0x04, 0x16, 0x17, 0x18, 0x19, 0x1D, 0x63,
+	// QWERTZ
+	0x9F, 0xA5, 0xA6, 0x36, 0x38, 0x37, 0x27, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26,
+	0xB7, 0xAD, 0x93, 0x65, 0x66, 0xB8, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D,
+	0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x43,
+	// CZECH
+	0xB3, 0xB0, 0x30, 0x36, 0x38, 0x37, 0xA7, 0x9E, 0x9F, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6,
+	0xB7, 0xB6, 0x93, 0x49, 0x4A, 0xB8, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D,
+	0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x83,
+	// DVORAK
+	0x94, 0xA6, 0xA7, 0x1A, 0x34, 0x08, 0x27, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26,
+	0x9D, 0xAF, 0x95, 0x2D, 0x2E, 0xB4, 0x04, 0x11, 0x0C, 0x0B, 0x07, 0x1C, 0x18, 0x0D, 0x0A, 0x06,
+	0x19, 0x13, 0x10, 0x0F, 0x16, 0x15, 0x1B, 0x33, 0x0E, 0x09, 0x37, 0x36, 0xB1,
+};
+
 // The content below is the compressed font data. The font size is 15x15.
+// Size of the font data: 6570 bytes uncompressed, 2481 bytes compressed + 128 bytes of FONT_DICTIONARY
+
+// Global column dictionary of the compressed images. See lookup_decompress_image() in lookup.c
+const uint8_t FONT_DICTIONARY_INDEX_BITS = 6;
+const uint16_t FONT_DICTIONARY[] = {
+	0x0000U, 0x7FFFU, 0x0080U, 0x4001U, 0x0410U, 0x2002U, 0x4000U, 0x1004U,
+	0x01C0U, 0x0220U, 0x03E0U, 0x0100U, 0x0400U, 0x0800U, 0x0002U, 0x0200U,
+	0x2000U, 0x0040U, 0x0808U, 0x0C18U, 0x0030U, 0x0001U, 0x0004U, 0x0008U,
+	0x0010U, 0x0020U, 0x0140U, 0x3000U, 0x1000U, 0x3800U, 0x00C0U, 0x0102U,
+	0x0E00U, 0x0E38U, 0x2082U, 0x4081U, 0x000CU, 0x00F8U, 0x0110U, 0x0180U,
+	0x0F00U, 0x1084U, 0x1800U, 0x1C00U, 0x4008U, 0x4010U, 0x40C0U, 0x4400U,
+	0x7FC0U, 0x0007U, 0x001CU, 0x0038U, 0x0070U, 0x00A0U, 0x07F0U, 0x0FF8U,
+	0x2080U, 0x4004U, 0x4030U, 0x4411U, 0x7000U, 0x7C00U, 0x0003U, 0x000EU,
+};
 
-const uint8_t FONT_CODEPAGE_0[] = {
-	0xAA, 0x00, 0x70, 0x00, 0x88, 0xFE, 0x89, 0x00, 0x48, 0x00, 0xF8, // U+F1900
-	0x4B, 0x40, 0x12, 0x46, 0x12, 0xE6, 0x3F, 0x50, 0x52, 0x48, 0x92, 0x09, // U+F1901
-	0x10, 0x02, 0x80, 0x04, 0x40, 0x08, 0x20, 0x10, 0x10, 0x20, 0x08, 0x40, 0x04, 0x80, 0x02, 0x00, 0x01, // U+F1902
-	0x17, 0x00, 0x01, 0x11, 0xFE, 0xFF, 0x02, 0x81, 0x45, 0x10, 0x84, 0x10, 0x02, 0x93, 0x01, 0x7C, 0x10, 0x01, 0x54, 0x00, 0x38, 0x00, 0x10, 0x00, // U+F1903
-	0x09, 0x80, 0x07, 0x40, 0x08, 0x20, 0x10, 0x55, 0x35, 0x01, // U+F1904
-	0x0A, 0xFE, 0x03, 0x00, 0x02, 0x33, 0x33, 0x00, 0x42, 0x00, 0xE2, // U+F1905
-	0x4C, 0x02, 0x80, 0x04, 0x40, 0x08, 0x20, 0x10, 0x10, 0x20, 0x08, 0x40, 0x04, // U+F1906
-	0x10, 0x02, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x00, 0x00, 0xFF, // U+F1907
-	0x0C, 0x00, 0x80, 0x11, 0x01, 0x00, 0x07, 0xE0, 0x00, 0x1C, 0x80, 0x03, 0x00, // U+F1908
-	0x15, 0x02, 0x80, 0x04, 0x40, 0x08, 0x20, 0x10, 0x10, 0x20, 0x08, 0x40, 0x04, 0x80, 0x02, 0x02, 0x81, 0x53, 0x97, 0xDB, 0x00, 0x01, // U+F1909
-	0x07, 0x00, 0x01, 0x11, 0x11, 0x11, 0xFE, 0xFF, // U+F190A
-	0x1B, 0x08, 0x30, 0x10, 0x48, 0x20, 0x84, 0x05, 0x44, 0x08, 0x84, 0x08, 0xFE, 0x87, 0x05, 0x42, 0x04, 0x24, 0x04, 0x24, 0x04, 0x38, 0x24, 0x80, 0x18, 0x80, 0x00, 0x40, // U+F190B
-	0x0C, 0xC0, 0x07, 0x30, 0x18, 0x08, 0x20, 0x04, 0x40, 0x27, 0x00, 0x98, 0x09, // U+F190C
-	0x0C, 0x00, 0x0C, 0x00, 0x03, 0x80, 0x00, 0x40, 0x00, 0x07, 0x02, 0x90, 0x09, // U+F190D
-	0x09, 0xFE, 0x01, 0x02, 0x01, 0x33, 0x33, 0xE3, 0xFF, 0x0F, // U+F190E
-	0x0A, 0xF0, 0x1F, 0x00, 0x10, 0x33, 0x33, 0x80, 0x10, 0xC0, 0x11, // U+F190F
-	0x1E, 0x00, 0x30, 0x00, 0x4A, 0x0C, 0x8D, 0x90, 0x88, 0x60, 0x65, 0x20, 0x12, 0x58, 0x15, 0x64, 0x09, 0x42, 0x19, 0xC2, 0x2A, 0x44, 0x49, 0x28, 0x85, 0x24, 0x82, 0x14, 0x6C, 0x08, 0x10, // U+F1910
-	0x0D, 0x00, 0x80, 0x00, 0x40, 0xE0, 0x23, 0x10, 0x14, 0x08, 0x08, 0x04, 0x10, 0xBB, // U+F1911
-	0x4C, 0x40, 0x80, 0x40, 0xC0, 0xE0, 0xA0, 0x10, 0x91, 0x08, 0x8A, 0x0E, 0x8E, // U+F1912
-	0x55, 0x00, 0x1E, 0x38, 0x21, 0xC4, 0x40, 0x82, 0x80, 0x27, 0x48, 0x48, 0x44, 0x88, 0x43, 0x04, 0x40, 0x02, 0xC0, 0x01, 0x00, 0x00, // U+F1913
-	0x11, 0x20, 0x08, 0x40, 0x04, 0x80, 0x02, 0x00, 0x01, 0x35, 0x01, 0x01, 0x91, 0x99, 0x19, 0x03, 0x38, 0x00, // U+F1914
-	0x4C, 0x08, 0x07, 0x10, 0x19, 0x20, 0x21, 0x00, 0x21, 0x00, 0x41, 0x1C, 0x41, // U+F1915
-	0x1B, 0x00, 0x80, 0x11, 0x00, 0xC0, 0x00, 0x3C, 0x80, 0x03, 0x78, 0x00, 0x06, 0x00, 0x18, 0x00, 0x60, 0x80, 0x80, 0x81, 0x00, 0x46, 0x00, 0x58, 0x00, 0x20, 0x00, 0x00, // U+F1916
-	0x18, 0xE0, 0x00, 0x10, 0x01, 0x10, 0x02, 0x55, 0x20, 0x02, 0x40, 0x01, 0x80, 0xFF, 0x60, 0x00, 0x98, 0x00, 0x84, 0x00, 0x11, 0x44, 0x00, 0x38, 0x00, // U+F1917
-	0x6F, 0xFE, 0xFF, 0x00, 0x01, 0x03, 0x28, 0x50, 0x40, 0x04, 0x20, 0x08, 0x18, 0x30, 0x06, 0xC0, // U+F1918
-	0x15, 0x00, 0x10, 0x00, 0x60, 0x3E, 0x80, 0x22, 0xF0, 0x22, 0x0C, 0x22, 0x02, 0xEB, 0x3F, 0xB0, 0x9B, 0xE7, 0x03, 0x00, 0x00, 0x10, // U+F1919
-	0x0F, 0xC0, 0x07, 0x30, 0x18, 0x08, 0x20, 0x04, 0x40, 0x87, 0x00, 0x08, 0x01, 0xE8, 0x01, 0x08, // U+F191A
-	0x10, 0x80, 0x00, 0x40, 0x01, 0x20, 0x02, 0x10, 0x04, 0x08, 0x08, 0x08, 0x10, 0x08, 0x20, 0x08, 0x40, // U+F191B
-	0x1B, 0xC0, 0x30, 0x30, 0x49, 0x08, 0x46, 0x08, 0x80, 0x10, 0x80, 0x47, 0x00, 0x24, 0x00, 0xD2, 0x12, 0x40, 0x2C, 0x80, 0x20, 0x80, 0x20, 0x46, 0xC0, 0x49, 0x00, 0x30, // U+F191C
-	0x30, 0x60, 0x00, 0x90, 0x40, 0x08, 0x21, 0x45, 0x20, 0x01, 0xC0, 0x00, 0x00, 0x10, 0x53, 0x75, 0x09, // U+F191D
-	0x10, 0x00, 0x81, 0x00, 0xE1, 0x00, 0x99, 0x00, 0x87, 0x80, 0x81, 0x60, 0x81, 0x18, 0x81, 0x06, 0x81, // U+F191E
-	0x0F, 0x00, 0x38, 0x00, 0x44, 0x00, 0x82, 0x85, 0x23, 0x48, 0x44, 0x24, 0x88, 0x23, 0x08, 0x00, // U+F191F
-	0x72, 0x60, 0x00, 0x10, 0x00, 0x08, 0x80, 0x04, 0x82, 0x84, 0x41, 0x04, 0x30, 0x08, 0x0E, 0xF0, 0x01, 0x00, 0x00, // U+F1920
-	0xAA, 0x02, 0x80, 0x04, 0x40, 0x08, 0x20, 0x30, 0x18, 0xC0, 0x07, // U+F1921
-	0x0E, 0x00, 0x01, 0x11, 0x11, 0x11, 0x01, 0x38, 0x00, 0x44, 0x00, 0x82, 0x70, 0x57, 0x03, // U+F1922
-	0x10, 0x30, 0x00, 0x48, 0x00, 0x84, 0x80, 0x84, 0xC0, 0x88, 0xA0, 0x90, 0x90, 0x60, 0x88, 0xC0, 0x8F, // U+F1923
-	0x11, 0xC0, 0x07, 0x70, 0x18, 0x48, 0x20, 0x44, 0x40, 0x42, 0x80, 0x99, 0x79, 0x35, 0x01, 0x04, 0xB0, 0x0B, // U+F1924
-	0x28, 0xFE, 0xFF, 0x02, 0x10, 0x33, 0x33, 0x02, 0xF0, // U+F1925
-	0x0F, 0x00, 0x01, 0x04, 0x41, 0x08, 0x21, 0x10, 0x11, 0x20, 0x09, 0x40, 0x05, 0x80, 0x03, 0x01, // U+F1926
-	0x72, 0x02, 0x80, 0x04, 0x40, 0x08, 0x20, 0x10, 0x10, 0x20, 0x08, 0x40, 0x04, 0x80, 0x02, 0x00, 0x01, 0x00, 0x00, // U+F1927
-	0xA6, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, // U+F1928
-	0x2E, 0x80, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x08, 0x57, 0x13, 0x40, 0x00, 0x19, 0x53, // U+F1929
-	0x27, 0xFE, 0xFF, 0x02, 0x80, 0x33, 0x33, 0x03, // U+F192A
-	0x4C, 0x0E, 0x80, 0x32, 0xC0, 0x42, 0xA0, 0x42, 0x90, 0x82, 0x88, 0x82, 0x8C, // U+F192B
-	0x09, 0x00, 0x08, 0x11, 0x11, 0x01, 0x84, 0x00, 0x8E, 0x00, // U+F192C
-	0x15, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x03, 0xF8, 0x01, 0x07, 0x80, 0x00, 0x40, 0x00, 0x20, 0x00, 0xF0, 0xDF, 0x9B, 0x80, 0xFF, // U+F192D
-	0x0D, 0x80, 0x03, 0x40, 0x04, 0x20, 0x08, 0x05, 0x01, 0x71, 0x10, 0x11, 0x90, 0x13, // U+F192E
-	0x0C, 0xFE, 0x03, 0x00, 0x1C, 0x00, 0x20, 0x00, 0x40, 0x00, 0x80, 0x99, 0x09, // U+F192F
-	0x0D, 0xC0, 0x07, 0x30, 0x19, 0x08, 0x21, 0x04, 0x41, 0x27, 0x10, 0x98, 0xFE, 0xFF, // U+F1930
-	0x4B, 0xF0, 0x01, 0x08, 0x02, 0x04, 0x04, 0x02, 0x78, 0x02, 0x88, 0x09, // U+F1931
-	0x0D, 0x0E, 0x00, 0x10, 0x00, 0x20, 0x1F, 0xC0, 0x20, 0x40, 0x40, 0x20, 0x80, 0xBB, // U+F1932
-	0x0F, 0x80, 0xFF, 0x70, 0x00, 0x08, 0x00, 0x04, 0x07, 0x82, 0x08, 0x42, 0x10, 0x22, 0x20, 0x0D, // U+F1933
-	0x8D, 0xF8, 0x1F, 0x44, 0x60, 0x82, 0x80, 0x82, 0x00, 0x47, 0x04, 0x80, 0x03, 0x00, // U+F1934
-	0x0D, 0x00, 0xF0, 0xE0, 0x13, 0x10, 0x14, 0x08, 0x18, 0x04, 0x10, 0x02, 0x10, 0xBB, // U+F1935
-	0x15, 0x00, 0x10, 0x00, 0x60, 0x0E, 0x80, 0x32, 0xF0, 0x42, 0x0C, 0x42, 0x02, 0x82, 0x02, 0xDD, 0x9B, 0xE7, 0x00, 0x00, 0x00, 0x10, // U+F1936
-	0x0F, 0xC0, 0x07, 0x30, 0x18, 0x08, 0x20, 0x84, 0x42, 0x04, 0x41, 0x82, 0x82, 0x02, 0x80, 0x0D, // U+F1937
-	0x0F, 0x00, 0x01, 0x80, 0x03, 0x01, 0x00, 0x50, 0xE5, 0xFF, 0x2F, 0x00, 0x98, 0x99, 0x99, 0x99, // U+F1938
-	0x0F, 0x38, 0x00, 0x44, 0x0F, 0xC2, 0x30, 0x22, 0x40, 0x47, 0x01, 0x88, 0x81, 0x08, 0xC1, 0x09, // U+F1939
-	0x52, 0x04, 0x40, 0x0A, 0xA0, 0x33, 0x12, 0x90, 0x22, 0x88, 0xC4, 0x47, 0x81, 0x00, 0x02, 0x83, 0x01, 0x7C, 0x00, // U+F193A
-	0x0F, 0x1C, 0x00, 0x22, 0x00, 0xE2, 0x0F, 0x22, 0x30, 0x1C, 0x40, 0x00, 0x40, 0x00, 0x80, 0x0D, // U+F193B
-	0x27, 0xFE, 0xFF, 0x00, 0x00, 0x33, 0x33, 0x01, // U+F193C
-	0x07, 0x20, 0x08, 0x11, 0xE1, 0xFF, 0x1F, 0x11, // U+F193D
-	0x3A, 0xC0, 0x07, 0x30, 0x18, 0x08, 0x20, 0x04, 0x40, 0x84, 0x43, 0x42, 0x84, 0x22, 0x88, 0x22, 0x89, 0x22, 0x86, 0x22, 0x40, 0x42, 0x40, 0x84, 0x31, 0x08, 0x0E, // U+F193E
-	0x4C, 0x00, 0x08, 0x00, 0x04, 0x00, 0x02, 0x00, 0x01, 0x80, 0x00, 0xFE, 0xFF, // U+F193F
-	0x0C, 0x80, 0xFF, 0x70, 0x00, 0x08, 0x00, 0x04, 0x00, 0x02, 0x00, 0x99, 0x09, // U+F1940
-	0x4C, 0x00, 0x04, 0x00, 0x08, 0x00, 0x10, 0x00, 0x20, 0x00, 0x40, 0xFE, 0xFF, // U+F1941
-	0x07, 0xE0, 0x0F, 0x20, 0x08, 0x33, 0x33, 0x33, // U+F1942
-	0x31, 0xFE, 0xFF, 0x00, 0x80, 0x33, 0xE3, 0x7F, 0x08, 0x40, 0x08, 0x20, 0x98, 0x99, 0x00, 0x44, 0x00, 0x38, // U+F1943
-	0xA6, 0x00, 0x70, 0x00, 0x88, 0xFE, 0x89, // U+F1944
-	0x88, 0x1C, 0x1C, 0x22, 0x22, 0x44, 0x44, 0x88, 0x88, // U+F1945
-	0x14, 0x00, 0x02, 0x00, 0x04, 0x03, 0x80, 0x50, 0x55, 0x05, 0xB8, 0x00, 0xC4, 0x00, 0x82, 0xB0, 0x0B, 0x44, 0x00, 0x38, 0x00, // U+F1946
-	0x07, 0xFE, 0xFF, 0x00, 0x84, 0x33, 0x33, 0x33, // U+F1947
-	0x12, 0xFE, 0xFF, 0x02, 0x80, 0x33, 0x23, 0x10, 0x2C, 0x1C, 0x2B, 0x92, 0xA8, 0x71, 0x68, 0x10, 0x38, 0x33, 0x13, // U+F1948
-	0x14, 0x00, 0x10, 0x00, 0x60, 0x00, 0x80, 0x00, 0xF0, 0x38, 0x0C, 0x44, 0x02, 0x82, 0x02, 0xDD, 0x9B, 0x07, 0x00, 0xF0, 0x0F, // U+F1949
-	0x88, 0xC0, 0x07, 0x38, 0x38, 0x04, 0x40, 0x02, 0x80, // U+F194A
-	0x6A, 0x42, 0x08, 0x84, 0x10, 0x08, 0x21, 0x10, 0x42, 0x20, 0x84, // U+F194B
-	0x15, 0x00, 0x10, 0x00, 0x60, 0x10, 0x80, 0x20, 0xF0, 0x40, 0x0C, 0x00, 0x02, 0x8B, 0x23, 0xB0, 0x9B, 0x07, 0x01, 0x00, 0x00, 0x10, // U+F194C
-	0x0B, 0xFE, 0xFF, 0x00, 0x80, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x03, // U+F194D
-	0x10, 0xF0, 0x01, 0x08, 0x02, 0x04, 0x04, 0x02, 0x08, 0x02, 0x10, 0x04, 0x20, 0x08, 0x40, 0x10, 0x80, // U+F194E
-	0x10, 0x00, 0x80, 0x00, 0xE0, 0x00, 0x98, 0x00, 0x86, 0x80, 0x81, 0x60, 0xE0, 0x98, 0x99, 0x06, 0x86, // U+F194F
-	0x66, 0x02, 0x80, 0x11, 0xE1, 0xFF, 0x0F, // U+F1950
-	0x67, 0x20, 0x22, 0x26, 0x22, 0x13, 0xF8, 0xFF, // U+F1951
-	0x0F, 0xF0, 0x1F, 0x00, 0x10, 0x33, 0x33, 0x33, 0x01, 0x00, 0x50, 0x05, 0x08, 0x00, 0x1C, 0x70, // U+F1952
-	0x07, 0xFE, 0xFF, 0x00, 0x80, 0x33, 0x33, 0x33, // U+F1953
-	0x0C, 0x60, 0x00, 0x80, 0x01, 0x00, 0x02, 0x00, 0x04, 0x07, 0x80, 0x90, 0x09, // U+F1954
-	0x2E, 0xFE, 0xFF, 0x02, 0x80, 0x0A, 0x87, 0x92, 0x88, 0x42, 0x92, 0x22, 0xA4, 0x2E, 0xA4, // U+F1955
-	0x06, 0x20, 0x08, 0x11, 0x11, 0x11, 0x01, // U+F1956
-	0x10, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x00, 0x00, 0x40, 0xFE, 0xE3, // U+F1957
-	0x07, 0xFE, 0xFF, 0x02, 0x00, 0x33, 0x31, 0x33, // U+F1958
-	0x53, 0x00, 0x00, 0x18, 0x00, 0x04, 0x00, 0x02, 0x00, 0x02, 0x40, 0x02, 0xE7, 0x82, 0x40, 0x42, 0x00, 0x4F, 0x02, 0x30, // U+F1959
-	0x14, 0x00, 0x80, 0x00, 0x60, 0x00, 0x1C, 0x13, 0x01, 0x80, 0x07, 0x78, 0x70, 0x11, 0xF0, 0x7F, 0x00, 0x00, 0xED, 0xFF, 0x0F, // U+F195A
-	0x07, 0xFE, 0xFF, 0x02, 0x00, 0x33, 0x33, 0x13, // U+F195B
-	0x0F, 0xC0, 0x07, 0x30, 0x18, 0x08, 0x20, 0x04, 0x40, 0x84, 0x43, 0x42, 0x84, 0x22, 0x88, 0x0D, // U+F195C
-	0x09, 0x00, 0x08, 0x11, 0x11, 0x00, 0x00, 0x03, 0x1F, 0x00, // U+F195D
-	0x8D, 0xF0, 0x3F, 0x0C, 0x44, 0x02, 0x82, 0x00, 0x82, 0x07, 0x40, 0x04, 0x80, 0x03, // U+F195E
-	0x0F, 0x02, 0x80, 0x11, 0x11, 0x11, 0xE1, 0xFF, 0x0F, 0x00, 0x50, 0x05, 0x10, 0x00, 0x38, 0x70, // U+F195F
-	0x2A, 0xFE, 0xFF, 0x02, 0x81, 0x82, 0x83, 0x23, 0x00, 0x38, 0x05, // U+F1960
-	0x2B, 0x04, 0x00, 0x08, 0x00, 0xD0, 0xFF, 0x40, 0x80, 0x77, 0x4E, 0x80, // U+F1961
-	0x18, 0x00, 0xFC, 0x00, 0x00, 0x23, 0xC0, 0x2F, 0x00, 0x70, 0x75, 0x32, 0x00, 0x32, 0xFC, 0x02, 0x04, 0x32, 0x04, 0x34, 0x02, 0x08, 0x01, 0xF0, 0x00, // U+F1962
-	0x10, 0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0x01, 0x00, 0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, // U+F1963
-	0x0D, 0x00, 0x01, 0x11, 0x80, 0x03, 0x40, 0x04, 0x20, 0x08, 0x10, 0x10, 0x1E, 0xF0, // U+F1964
-	0x07, 0x20, 0x00, 0x11, 0xE0, 0x0F, 0x11, 0x11, // U+F1965
-	0x0D, 0x80, 0x01, 0x60, 0x00, 0x18, 0x00, 0x13, 0x00, 0x00, 0x00, 0x10, 0x00, 0x38, // U+F1966
-	0x15, 0x00, 0x0F, 0x00, 0x0C, 0x00, 0x0A, 0x00, 0x09, 0x80, 0x00, 0x09, 0x04, 0xB0, 0xBB, 0x99, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, // U+F1967
-	0x87, 0x00, 0x01, 0x11, 0x11, 0xE1, 0xFF, 0x0F, // U+F1968
-	0x1B, 0x00, 0x20, 0x00, 0x58, 0x00, 0x46, 0x80, 0x81, 0x60, 0x80, 0x18, 0x00, 0x06, 0x00, 0x78, 0x00, 0x80, 0x03, 0x00, 0x3C, 0x00, 0xC0, 0x00, 0x80, 0x77, 0x00, 0x00, // U+F1969
-	0x2E, 0x40, 0x20, 0x30, 0x18, 0x08, 0x04, 0x04, 0x02, 0x57, 0x13, 0x80, 0x40, 0x19, 0x53, // U+F196A
-	0x14, 0xC0, 0x07, 0x30, 0x18, 0x08, 0x20, 0x04, 0x40, 0x27, 0x00, 0x98, 0xFA, 0x81, 0x02, 0x81, 0x4D, 0x10, 0x74, 0x35, 0x01, // U+F196B
-	0x2D, 0x04, 0x00, 0x08, 0x1F, 0x90, 0x20, 0x40, 0x40, 0x20, 0x80, 0xE9, 0x02, 0x08, // U+F196C
-	0x10, 0x00, 0xFF, 0x80, 0x80, 0x40, 0x80, 0x20, 0x80, 0x10, 0x80, 0x08, 0x80, 0x04, 0x80, 0x02, 0x80, // U+F196D
-	0x85, 0xFE, 0xFF, 0x00, 0x00, 0x33, // U+F196E
-	0x10, 0x3C, 0x00, 0x42, 0x00, 0x82, 0x00, 0x02, 0x01, 0xC2, 0x3F, 0x24, 0x42, 0x18, 0x84, 0x08, 0x84, // U+F196F
-	0x4B, 0x1C, 0x00, 0x64, 0x00, 0x84, 0x00, 0x45, 0x10, 0x42, 0x10, 0x07, // U+F1970
-	0x10, 0x04, 0x0C, 0x08, 0x30, 0x10, 0x40, 0x20, 0x20, 0x40, 0x10, 0x80, 0x08, 0x00, 0x05, 0x00, 0x02, // U+F1971
-	0x10, 0x20, 0x80, 0x40, 0xE0, 0x80, 0x98, 0x00, 0x87, 0x80, 0x81, 0x60, 0x80, 0x18, 0x80, 0x06, 0x80, // U+F1972
-	0x6E, 0x20, 0x00, 0x10, 0x00, 0x08, 0x00, 0x04, 0x00, 0xFE, 0xFF, 0x00, 0x00, 0xBB, 0x0B, // U+F1973
-	0x56, 0xC0, 0x00, 0xC2, 0xFE, 0x04, 0x02, 0xC8, 0x02, 0xD0, 0x02, 0x20, 0x02, 0x40, 0x02, 0x80, 0x02, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, // U+F1974
-	0x0F, 0x0E, 0x00, 0xF0, 0x01, 0x00, 0x1E, 0x00, 0xE0, 0x00, 0x1C, 0x00, 0x22, 0x00, 0x41, 0x0D, // U+F1975
-	0x0F, 0x02, 0x80, 0x04, 0x40, 0x08, 0x20, 0x10, 0x10, 0x20, 0x08, 0x40, 0x04, 0x00, 0x00, 0x0D, // U+F1976
-	0x0F, 0xE0, 0x0F, 0x18, 0x30, 0x06, 0x40, 0x00, 0x80, 0x07, 0x00, 0x04, 0x00, 0x03, 0xE0, 0x00, // U+F1977
-	0x09, 0x00, 0x01, 0x11, 0x11, 0x00, 0x00, 0xE3, 0x83, 0x0F, // U+F1978
-	0xA6, 0x00, 0xA8, 0x00, 0x70, 0xFE, 0x21, // U+F1979
-	0x15, 0x00, 0x01, 0x11, 0x80, 0x02, 0x33, 0x40, 0x04, 0x05, 0x82, 0x00, 0x01, 0x91, 0x08, 0x20, 0x94, 0x53, 0x64, 0x4C, 0x82, 0x83, // U+F197A
-	0x1E, 0x38, 0x80, 0x44, 0x40, 0x82, 0x20, 0x82, 0x10, 0x82, 0x08, 0x44, 0x04, 0x38, 0x02, 0x00, 0x01, 0x80, 0x38, 0x40, 0x44, 0x20, 0x82, 0x10, 0x82, 0x08, 0x82, 0x04, 0x44, 0x02, 0x38, // U+F197B
-	0x0A, 0xFE, 0xFF, 0x02, 0x80, 0x33, 0xE2, 0x8F, 0x22, 0x88, 0x77, // U+F197C
-	0x15, 0x80, 0x03, 0x60, 0x00, 0x80, 0x00, 0x00, 0x07, 0xE0, 0x00, 0x1C, 0x00, 0xE0, 0x0F, 0x00, 0x70, 0xBD, 0x79, 0x35, 0x80, 0x01, // U+F197D
-	0x2E, 0x08, 0x00, 0x10, 0x00, 0xA0, 0x03, 0x40, 0x04, 0x20, 0x08, 0x10, 0x10, 0x10, 0xF0, // U+F197E
-	0x30, 0x40, 0x20, 0x30, 0x18, 0x08, 0x04, 0x04, 0x02, 0x57, 0xFE, 0xFF, 0x01, 0x08, 0xB4, 0x31, 0x05, // U+F197F
-	0x1D, 0x00, 0x70, 0x00, 0x88, 0x00, 0xF8, 0x03, 0xF8, 0x0F, 0x06, 0x88, 0x01, 0x4B, 0x0C, 0x2C, 0x0C, 0x60, 0x00, 0x8F, 0x0C, 0x00, 0xCD, 0x0F, 0x22, 0x00, 0x14, 0x00, 0x08, 0x00, // U+F1980
-	0x0D, 0xE0, 0x00, 0x10, 0x01, 0x08, 0x02, 0x04, 0x02, 0x04, 0x7E, 0x02, 0x82, 0xBB, // U+F1981
-	0x0A, 0xFE, 0xFF, 0x00, 0x00, 0x33, 0x33, 0x00, 0x01, 0x80, 0x03, // U+F1982
-	0x4C, 0x40, 0x00, 0x20, 0x00, 0x10, 0x00, 0x08, 0x00, 0x04, 0x00, 0xFE, 0xFF, // U+F1983
-	0x3A, 0x04, 0x00, 0x08, 0x9F, 0x90, 0x60, 0x40, 0x60, 0x20, 0x90, 0x20, 0x88, 0x2E, 0x84, 0x20, 0x82, 0x20, 0x81, 0xC0, 0x40, 0xD0, 0x20, 0x28, 0x1F, 0x04, 0x00, // U+F1984
-	0x39, 0x00, 0x1E, 0x38, 0x21, 0xC4, 0x40, 0x82, 0x40, 0x82, 0x20, 0x82, 0x18, 0x44, 0x04, 0x38, 0x02, 0x00, 0x99, 0x01, 0x10, 0x04, 0x20, 0x02, 0xC0, 0x01, // U+F1985
-	0xA6, 0x00, 0xF0, 0x00, 0x08, 0xFE, 0x09, // U+F1986
-	0x87, 0xF8, 0x3F, 0x04, 0x41, 0x02, 0x81, 0x05, // U+F1987
-	0x36, 0xFE, 0xFF, 0x02, 0x80, 0x33, 0x23, 0x1E, 0x28, 0xF3, 0x28, 0x03, 0xAF, 0x04, 0xA8, 0xC4, 0x68, 0xC8, 0x68, 0x08, 0xE8, 0xFF, 0x0F, // U+F1988
+const uint8_t FONT_CODEPAGE_0[] __attribute__((aligned(4))) = {
+	0xA8, 0x76, 0xBE, 0xFC, 0x13, 0x01, 0x20, 0xD9, 0x03, // U+F1900
+	0x4C, 0x80, 0x24, 0x18, 0x49, 0x30, 0xFF, 0x01, 0x25, 0x05, 0x49, 0x32, 0x01, // U+F1901
+	0x08, 0x0E, 0x16, 0x1E, 0x4A, 0x12, 0x26, 0x6A, 0x0A, // U+F1902
+	0x0F, 0x0A, 0x11, 0x06, 0x8E, 0xA5, 0x68, 0x0A, 0x26, 0x43, 0x25, 0x02, 0x50, 0x81, 0x88, 0x02, // U+F1903
+	0x09, 0x00, 0x0F, 0x00, 0x21, 0x00, 0x81, 0xA8, 0xAA, 0x09, // U+F1904
+	0x0A, 0xFC, 0x07, 0x5C, 0x66, 0x66, 0x00, 0x08, 0x01, 0x10, 0x07, // U+F1905
+	0x46, 0x0E, 0x16, 0x1E, 0x4A, 0x12, 0x26, // U+F1906
+	0x0A, 0x56, 0x3A, 0x5A, 0x5E, 0x62, 0x66, 0x46, 0x00, 0xFE, 0x01, // U+F1907
+	0x09, 0x1A, 0x11, 0x61, 0x07, 0xC0, 0x01, 0x70, 0x80, 0x32, // U+F1908
+	0x0C, 0x0E, 0x16, 0x1E, 0x4A, 0x12, 0x26, 0x6A, 0x8E, 0x53, 0x97, 0xDB, 0x0A, // U+F1909
+	0x05, 0x0A, 0x11, 0x11, 0x11, 0x06, // U+F190A
+	0x1C, 0x10, 0x60, 0x40, 0x20, 0x01, 0x21, 0x2C, 0x40, 0x84, 0x80, 0x10, 0x81, 0xFF, 0xC1, 0x02, 0x41, 0x04, 0x44, 0x08, 0x88, 0x10, 0xE0, 0x20, 0x01, 0x84, 0x01, 0x28, 0x04, // U+F190B
+	0x07, 0x2A, 0x4E, 0x1E, 0x16, 0xE7, 0x90, 0x09, // U+F190C
+	0x08, 0x00, 0x18, 0x3C, 0x8D, 0xCC, 0x4E, 0x2C, 0x13, // U+F190D
+	0x08, 0xFC, 0x03, 0x08, 0x04, 0xCC, 0xCC, 0x8C, 0x01, // U+F190E
+	0x09, 0xDE, 0x36, 0x33, 0x33, 0x00, 0x21, 0x00, 0x47, 0x00, // U+F190F
+	0x1F, 0xAA, 0x00, 0x94, 0x30, 0x34, 0x82, 0x44, 0x04, 0x56, 0x06, 0x44, 0x02, 0x56, 0x05, 0xB2, 0x04, 0x42, 0x19, 0x84, 0x55, 0x10, 0x25, 0x41, 0x29, 0x44, 0x22, 0x88, 0x82, 0x0D, 0x02, 0x04, // U+F1910
+	0x0C, 0x1A, 0x42, 0xC0, 0x47, 0x40, 0x50, 0x40, 0x40, 0x40, 0x00, 0xB1, 0x0B, // U+F1911
+	0x4D, 0x80, 0x00, 0x01, 0x01, 0x03, 0x07, 0x05, 0x11, 0x09, 0x41, 0x91, 0x83, 0x23, // U+F1912
+	0x53, 0xA2, 0x70, 0x42, 0x10, 0x03, 0x11, 0x04, 0x3C, 0x82, 0x84, 0x88, 0x08, 0xE1, 0x10, 0x01, 0x20, 0x11, 0x14, 0x00, // U+F1913
+	0x0B, 0x12, 0x26, 0x6A, 0x0A, 0x35, 0xA1, 0x94, 0x99, 0x19, 0x23, 0x02, // U+F1914
+	0x4C, 0x10, 0x0E, 0x40, 0x64, 0x00, 0x09, 0x01, 0x10, 0x22, 0x8E, 0x23, 0x08, // U+F1915
+	0x14, 0x1A, 0x11, 0x00, 0x80, 0x01, 0xF0, 0x88, 0xC0, 0x03, 0xD0, 0x97, 0x54, 0xD7, 0x05, 0x60, 0x04, 0x00, 0x4B, 0x4E, 0x00, // U+F1916
+	0x13, 0xD2, 0x20, 0x02, 0x40, 0x08, 0x54, 0x69, 0x5A, 0x0B, 0x4B, 0xC1, 0x04, 0x40, 0x08, 0x10, 0x81, 0x08, 0x40, 0x19, // U+F1917
+	0x6B, 0x06, 0x0A, 0xA3, 0x56, 0x26, 0x12, 0x30, 0x60, 0x18, 0x00, 0x03, // U+F1918
+	0x13, 0x36, 0x6E, 0x7C, 0x00, 0x89, 0xC0, 0x13, 0x61, 0x20, 0x22, 0xB0, 0xFC, 0x07, 0x76, 0xF3, 0xF8, 0x00, 0x08, 0x04, // U+F1919
+	0x09, 0x2A, 0x4E, 0x1E, 0x16, 0x67, 0x2E, 0xCB, 0x03, 0x10, // U+F191A
+	0x0D, 0x46, 0xD6, 0x9A, 0x20, 0x08, 0x20, 0x20, 0x40, 0x80, 0xF0, 0x80, 0x00, 0x04, // U+F191B
+	0x17, 0x80, 0x61, 0xC0, 0x24, 0x41, 0x30, 0x32, 0x97, 0x3D, 0x0B, 0x02, 0x20, 0x4D, 0x02, 0x08, 0x0B, 0xA0, 0x2D, 0x10, 0x23, 0xC0, 0x49, 0xAA, // U+F191C
+	0x2D, 0x52, 0x20, 0x81, 0x4C, 0x0B, 0x81, 0x04, 0x00, 0x06, 0x81, 0x98, 0xAA, 0x4B, // U+F191D
+	0x10, 0x00, 0x02, 0x01, 0x84, 0x03, 0xC8, 0x04, 0x70, 0xA8, 0x0B, 0x2C, 0x10, 0x46, 0x20, 0x83, 0x40, // U+F191E
+	0x0F, 0xAE, 0x00, 0x88, 0x00, 0x08, 0x16, 0x1C, 0x41, 0x44, 0x44, 0x04, 0x71, 0x08, 0x02, 0x00, // U+F191F
+	0x6E, 0x52, 0x5E, 0xE6, 0x08, 0x04, 0x11, 0x06, 0x21, 0x80, 0x81, 0xE0, 0x60, 0x29, 0x00, // U+F1920
+	0xA5, 0x0E, 0x16, 0x1E, 0x4E, 0x2A, // U+F1921
+	0x0A, 0x0A, 0x11, 0x11, 0x11, 0x21, 0x62, 0x22, 0x71, 0x57, 0x03, // U+F1922
+	0x11, 0x60, 0x00, 0x20, 0x01, 0x20, 0x04, 0x44, 0x08, 0x0C, 0x11, 0x14, 0x24, 0x24, 0x30, 0x44, 0xC0, 0x8F, // U+F1923
+	0x0F, 0x2A, 0xE0, 0x30, 0x20, 0x81, 0x20, 0x02, 0x22, 0x04, 0x98, 0x99, 0x57, 0x13, 0x66, 0xBB, // U+F1924
+	0x28, 0x06, 0x04, 0x20, 0x66, 0x66, 0x08, 0xC0, 0x03, // U+F1925
+	0x0B, 0x0A, 0x8A, 0xA6, 0x20, 0x22, 0x80, 0x24, 0x00, 0x2A, 0x10, 0x09, // U+F1926
+	0x69, 0x0E, 0x16, 0x1E, 0x4A, 0x12, 0x26, 0x6A, 0x0A, 0x02, // U+F1927
+	0xA3, 0x0A, 0x2E, 0x3E, // U+F1928
+	0x29, 0x46, 0x9E, 0x3E, 0x32, 0x57, 0x13, 0x66, 0x19, 0x53, // U+F1929
+	0x25, 0x06, 0x0E, 0x33, 0x33, 0x03, // U+F192A
+	0x4D, 0x1C, 0x00, 0xC9, 0x00, 0x13, 0x02, 0x25, 0x04, 0x49, 0x10, 0x91, 0x20, 0x23, // U+F192B
+	0x08, 0x32, 0x11, 0x11, 0x01, 0x08, 0x01, 0x38, 0x02, // U+F192C
+	0x0F, 0x00, 0x30, 0xDC, 0x34, 0x06, 0xE0, 0x87, 0xB3, 0x96, 0x8E, 0xD5, 0x7F, 0x6F, 0x0A, 0x03, // U+F192D
+	0x0A, 0x22, 0x26, 0x12, 0xA5, 0x74, 0x20, 0x22, 0x40, 0x4E, 0x00, // U+F192E
+	0x08, 0xFC, 0x07, 0x04, 0xE5, 0x84, 0x34, 0x32, 0x13, // U+F192F
+	0x09, 0x2A, 0x60, 0x32, 0x4C, 0x15, 0xCF, 0x31, 0x0D, 0x00, // U+F1930
+	0x4A, 0x96, 0x10, 0x04, 0x10, 0x10, 0x10, 0xC0, 0x23, 0x80, 0x98, // U+F1931
+	0x0B, 0xC6, 0x5E, 0x40, 0x3E, 0x00, 0x83, 0x00, 0x02, 0xB2, 0xDD, 0x05, // U+F1932
+	0x0C, 0xC2, 0xCE, 0x5A, 0x08, 0x0E, 0x08, 0x22, 0x10, 0x82, 0x20, 0x02, 0xD2, // U+F1933
+	0x8D, 0xF0, 0x3F, 0x10, 0x81, 0x11, 0x04, 0x24, 0x08, 0x70, 0x88, 0x00, 0x94, 0x01, // U+F1934
+	0x0E, 0x00, 0xE0, 0x81, 0x4F, 0x80, 0xA0, 0x80, 0x80, 0x81, 0x00, 0x82, 0x00, 0xC4, 0x2E, // U+F1935
+	0x12, 0x36, 0x6E, 0x1C, 0x00, 0xC9, 0xC0, 0x13, 0x62, 0x20, 0x24, 0x40, 0x50, 0xA0, 0x7B, 0xF3, 0x8C, 0x05, 0x02, // U+F1936
+	0x0A, 0x2A, 0x4E, 0x1E, 0x08, 0x85, 0x14, 0x09, 0x0A, 0x3A, 0x34, // U+F1937
+	0x0A, 0x0A, 0x22, 0x21, 0x50, 0x65, 0xE0, 0x90, 0x99, 0x99, 0x99, // U+F1938
+	0x0F, 0xCA, 0x88, 0x1E, 0x08, 0xC3, 0x10, 0x01, 0x3A, 0x14, 0x80, 0x30, 0x10, 0x41, 0x70, 0x02, // U+F1939
+	0x4D, 0x16, 0x14, 0x40, 0x67, 0x48, 0x40, 0xBA, 0x23, 0x3E, 0x0A, 0x0F, 0x27, 0x15, // U+F193A
+	0x0C, 0xFE, 0x44, 0x00, 0x88, 0x3F, 0x10, 0x81, 0xC1, 0x01, 0x24, 0xA4, 0xD1, // U+F193B
+	0x25, 0x06, 0x02, 0x33, 0x33, 0x01, // U+F193C
+	0x05, 0x12, 0x11, 0x61, 0x10, 0x11, // U+F193D
+	0x36, 0x2A, 0x4E, 0x1E, 0x16, 0x08, 0x87, 0x08, 0x11, 0xBA, 0x13, 0x49, 0x24, 0x62, 0x48, 0x04, 0x88, 0x10, 0x10, 0xC2, 0x18, 0x08, 0x0E, // U+F193E
+	0x46, 0x32, 0x3E, 0x2E, 0x0A, 0x46, 0x06, // U+F193F
+	0x07, 0xC2, 0xCE, 0x5A, 0x3A, 0x56, 0x99, 0x09, // U+F1940
+	0x46, 0x3E, 0x32, 0x36, 0x72, 0x42, 0x06, // U+F1941
+	0x05, 0xDA, 0x12, 0x33, 0x33, 0x33, // U+F1942
+	0x2F, 0x06, 0x1A, 0x33, 0xC3, 0xFF, 0x10, 0x00, 0x21, 0x00, 0xC1, 0xCC, 0x04, 0x40, 0xE4, 0x0A, // U+F1943
+	0xA5, 0x76, 0xBE, 0xFC, 0x13, 0x01, // U+F1944
+	0x89, 0x38, 0x38, 0x88, 0x88, 0x20, 0x22, 0x82, 0x88, 0x08, // U+F1945
+	0x0E, 0x2E, 0x3E, 0x23, 0x53, 0x55, 0x05, 0x70, 0x01, 0x10, 0x83, 0xC4, 0xAE, 0x89, 0x08, // U+F1946
+	0x07, 0x06, 0x00, 0x08, 0x67, 0x66, 0x66, 0x00, // U+F1947
+	0x11, 0x06, 0x0E, 0x33, 0x43, 0x20, 0x98, 0x70, 0x2C, 0x91, 0x44, 0x1A, 0x87, 0x0C, 0x02, 0x67, 0x66, 0x02, // U+F1948
+	0x10, 0x36, 0x6E, 0x1A, 0x00, 0xE0, 0xE1, 0x30, 0x20, 0x12, 0x20, 0x28, 0xD0, 0xBD, 0x79, 0x02, 0xFF, // U+F1949
+	0x86, 0x2A, 0x70, 0x70, 0x2C, 0x1C, 0x00, // U+F194A
+	0x6A, 0x84, 0x10, 0x10, 0x42, 0x98, 0x82, 0x10, 0x02, 0x42, 0x08, // U+F194B
+	0x10, 0x36, 0x6E, 0xB2, 0x40, 0xE0, 0x01, 0x31, 0xB8, 0x2C, 0x1C, 0x81, 0xDD, 0x3C, 0x2F, 0x81, 0x00, // U+F194C
+	0x09, 0x06, 0x1A, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x03, // U+F194D
+	0x0F, 0x96, 0x10, 0x04, 0x10, 0x10, 0x10, 0x40, 0x20, 0x00, 0x81, 0x00, 0x04, 0x02, 0x90, 0x2C, // U+F194E
+	0x0E, 0x1A, 0xF2, 0x00, 0x30, 0x01, 0x18, 0xEA, 0x02, 0x03, 0x87, 0x99, 0xC9, 0xC0, 0x10, // U+F194F
+	0x64, 0x0E, 0x11, 0x61, 0x00, // U+F1950
+	0x68, 0x40, 0x44, 0x98, 0x88, 0x4C, 0xC0, 0xFF, 0x07, // U+F1951
+	0x0C, 0xDE, 0x36, 0x33, 0x33, 0x33, 0x21, 0x50, 0x65, 0x04, 0x38, 0xE0, 0x00, // U+F1952
+	0x05, 0x06, 0x1A, 0x33, 0x33, 0x33, // U+F1953
+	0x07, 0x52, 0x7A, 0x2E, 0x3E, 0x27, 0x93, 0x09, // U+F1954
+	0x2D, 0x06, 0x0E, 0x14, 0x0E, 0x49, 0x22, 0x12, 0x92, 0x24, 0x42, 0xCA, 0x85, 0x14, // U+F1955
+	0x05, 0x12, 0x11, 0x11, 0x11, 0x01, // U+F1956
+	0x0D, 0x18, 0x00, 0xC0, 0x00, 0x00, 0x06, 0xF0, 0xF4, 0x11, 0x10, 0xE2, 0x3F, 0x0E, // U+F1957
+	0x05, 0x06, 0x56, 0x33, 0x31, 0x33, // U+F1958
+	0x50, 0x02, 0x92, 0x3A, 0x56, 0x04, 0x80, 0x08, 0x9C, 0x13, 0x04, 0x22, 0x04, 0xF0, 0x48, 0x00, 0x06, // U+F1959
+	0x0F, 0x1A, 0x6E, 0x82, 0x13, 0x01, 0x00, 0x0F, 0xE0, 0xC1, 0x45, 0x80, 0xFF, 0x13, 0x68, 0x03, // U+F195A
+	0x05, 0x06, 0x56, 0x33, 0x33, 0x13, // U+F195B
+	0x0A, 0x2A, 0x4E, 0x1E, 0x16, 0x08, 0x87, 0x08, 0x11, 0xBA, 0x37, // U+F195C
+	0x06, 0x32, 0x11, 0x11, 0x02, 0x63, 0x09, // U+F195D
+	0x8D, 0xE0, 0x7F, 0x30, 0x10, 0x11, 0x10, 0x04, 0x20, 0x78, 0x00, 0x88, 0x5C, 0x01, // U+F195E
+	0x0A, 0x0E, 0x11, 0x11, 0x11, 0x61, 0x20, 0x50, 0xA5, 0x20, 0x72, // U+F195F
+	0x27, 0x06, 0x8E, 0x04, 0x07, 0xC7, 0x61, 0x0A, // U+F1960
+	0x2A, 0x3A, 0x5A, 0xA0, 0xFF, 0x01, 0x01, 0xDE, 0x71, 0x02, 0x04, // U+F1961
+	0x18, 0x00, 0xF8, 0x05, 0x86, 0x00, 0xBF, 0xD5, 0xD5, 0x91, 0x01, 0x20, 0xC3, 0x4F, 0x80, 0x80, 0x0C, 0x01, 0x1A, 0x01, 0x08, 0x01, 0xE0, 0x01, 0x00, // U+F1962
+	0x0B, 0xFA, 0x92, 0x52, 0x7A, 0x00, 0x0C, 0x00, 0x60, 0xB8, 0x69, 0x00, // U+F1963
+	0x09, 0x0A, 0x11, 0x22, 0x26, 0x12, 0x4A, 0x3C, 0xE0, 0x01, // U+F1964
+	0x05, 0x62, 0x11, 0xDA, 0x11, 0x11, // U+F1965
+	0x07, 0x7A, 0x52, 0x92, 0x13, 0x02, 0x36, 0xAE, // U+F1966
+	0x11, 0x00, 0x1E, 0x00, 0x30, 0x00, 0x50, 0x00, 0x90, 0x60, 0x94, 0x66, 0xBB, 0x9B, 0xA9, 0xE0, 0xE2, 0x03, // U+F1967
+	0x85, 0x0A, 0x11, 0x11, 0x61, 0x00, // U+F1968
+	0x14, 0x72, 0x00, 0xB0, 0x00, 0x18, 0xE9, 0xAA, 0x4B, 0xEA, 0xC3, 0x03, 0x10, 0x01, 0xC0, 0x03, 0x00, 0x58, 0xE3, 0x4E, 0x00, // U+F1969
+	0x2D, 0x80, 0x40, 0x9C, 0x20, 0x10, 0xF8, 0x5D, 0x4D, 0x00, 0x04, 0xCA, 0x98, 0x02, // U+F196A
+	0x0D, 0x2A, 0x4E, 0x1E, 0x16, 0xE7, 0x90, 0xF4, 0x03, 0x1D, 0x5B, 0xF1, 0x6A, 0x02, // U+F196B
+	0x2B, 0x3A, 0x10, 0x3E, 0x40, 0x82, 0x00, 0x02, 0xB2, 0x4D, 0x2E, 0x80, // U+F196C
+	0x0D, 0x00, 0xFE, 0x01, 0x02, 0x02, 0x02, 0xB4, 0x95, 0x35, 0x47, 0x00, 0xE8, 0x00, // U+F196D
+	0x83, 0x06, 0x02, 0x33, // U+F196E
+	0x11, 0x78, 0x00, 0x08, 0x01, 0x10, 0x04, 0x20, 0x10, 0x40, 0xF8, 0x07, 0x89, 0x10, 0x0C, 0x42, 0x08, 0x84, // U+F196F
+	0x4A, 0xFE, 0xC8, 0x00, 0x10, 0x02, 0x14, 0x82, 0x10, 0x04, 0x71, // U+F1970
+	0x10, 0x08, 0x18, 0x20, 0xC0, 0x80, 0x00, 0x02, 0x02, 0x02, 0x08, 0x02, 0x20, 0x02, 0x80, 0x02, 0x17, // U+F1971
+	0x0E, 0xB6, 0x80, 0xC0, 0x01, 0x62, 0x02, 0x38, 0xD4, 0x55, 0x87, 0x01, 0xC8, 0x00, 0x10, // U+F1972
+	0x68, 0x62, 0x5E, 0x5A, 0x3A, 0x06, 0x02, 0xBB, 0x0B, // U+F1973
+	0x51, 0x80, 0x01, 0x08, 0xFB, 0xFB, 0x41, 0x16, 0x00, 0x2D, 0xA0, 0x09, 0x48, 0x40, 0xCD, 0xD3, 0x45, 0x00, // U+F1974
+	0x09, 0xC6, 0x96, 0xA2, 0xF2, 0x82, 0x00, 0x44, 0xC4, 0x1B, // U+F1975
+	0x08, 0x0E, 0x16, 0x1E, 0x4A, 0x12, 0x26, 0x02, 0x0D, // U+F1976
+	0x0B, 0xDA, 0x30, 0x60, 0x18, 0x00, 0x69, 0x9C, 0x90, 0x2A, 0x00, 0x07, // U+F1977
+	0x07, 0x0A, 0x11, 0x11, 0x02, 0xC3, 0x07, 0x1F, // U+F1978
+	0xA6, 0x00, 0x50, 0xED, 0xF8, 0x87, 0x00, // U+F1979
+	0x10, 0x0A, 0x11, 0x6A, 0x33, 0x26, 0x25, 0xA1, 0x94, 0x1E, 0x28, 0xA7, 0x90, 0x31, 0x11, 0x1C, 0x04, // U+F197A
+	0x1F, 0x70, 0x00, 0x11, 0x01, 0x11, 0x04, 0x21, 0x08, 0x41, 0x10, 0x01, 0x11, 0x01, 0x1C, 0x01, 0x05, 0x80, 0x38, 0x80, 0x88, 0x80, 0x08, 0x82, 0x10, 0x84, 0x20, 0x88, 0x80, 0x88, 0x00, 0x0E, // U+F197B
+	0x08, 0x06, 0x0E, 0x33, 0xC4, 0x1F, 0xDD, 0xEF, 0x00, // U+F197C
+	0x0E, 0x22, 0x52, 0x46, 0x00, 0x0E, 0xA4, 0xFD, 0xB5, 0xED, 0x7A, 0xF3, 0x6A, 0xF4, 0x00, // U+F197D
+	0x2A, 0x5A, 0x5E, 0x40, 0x07, 0x4C, 0x24, 0x94, 0x40, 0xC0, 0x03, // U+F197E
+	0x2D, 0x80, 0x40, 0x9C, 0x20, 0x10, 0xF8, 0x5D, 0x19, 0x04, 0x40, 0xA0, 0x8D, 0x29, // U+F197F
+	0x16, 0x76, 0xBE, 0xF6, 0x23, 0xAC, 0x0E, 0x03, 0x16, 0x31, 0x30, 0x61, 0x00, 0x06, 0xF0, 0x90, 0x01, 0x40, 0xF3, 0x6B, 0x5A, 0x1B, 0x01, // U+F1980
+	0x0C, 0xD2, 0x20, 0x02, 0x20, 0x08, 0xF8, 0x21, 0xF0, 0x23, 0x20, 0xB8, 0x0B, // U+F1981
+	0x06, 0x06, 0x02, 0x33, 0x33, 0x0A, 0x22, // U+F1982
+	0x46, 0x66, 0x62, 0x5E, 0x5A, 0x3A, 0x06, // U+F1983
+	0x3A, 0x3A, 0x10, 0x3E, 0x41, 0x82, 0x01, 0x02, 0x03, 0x02, 0x09, 0x04, 0x91, 0x0B, 0x21, 0x10, 0x41, 0x20, 0x81, 0x80, 0x81, 0x40, 0x83, 0x40, 0xF9, 0xD0, 0x01, // U+F1984
+	0x37, 0xA2, 0x70, 0x42, 0x10, 0x03, 0x11, 0x04, 0x22, 0x08, 0x42, 0x10, 0x03, 0x11, 0x01, 0x1C, 0x01, 0x00, 0x99, 0x21, 0x0E, 0x40, 0x44, 0x10, // U+F1985
+	0xA6, 0x00, 0xE0, 0x65, 0xF8, 0x27, 0x00, // U+F1986
+	0x85, 0xF0, 0x7F, 0x14, 0x1D, 0x0B, // U+F1987
+	0x34, 0x06, 0x0E, 0x33, 0x43, 0x3C, 0x90, 0xCC, 0x23, 0x19, 0x78, 0x4A, 0x80, 0x94, 0x18, 0x19, 0x32, 0x32, 0x04, 0x34, 0x00, // U+F1988
 	0x00, // U+F1989
 	0x00, // U+F198A
 	0x00, // U+F198B
@@ -685,8 +1075,8 @@ const uint8_t FONT_CODEPAGE_0[] = {
 	0x00, // U+F198D
 	0x00, // U+F198E
 	0x00, // U+F198F
-	0x88, 0xF8, 0x3F, 0x04, 0x40, 0x02, 0x80, 0x55, 0x55, // U+F1990
-	0x88, 0x02, 0x80, 0x11, 0x11, 0x04, 0x40, 0xF8, 0x7F, // U+F1991
+	0x87, 0xF0, 0x7F, 0x2C, 0x1C, 0xAA, 0xAA, 0x00, // U+F1990
+	0x87, 0x0E, 0x11, 0x11, 0x16, 0xF0, 0xFF, 0x00, // U+F1991
 	0x00, // U+F1992
 	0x00, // U+F1993
 	0x00, // U+F1994
@@ -697,67 +1087,82 @@ const uint8_t FONT_CODEPAGE_0[] = {
 	0x00, // U+F1999
 	0x00, // U+F199A
 	0x00, // U+F199B
-	0xC4, 0x00, 0x01, 0x80, 0x03, // U+F199C
-	0xC4, 0x20, 0x08, 0x70, 0x1C, // U+F199D
+	0xC2, 0x0A, 0x22, // U+F199C
+	0xC2, 0x12, 0x86, // U+F199D
 	0x00, // U+F199E
 	0x00, // U+F199F
-	0x07, 0x02, 0x00, 0x11, 0x11, 0x11, 0xFE, 0xFF, // U+F19A0
-	0x0F, 0x38, 0x04, 0x44, 0x04, 0x82, 0x02, 0x25, 0x98, 0x43, 0x54, 0x84, 0x2B, 0x08, 0x28, 0x08, // U+F19A1
-	0x09, 0x20, 0x00, 0x11, 0x11, 0x00, 0x00, 0x03, 0xF0, 0x01, // U+F19A2
-	0x09, 0x00, 0x10, 0x11, 0x11, 0x01, 0x14, 0x01, 0x08, 0x01, // U+F19A3
+	0x05, 0x56, 0x11, 0x11, 0x11, 0x06, // U+F19A0
+	0x10, 0x70, 0x08, 0x10, 0x11, 0x10, 0x14, 0x28, 0x82, 0x39, 0x88, 0x8A, 0xE0, 0x0A, 0x02, 0x14, 0x04, // U+F19A1
+	0x07, 0x62, 0x11, 0x11, 0x02, 0x03, 0xE0, 0x03, // U+F19A2
+	0x08, 0x36, 0x11, 0x11, 0x01, 0x28, 0x02, 0x20, 0x04, // U+F19A3
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Padding. See lookup_decompress_image()
 };
-const uint8_t FONT_CODEPAGE_1[] = {
-	0x0F, 0x00, 0x02, 0x00, 0x07, 0x80, 0x0A, 0x40, 0x12, 0x11, 0x11, 0x11, 0x11, 0x11, 0xE0, 0x03, // U+FFFF0000
-	0xA3, 0x00, 0x01, 0x11, // U+FFFF0001
-	0xA5, 0x0E, 0x00, 0x00, 0x00, 0x03, // U+FFFF0002
-	0x06, 0x00, 0x80, 0x11, 0x11, 0x11, 0x01, // U+FFFF0003
-	0x48, 0x00, 0x08, 0x00, 0x1C, 0x01, 0x00, 0x10, 0x03, // U+FFFF0004
-	0x6F, 0x20, 0x08, 0x70, 0x1C, 0x01, 0x00, 0x50, 0x02, 0x80, 0x04, 0x40, 0x08, 0x20, 0xF0, 0x1F, // U+FFFF0005
-	0x6F, 0x20, 0x08, 0x70, 0x1C, 0x01, 0x00, 0x50, 0xF0, 0x1F, 0x08, 0x20, 0x04, 0x40, 0x02, 0x80, // U+FFFF0006
-	0x6B, 0x20, 0x08, 0x70, 0x1C, 0x01, 0x00, 0x50, 0x55, 0xFE, 0xFF, 0x05, // U+FFFF0007
-	0x50, 0x20, 0x08, 0x70, 0x1C, 0x01, 0x00, 0x00, 0x06, 0x00, 0x18, 0x00, 0x60, 0x00, 0x80, 0xB1, 0x79, // U+FFFF0008
-	0x55, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x20, 0x40, 0x42, 0x40, 0x4C, 0x40, 0x70, 0x09, 0x34, 0x04, 0x0C, 0x02, 0xF3, 0xC1, 0x00, 0x00, // U+FFFF0009
-	0x15, 0x00, 0x00, 0x04, 0x00, 0x08, 0x1F, 0x90, 0x22, 0x40, 0x42, 0x20, 0x82, 0xEB, 0x22, 0xB8, 0x9B, 0x57, 0x04, 0x02, 0x00, 0x02, // U+FFFF000A
-	0x4C, 0x00, 0x80, 0x70, 0xC0, 0xA8, 0xA0, 0x24, 0x91, 0x22, 0x8A, 0xFE, 0x8F, // U+FFFF000B
-	0x1E, 0x00, 0x10, 0x00, 0x28, 0x3E, 0x28, 0xC4, 0x24, 0x08, 0x75, 0x08, 0x82, 0x10, 0x42, 0x08, 0x20, 0x44, 0x18, 0x42, 0x20, 0xC4, 0x20, 0x24, 0x41, 0x28, 0x5A, 0x10, 0xE4, 0x10, 0x04, // U+FFFF000C
-	0x37, 0xFE, 0xFF, 0x22, 0x04, 0x72, 0x02, 0x22, 0x02, 0x02, 0x02, 0x23, 0x87, 0x2F, 0x02, 0x21, 0x00, 0x22, 0x02, 0x22, 0x07, 0xD2, 0xFE, 0xFF, // U+FFFF000D
-	0x10, 0x00, 0x80, 0x00, 0xE0, 0x00, 0x98, 0x00, 0x86, 0x80, 0x91, 0x60, 0xA8, 0x18, 0x91, 0x86, 0x82, // U+FFFF000E
-	0x15, 0x02, 0x00, 0x02, 0x80, 0xFE, 0xFF, 0x02, 0x82, 0x02, 0x02, 0x99, 0x99, 0x49, 0x20, 0xB0, 0x08, 0x01, 0x90, 0x00, 0x60, 0x00, // U+FFFF000F
-	0x56, 0x00, 0x80, 0x04, 0xC1, 0x8A, 0xA2, 0x8A, 0x92, 0x72, 0x8A, 0x02, 0x8E, 0x04, 0x8B, 0x04, 0x91, 0x88, 0xA0, 0x70, 0xC0, 0x00, 0x80, // U+FFFF0010
-	0x69, 0x00, 0x38, 0x00, 0x40, 0x00, 0x80, 0xE3, 0x9F, 0x03, // U+FFFF0011
-	0xAA, 0x00, 0x80, 0x00, 0x40, 0x00, 0x20, 0x00, 0x10, 0x00, 0x08, // U+FFFF0012
+const uint16_t FONT_CODEPAGE_0_CHECKPOINT[] = {0x0000U, 0x0056U, 0x00B4U, 0x0145U, 0x01C4U, 0x0225U, 0x0274U, 0x02DDU, 0x033DU, 0x0389U, 0x03F8U, 0x0443U, 0x049BU, 0x04FDU, 0x0564U, 0x05C9U, 0x063AU, 0x06ACU, 0x06C8U, 0x06DEU, 0x06EAU};
+const uint8_t FONT_CODEPAGE_1[] __attribute__((aligned(4))) = {
+	0x0F, 0x2E, 0x00, 0x0E, 0x00, 0x2A, 0x00, 0x92, 0x88, 0x88, 0x88, 0x88, 0x88, 0x00, 0x3E, 0x00, // U+FFFF0000
+	0xA2, 0x0A, 0x11, // U+FFFF0001
+	0xA3, 0xC6, 0x02, 0x03, // U+FFFF0002
+	0x05, 0x1A, 0x11, 0x11, 0x11, 0x01, // U+FFFF0003
+	0x45, 0x32, 0x82, 0x21, 0x10, 0x03, // U+FFFF0004
+	0x68, 0x12, 0x86, 0x21, 0x50, 0x0E, 0x16, 0x1E, 0xDE, // U+FFFF0005
+	0x68, 0x12, 0x86, 0x21, 0x50, 0xDE, 0x1E, 0x16, 0x0E, // U+FFFF0006
+	0x67, 0x12, 0x86, 0x21, 0x50, 0x55, 0x06, 0x05, // U+FFFF0007
+	0x4C, 0x12, 0x86, 0x21, 0x20, 0xA5, 0x07, 0xC0, 0x00, 0x00, 0xC6, 0xE6, 0x01, // U+FFFF0008
+	0x55, 0x02, 0x00, 0x3E, 0x00, 0x82, 0x00, 0x12, 0x02, 0xC4, 0x04, 0x08, 0x2E, 0x01, 0x0D, 0x01, 0x06, 0x01, 0xF3, 0x81, 0x01, 0x00, // U+FFFF0009
+	0x12, 0x02, 0x3A, 0x10, 0x3E, 0x40, 0x8A, 0x00, 0x12, 0x02, 0x22, 0xB8, 0x5C, 0x04, 0x77, 0xF3, 0xCA, 0xCF, 0x05, // U+FFFF000A
+	0x4C, 0x1A, 0xE0, 0x80, 0xA1, 0x82, 0x22, 0x89, 0x24, 0xA2, 0xC8, 0xFF, 0x11, // U+FFFF000B
+	0x1E, 0x36, 0x00, 0x50, 0xF8, 0xA0, 0x20, 0x26, 0x81, 0x50, 0x07, 0x41, 0x10, 0x84, 0x90, 0x07, 0x22, 0x0C, 0x42, 0x20, 0x88, 0x41, 0x90, 0x04, 0x41, 0xD1, 0x02, 0x41, 0x0E, 0x82, 0x00, // U+FFFF000C
+	0x37, 0x06, 0x44, 0x08, 0xC8, 0x09, 0x10, 0x11, 0x20, 0x20, 0x30, 0xE4, 0xF0, 0x89, 0x40, 0x10, 0x00, 0x21, 0x02, 0x42, 0x0E, 0xA4, 0x0D, 0x00, // U+FFFF000D
+	0x0F, 0x1A, 0xF2, 0x00, 0x30, 0x01, 0x18, 0x02, 0x8C, 0x04, 0x86, 0x0A, 0x23, 0x92, 0xA1, 0x20, // U+FFFF000E
+	0x11, 0x56, 0x0E, 0x06, 0x04, 0x04, 0x09, 0x08, 0x64, 0x66, 0xA6, 0xDF, 0x42, 0x08, 0x00, 0x09, 0x20, 0x05, // U+FFFF000F
+	0x56, 0x1A, 0x08, 0x82, 0x29, 0x8A, 0x52, 0x94, 0x24, 0xA7, 0x48, 0xC0, 0x11, 0xC1, 0x22, 0x82, 0x48, 0x88, 0xA0, 0xE0, 0x80, 0x35, 0x00, // U+FFFF0010
+	0x66, 0xAE, 0x42, 0x1A, 0xC3, 0x3F, 0x07, // U+FFFF0011
+	0xA5, 0x1A, 0x42, 0x72, 0x36, 0x32, // U+FFFF0012
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Padding. See lookup_decompress_image()
 };
-const uint8_t FONT_CODEPAGE_2[] = {
-	0x06, 0xFE, 0xFF, 0x11, 0x11, 0x11, 0x01, // U+FFFF1000
-	0x1A, 0x00, 0x01, 0x00, 0xFA, 0x00, 0x88, 0x80, 0x89, 0xC5, 0xA3, 0x2F, 0x15, 0x20, 0x01, 0xC0, 0x10, 0x04, 0x20, 0x02, 0x40, 0x01, 0x80, 0x30, 0x01, 0x10, 0x04, // U+FFFF1001
-	0x37, 0x00, 0x70, 0x80, 0x8B, 0x00, 0x88, 0x00, 0x48, 0xE0, 0xF8, 0x10, 0x01, 0x16, 0x01, 0x90, 0x00, 0xF0, 0x71, 0x55, 0x80, 0x4B, 0x00, 0xF8, // U+FFFF1002
+const uint16_t FONT_CODEPAGE_1_CHECKPOINT[] = {0x0000U, 0x003DU, 0x00D9U};
+const uint8_t FONT_CODEPAGE_2[] __attribute__((aligned(4))) = {
+	0x05, 0x06, 0x11, 0x11, 0x11, 0x01, // U+FFFF1000
+	0x17, 0x0A, 0x00, 0xF4, 0x7D, 0x01, 0x26, 0x16, 0x1E, 0x7D, 0x52, 0x01, 0x24, 0x00, 0x30, 0x04, 0x01, 0x10, 0x01, 0x40, 0x21, 0x33, 0x21, 0x0E, // U+FFFF1001
+	0x35, 0x76, 0x00, 0x17, 0x7D, 0x01, 0x20, 0x01, 0xC7, 0x07, 0x11, 0xC0, 0x22, 0x00, 0x24, 0x00, 0xF8, 0xB8, 0x2A, 0x80, 0x4B, 0xF6, // U+FFFF1002
+	0x00, 0x00, 0x00, 0x00, // Padding. See lookup_decompress_image()
 };
-const uint8_t FONT_CODEPAGE_3[] = {
-	0x6C, 0x00, 0x00, 0x04, 0x40, 0x33, 0x83, 0x00, 0x52, 0x30, 0x18, 0xC0, 0x07, // U+FFFF2000
-	0x25, 0x00, 0x01, 0x11, 0x11, 0x11, // U+FFFF2001
-	0xA5, 0x80, 0x03, 0xC0, 0x07, 0x03, // U+FFFF2002
-	0x50, 0x00, 0x01, 0x80, 0x02, 0x40, 0x04, 0x20, 0x08, 0x01, 0x20, 0x00, 0x40, 0x00, 0x80, 0xB0, 0x19, // U+FFFF2003
-	0x2A, 0x00, 0x1E, 0x80, 0x01, 0x40, 0x00, 0x05, 0x02, 0x70, 0x07, // U+FFFF2004
-	0x87, 0xFC, 0x7F, 0x04, 0x40, 0x33, 0x33, 0x03, // U+FFFF2005
-	0x33, 0x00, 0x10, 0x00, 0x20, 0x80, 0x7F, 0x60, 0x00, 0x10, 0x00, 0x08, 0x00, 0x04, 0x00, 0xDD, 0xBD, 0x70, 0x00, 0x05, // U+FFFF2006
-	0xE2, 0xFC, 0x7F, // U+FFFF2007
-	0x2B, 0x80, 0x03, 0x60, 0x0C, 0x10, 0x10, 0x08, 0x20, 0x47, 0x00, 0x94, // U+FFFF2008
-	0x50, 0x00, 0x01, 0x80, 0x00, 0x40, 0x00, 0x20, 0x00, 0x35, 0x01, 0x41, 0x00, 0x22, 0x00, 0x14, 0x30, // U+FFFF2009
-	0x0C, 0xE0, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x08, 0x07, 0x00, 0x91, 0x09, // U+FFFF200A
-	0x87, 0x04, 0x40, 0x11, 0x11, 0xC1, 0xFF, 0x07, // U+FFFF200B
-	0xC4, 0x20, 0x08, 0x70, 0x1C, // U+FFFF200C
-	0x27, 0xF0, 0x7F, 0x00, 0x40, 0x33, 0x33, 0x03, // U+FFFF200D
-	0x0C, 0x00, 0x01, 0x11, 0x00, 0x00, 0x03, 0x7C, 0x00, 0x44, 0xE0, 0x44, 0x0E, // U+FFFF200E
-	0x2D, 0x80, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x04, 0x00, 0x00, 0x09, 0x3C, 0x00, // U+FFFF200F
-	0xAA, 0x00, 0x40, 0x00, 0x20, 0x00, 0x10, 0x00, 0x08, 0x00, 0x04, // U+FFFF2010
-	0x2E, 0x00, 0xE0, 0x00, 0xF8, 0x00, 0x1E, 0x80, 0x07, 0xE0, 0x07, 0x78, 0x06, 0x1C, 0x06, // U+FFFF2011
-	0x0E, 0x00, 0x00, 0xE0, 0x3D, 0x33, 0x03, 0xDF, 0x57, 0x51, 0x85, 0xDF, 0x7F, 0x77, 0x07, // U+FFFF2012
-	0x1A, 0x00, 0x00, 0x00, 0x60, 0x00, 0x9E, 0x80, 0x9F, 0xF0, 0xA3, 0xA8, 0x61, 0x9C, 0xE0, 0xCD, 0x0A, 0x8E, 0x1F, 0x0F, 0xFF, 0x77, 0x05, 0x80, 0x0B, 0x00, 0x04, // U+FFFF2013
-	0x18, 0x00, 0x00, 0x80, 0x0F, 0xC0, 0x3F, 0xC0, 0x7F, 0xC0, 0xFF, 0x09, 0xF9, 0x8F, 0xF9, 0xC7, 0xF9, 0xC7, 0xFC, 0x9F, 0x79, 0x80, 0x3F, 0x00, 0x0F, // U+FFFF2014
-	0x69, 0x00, 0x30, 0x01, 0x00, 0x30, 0x33, 0x03, 0x0C, 0x53, // U+FFFF2015
-	0x28, 0xFC, 0xFF, 0x04, 0x80, 0x03, 0x00, 0x50, 0x55, // U+FFFF2016
-	0x6C, 0x00, 0x02, 0x00, 0x07, 0x01, 0x00, 0x50, 0x05, 0x04, 0x01, 0x8E, 0x73, // U+FFFF2017
-	0x2A, 0xF0, 0x3F, 0x08, 0x40, 0x04, 0x80, 0x55, 0x00, 0x00, 0x07, // U+FFFF2018
-	0x68, 0x00, 0x30, 0x01, 0x00, 0x30, 0x33, 0x33, 0x03, // U+FFFF2019
-	0x68, 0xC0, 0x30, 0x01, 0x00, 0x30, 0x33, 0x33, 0x03, // U+FFFF201A
+const uint16_t FONT_CODEPAGE_2_CHECKPOINT[] = {0x0000U};
+const uint8_t FONT_CODEPAGE_3[] __attribute__((aligned(4))) = {
+	0x67, 0x02, 0x16, 0x33, 0xE3, 0x51, 0x4E, 0x2A, // U+FFFF2000
+	0x24, 0x0A, 0x11, 0x11, 0x11, // U+FFFF2001
+	0xA3, 0x22, 0x2A, 0x03, // U+FFFF2002
+	0x49, 0x0A, 0x6A, 0x26, 0x12, 0xE1, 0xE2, 0x23, 0xB3, 0x19, // U+FFFF2003
+	0x26, 0xA2, 0x7A, 0x66, 0x25, 0x76, 0x07, // U+FFFF2004
+	0x86, 0xF8, 0xFF, 0x2C, 0x66, 0x66, 0x06, // U+FFFF2005
+	0x2C, 0x36, 0x72, 0x00, 0xFF, 0xA4, 0xBC, 0xB4, 0x74, 0xBA, 0x7B, 0x9D, 0x0B, // U+FFFF2006
+	0xE3, 0xF8, 0xFF, 0x00, // U+FFFF2007
+	0x28, 0x22, 0xC0, 0x18, 0x94, 0x3C, 0xCE, 0x22, 0x01, // U+FFFF2008
+	0x4B, 0x0A, 0x46, 0x66, 0x62, 0x35, 0x01, 0x82, 0x40, 0xD3, 0x7A, 0x00, // U+FFFF2009
+	0x07, 0xD2, 0x9E, 0x3E, 0x32, 0x67, 0x93, 0x09, // U+FFFF200A
+	0x86, 0x16, 0x11, 0x11, 0x81, 0xFF, 0x0F, // U+FFFF200B
+	0xC2, 0x12, 0x86, // U+FFFF200C
+	0x26, 0xE0, 0xFF, 0x84, 0x66, 0x66, 0x06, // U+FFFF200D
+	0x08, 0x0A, 0x11, 0x02, 0xA3, 0x62, 0xC2, 0x89, 0x1C, // U+FFFF200E
+	0x28, 0x46, 0x0A, 0x2E, 0x3E, 0x02, 0x09, 0x78, 0x00, // U+FFFF200F
+	0xA5, 0x42, 0x72, 0x36, 0x32, 0x3E, // U+FFFF2010
+	0x2C, 0xF2, 0xF6, 0xA2, 0x00, 0x0F, 0x80, 0x1F, 0xC0, 0x33, 0xC0, 0x61, 0x00, // U+FFFF2011
+	0x0D, 0x02, 0xC0, 0x7B, 0x66, 0x06, 0x7C, 0x5F, 0x45, 0x15, 0xFC, 0xFE, 0xBB, 0x3B, // U+FFFF2012
+	0x18, 0x02, 0x6E, 0x00, 0x3C, 0x01, 0x7E, 0x82, 0x1F, 0x85, 0x1A, 0x86, 0x13, 0xBC, 0xB1, 0x82, 0xC3, 0x8F, 0x07, 0xFF, 0x77, 0x05, 0x00, 0x57, 0x08, // U+FFFF2013
+	0x19, 0x02, 0x00, 0x1F, 0x00, 0xFF, 0x00, 0xFE, 0x03, 0xFC, 0x9F, 0x20, 0xFF, 0x61, 0xFE, 0xE1, 0xFC, 0xC3, 0xFC, 0x9F, 0x79, 0x00, 0x7F, 0x00, 0x3C, 0x00, // U+FFFF2014
+	0x68, 0xAA, 0x21, 0x30, 0x33, 0x03, 0x18, 0xA6, 0x00, // U+FFFF2015
+	0x28, 0xF8, 0xFF, 0x11, 0x00, 0x8E, 0x40, 0x55, 0x01, // U+FFFF2016
+	0x6B, 0x2E, 0x00, 0x0E, 0x42, 0xA0, 0x0A, 0x10, 0x04, 0x70, 0x9C, 0x03, // U+FFFF2017
+	0x29, 0xE0, 0x7F, 0x20, 0x00, 0x21, 0x00, 0xAC, 0x12, 0x38, // U+FFFF2018
+	0x66, 0xAA, 0x21, 0x30, 0x33, 0x33, 0x03, // U+FFFF2019
+	0x67, 0x80, 0x61, 0x42, 0x60, 0x66, 0x66, 0x06, // U+FFFF201A
+	0x2E, 0xF0, 0x7F, 0x30, 0x80, 0x59, 0x20, 0x3E, 0x42, 0xD6, 0x84, 0x24, 0x09, 0xFD, 0x17, // U+FFFF201B
+	0x30, 0xDA, 0x4A, 0x20, 0x28, 0x40, 0x20, 0x00, 0xBF, 0x10, 0xD8, 0xF5, 0x96, 0x01, 0x60, 0xF0, 0x0D, // U+FFFF201C
+	0x33, 0xC0, 0x3F, 0x40, 0x04, 0xCC, 0x84, 0x40, 0x15, 0x08, 0x0C, 0x10, 0x16, 0x20, 0x22, 0x40, 0x43, 0x80, 0x81, 0x00, // U+FFFF201D
+	0x35, 0xDA, 0x4A, 0x20, 0x28, 0x40, 0x20, 0x00, 0xBF, 0x10, 0xD8, 0x05, 0x81, 0x01, 0xC2, 0x02, 0x44, 0x04, 0x68, 0x08, 0x30, 0x10, // U+FFFF201E
+	0x31, 0xDA, 0x4A, 0x33, 0x12, 0x02, 0x77, 0x20, 0x30, 0x40, 0x58, 0x80, 0x88, 0x00, 0x0D, 0x01, 0x06, 0x02, // U+FFFF201F
+	0x2C, 0xDE, 0x4A, 0x33, 0xDA, 0x02, 0x77, 0x96, 0x00, 0x1C, 0x6C, 0x36, 0x01, // U+FFFF2020
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Padding. See lookup_decompress_image()
 };
+const uint16_t FONT_CODEPAGE_3_CHECKPOINT[] = {0x0000U, 0x003AU, 0x007AU, 0x00ECU, 0x0161U};
+// Flash cost of the FONT_CODEPAGE_*_CHECKPOINT: 60 bytes
@@ -60,12 +60,16 @@ struct ilonena_config {
 	// extra_trailing_space for output_mode=KEYBOARD_OUTPUT_MODE_LATIN, sitelen_pona else.
 	// unable to make a union for that because it's a bitfield.
 	uint8_t sitelen_pona_punctuation_or_extra_trailing_space:1;
-	uint16_t padding:12; // Pad to 16bits
+	// Send out the glyph as soon as the input sequence is complete and no longer input sequence starts with it, without waiting for ALA. Ignored without LOOKUP_INCREMENTAL
+	uint8_t eager_commit:1;
+	// Keyboard layout of the host, for typing the ASCII characters in the main rows of keys
+	enum keyboard_layout keyboard_layout:3;
+	uint16_t padding:8; // Pad to 16bits
 } __attribute__((packed));
 
 static_assert(sizeof(struct ilonena_config) == 2, "Size of struct ilonena_config must be 2 bytes so that it could be stored into the optoin bytes.");
 
-static struct ilonena_config ilonena_config = {.output_mode=KEYBOARD_OUTPUT_MODE_LATIN, .sitelen_pona_punctuation_or_extra_trailing_space=0};
+static struct ilonena_config ilonena_config = {.output_mode=KEYBOARD_OUTPUT_MODE_LATIN, .sitelen_pona_punctuation_or_extra_trailing_space=0, .eager_commit=0, .keyboard_layout=KEYBOARD_LAYOUT_QWERTY};
 static struct ilonena_config ilonena_config_prev;
 
 // Each sitelen pona glyph can be typed by a certain input sequence. This input buffer stores that sequence
@@ -74,113 +78,114 @@ static uint8_t input_buffer[LOOKUP_INPUT_LENGTH_MAX] = {0};
 #define INPUT_BUFFER_SIZE (sizeof(input_buffer)/sizeof(*input_buffer))
 
 static size_t input_buffer_index = 0;
+#if LOOKUP_INCREMENTAL
+// Trie node reached after typing each key of the input buffer. input_trie_nodes[input_buffer_index] is the current one.
+// Typing a key pushes a node, removing a key pops it. The first one is always LOOKUP_TRIE_ROOT.
+static uint16_t input_trie_nodes[LOOKUP_INPUT_LENGTH_MAX+1] = {LOOKUP_TRIE_ROOT};
+#endif
 static uint32_t codepoint_found = 0;
 static uint8_t codepoint_not_found = 0; // for blinking in case the codepoint isn't found
 static uint32_t codepoint_not_found_blink_start_tick = 0; // for determining when to stop blinking
 static uint8_t persistent_config = 1; // 1 if the config scene would save to optbyte permanently. 0 if config won't be persist after reboot
 static uint32_t config_error_code = 0; // The error code to be displayed in case the config failed to get saved into the option bytes
+static uint8_t config_show_layout = 0; // 1 if the second row of the config scene shows the keyboard layout instead of the punctuation mode
 
 void refresh_display(void) {
-	static uint16_t image[LOOKUP_IMAGE_WIDTH+1] = {0}; // The +1 here is for showing image with DISPLAY_DRAW_FLAG_INVERT, which has an extra column
+	// Images drawn with a width of LOOKUP_IMAGE_WIDTH+1 have a blank extra column. It's for showing image with DISPLAY_DRAW_FLAG_INVERT
 	display_clear();
 
 	switch(ilonena_mode) {
 		case ILONENA_MODE_TITLE_SCREEN:
-			lookup_get_image(image, 0xF190E); // ILO in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 0, 1, DISPLAY_DRAW_FLAG_SCALE_2x);
-			lookup_get_image(image, 0xF1940); // NENA in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 1*32+8, 1, DISPLAY_DRAW_FLAG_SCALE_2x);
-
-			lookup_get_image(image, 0xF193D); // NANPA in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 6*16, 16, 0);
-			lookup_get_image(image, LOOKUP_CODEPAGE_0_START+FIRMWARE_REVISION);
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 7*16, 16, 0);
+			display_draw_glyph(0xF190E, LOOKUP_IMAGE_WIDTH, 0, 1, DISPLAY_DRAW_FLAG_SCALE_2x); // ILO in UCSUR, code page 0.
+			display_draw_glyph(0xF1940, LOOKUP_IMAGE_WIDTH, 1*32+8, 1, DISPLAY_DRAW_FLAG_SCALE_2x); // NENA in UCSUR, code page 0.
+
+			display_draw_glyph(0xF193D, LOOKUP_IMAGE_WIDTH, 6*16, 16, 0); // NANPA in UCSUR, code page 0.
+			display_draw_glyph(LOOKUP_CODEPAGE_0_START+FIRMWARE_REVISION, LOOKUP_IMAGE_WIDTH, 7*16, 16, 0);
 		break;
 		case ILONENA_MODE_INPUT:
+		{
 			// Blit the input buffer
 			for(size_t i=0; i<input_buffer_index; i++) {
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+input_buffer[i]-1);
 				if(i<6) {
-					display_draw_16(image, LOOKUP_IMAGE_WIDTH, i*16, 0, 0);
+					display_draw_glyph(LOOKUP_CODEPAGE_3_START+input_buffer[i]-1, LOOKUP_IMAGE_WIDTH, i*16, 0, 0);
 				} else {
-					display_draw_16(image, LOOKUP_IMAGE_WIDTH, (i-6)*16, 16, 0);
+					display_draw_glyph(LOOKUP_CODEPAGE_3_START+input_buffer[i]-1, LOOKUP_IMAGE_WIDTH, (i-6)*16, 16, 0);
 				}
 			}
 
 			// Bilt the graphic to be output'd
-			lookup_get_image(image, codepoint_found);
 			// Drawing with LOOKUP_IMAGE_WIDTH+1 for making the inverted output square
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 98, 1, (codepoint_not_found ? DISPLAY_DRAW_FLAG_INVERT : 0) | DISPLAY_DRAW_FLAG_SCALE_2x);
+			// Inverted while no input sequence could be completed from the current input buffer. Blinks back if ALA/PANA is pressed anyway.
+#if LOOKUP_INCREMENTAL
+			uint8_t dead_end = (input_trie_nodes[input_buffer_index] == LOOKUP_TRIE_DEAD_END);
+#else
+			uint8_t dead_end = 0; // Only known with the trie
+#endif
+			display_draw_glyph(codepoint_found, LOOKUP_IMAGE_WIDTH+1, 98, 1, ((codepoint_not_found ^ dead_end) ? DISPLAY_DRAW_FLAG_INVERT : 0) | DISPLAY_DRAW_FLAG_SCALE_2x);
+
+			// Pending output: a bar on the left of the glyph, 2 pixels tall per codepoint that hasn't been typed out yet
+			display_draw_column((1U << keyboard_get_pending_count()) - 1, 96, 0, DISPLAY_DRAW_FLAG_SCALE_2x);
+		}
 		break;
 		case ILONENA_MODE_CONFIG:
 			// Drawing with LOOKUP_IMAGE_WIDTH+1 for making the inverted border visible
 
-			// Display config of output mode selection (Latin, Windows, Linux, Macos)
-			lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_1);
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 0*16, 0, 0);
-			lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_LATIN);
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+1*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LATIN ? DISPLAY_DRAW_FLAG_INVERT : 0);
-			lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_WINDOWS);
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+2*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_WINDOWS ? DISPLAY_DRAW_FLAG_INVERT : 0);
-			lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_LINUX);
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+3*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LINUX ? DISPLAY_DRAW_FLAG_INVERT : 0);
-			lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_MAC);
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+4*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_MACOS ? DISPLAY_DRAW_FLAG_INVERT : 0);
-
+			// Display config of output mode selection (Latin, Windows, Linux, Macos, Compose)
+			display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_1, LOOKUP_IMAGE_WIDTH+1, 0*16, 0, 0);
+			display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_LATIN, LOOKUP_IMAGE_WIDTH+1, 1*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LATIN ? DISPLAY_DRAW_FLAG_INVERT : 0);
+			display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_WINDOWS, LOOKUP_IMAGE_WIDTH+1, 2*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_WINDOWS ? DISPLAY_DRAW_FLAG_INVERT : 0);
+			display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_LINUX, LOOKUP_IMAGE_WIDTH+1, 3*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LINUX ? DISPLAY_DRAW_FLAG_INVERT : 0);
+			display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_MAC, LOOKUP_IMAGE_WIDTH+1, 4*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_MACOS ? DISPLAY_DRAW_FLAG_INVERT : 0);
+#if KEYBOARD_COMPOSE_MODE
+			display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_COMPOSE, LOOKUP_IMAGE_WIDTH+1, 5*16, 0, ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_COMPOSE ? DISPLAY_DRAW_FLAG_INVERT : 0);
+#endif
+
+			// Display config of keyboard layout selection (QWERTY, AZERTY, QWERTZ, Czech QWERTZ, Dvorak) in place of punctuation mode
+			if(KEYBOARD_HOST_LAYOUTS && config_show_layout) {
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_W, LOOKUP_IMAGE_WIDTH+1, 0*16, 16, 0);
+				for(size_t i=0; i<KEYBOARD_LAYOUT_END; i++) {
+					display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_LAYOUT_QWERTY+i, LOOKUP_IMAGE_WIDTH+1, (i+1)*16, 16, ilonena_config.keyboard_layout == i ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				}
 			// Display config of punctuation mode selection
-			if(ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LATIN) {
+			} else if(ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LATIN) {
 				// With extra trailing space, or without
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_Q);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 0*16, 16, 0);
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_TRAILING_SPACE_PART1);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+1*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_TRAILING_SPACE_PART2);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+2*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_PART1);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+3*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
-				lookup_get_image(image, 0); // Empty glyph
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+4*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_Q, LOOKUP_IMAGE_WIDTH+1, 0*16, 16, 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_TRAILING_SPACE_PART1, LOOKUP_IMAGE_WIDTH+1, 4+1*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_TRAILING_SPACE_PART2, LOOKUP_IMAGE_WIDTH+1, 4+2*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_PART1, LOOKUP_IMAGE_WIDTH+1, 4+3*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(0, LOOKUP_IMAGE_WIDTH+1, 4+4*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0); // Empty glyph
 			} else {
 				// With sitelen pona punctuation, or with ASCII punctuation
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_Q);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 0*16, 16, 0);
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_SITELEN_PONA_PART1);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+1*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_SITELEN_PONA_PART2);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+2*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_PART1);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+3*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
-				lookup_get_image(image, LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_PART2);
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH+1, 4+4*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_Q, LOOKUP_IMAGE_WIDTH+1, 0*16, 16, 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_SITELEN_PONA_PART1, LOOKUP_IMAGE_WIDTH+1, 4+1*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_SITELEN_PONA_PART2, LOOKUP_IMAGE_WIDTH+1, 4+2*16, 16, ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_PART1, LOOKUP_IMAGE_WIDTH+1, 4+3*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
+				display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_PUNCTUATION_LATIN_PART2, LOOKUP_IMAGE_WIDTH+1, 4+4*16, 16, !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space ? DISPLAY_DRAW_FLAG_INVERT : 0);
 			}
 
-			lookup_get_image(image, 0xF1976); // WEKA in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 6*16, 16, 0);
-			lookup_get_image(image, 0xF194C); // PANA in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 7*16, 16, 0);
+#if LOOKUP_INCREMENTAL
+			// Display config of eager commit. The E key, inverted if it's enabled.
+			display_draw_glyph(LOOKUP_CODEPAGE_3_START+INTERNAL_IMAGE_E, LOOKUP_IMAGE_WIDTH+1, 6*16, 0, ilonena_config.eager_commit ? DISPLAY_DRAW_FLAG_INVERT : 0);
+#endif
+
+			display_draw_glyph(0xF1976, LOOKUP_IMAGE_WIDTH, 6*16, 16, 0); // WEKA in UCSUR, code page 0.
+			display_draw_glyph(0xF194C, LOOKUP_IMAGE_WIDTH, 7*16, 16, 0); // PANA in UCSUR, code page 0.
 
 			// Draw AWEN on top-right corner if we're in persistent_config mode
 			if(persistent_config) {
-				lookup_get_image(image, 0xF1908); // AWEN in UCSUR, code page 0.
-				display_draw_16(image, LOOKUP_IMAGE_WIDTH, 7*16, 0, 0);
+				display_draw_glyph(0xF1908, LOOKUP_IMAGE_WIDTH, 7*16, 0, 0); // AWEN in UCSUR, code page 0.
 			}
 		break;
 		case ILONENA_MODE_INPUT_TIMEOUT:
-			lookup_get_image(image, 0xF196B); // TENPO in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 1*32-4, 1, DISPLAY_DRAW_FLAG_SCALE_2x);
-			lookup_get_image(image, 0xF1922); // LAPE in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 2*32+4, 1, DISPLAY_DRAW_FLAG_SCALE_2x);
+			display_draw_glyph(0xF196B, LOOKUP_IMAGE_WIDTH, 1*32-4, 1, DISPLAY_DRAW_FLAG_SCALE_2x); // TENPO in UCSUR, code page 0.
+			display_draw_glyph(0xF1922, LOOKUP_IMAGE_WIDTH, 2*32+4, 1, DISPLAY_DRAW_FLAG_SCALE_2x); // LAPE in UCSUR, code page 0.
 		break;
 		case ILONENA_MODE_OPTBYTE_ERROR_SCREEN:
-			lookup_get_image(image, 0xF1948); // PAKALA in UCSUR, code page 0
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 0*32, 0, DISPLAY_DRAW_FLAG_SCALE_2x);
-			lookup_get_image(image, 0xF1900); // PAKALA in UCSUR, code page 0
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 1*32, 0, DISPLAY_DRAW_FLAG_SCALE_2x);
-
-			lookup_get_image(image, 0xF193D); // NANPA in UCSUR, code page 0.
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 6*16, 16, 0);
-			lookup_get_image(image, LOOKUP_CODEPAGE_0_START+config_error_code); // error code in UCSUR
-			display_draw_16(image, LOOKUP_IMAGE_WIDTH, 7*16, 16, 0);
+			display_draw_glyph(0xF1948, LOOKUP_IMAGE_WIDTH, 0*32, 0, DISPLAY_DRAW_FLAG_SCALE_2x); // PAKALA in UCSUR, code page 0
+			display_draw_glyph(0xF1900, LOOKUP_IMAGE_WIDTH, 1*32, 0, DISPLAY_DRAW_FLAG_SCALE_2x); // PAKALA in UCSUR, code page 0
+
+			display_draw_glyph(0xF193D, LOOKUP_IMAGE_WIDTH, 6*16, 16, 0); // NANPA in UCSUR, code page 0.
+			display_draw_glyph(LOOKUP_CODEPAGE_0_START+config_error_code, LOOKUP_IMAGE_WIDTH, 7*16, 16, 0); // error code in UCSUR
 		break;
 	}
 
@@ -193,6 +198,40 @@ void clear_input_buffer(void) {
 	codepoint_found = 0;
 }
 
+// Update codepoint_found after a key is added to or removed from the input buffer.
+// With LOOKUP_INCREMENTAL, the full lookup is only done if the trie says that the input sequence is complete. It's not
+// any faster than lookup_search() alone (see bench_lookup). The trie is there for the dead end and the eager commit.
+void update_codepoint_found(void) {
+#if LOOKUP_INCREMENTAL
+	codepoint_found = lookup_trie_is_terminal(input_trie_nodes[input_buffer_index]) ? lookup_search(input_buffer, input_buffer_index) : 0;
+#else
+	codepoint_found = lookup_search(input_buffer, input_buffer_index);
+#endif
+}
+
+// Type-ahead of the key presses, in the order they came in. They're held back here while the keyboard output is busy.
+#define KEY_QUEUE_LENGTH (16U)
+static uint8_t key_queue[KEY_QUEUE_LENGTH]; // enum ilonena_key_id
+static size_t key_queue_write_index = 0;
+static size_t key_queue_read_index = 0;
+
+void key_queue_push(enum ilonena_key_id key_id) {
+	if((key_queue_write_index+1)%KEY_QUEUE_LENGTH == key_queue_read_index) {
+		return; // Overflow. Let's ignore the extra input being supplied!
+	}
+	key_queue[key_queue_write_index] = key_id;
+	key_queue_write_index = (key_queue_write_index+1)%KEY_QUEUE_LENGTH;
+}
+
+// Returns 1 if processing the key might write something to the keyboard
+uint8_t key_might_write(enum ilonena_key_id key_id) {
+	if(ilonena_mode != ILONENA_MODE_INPUT && ilonena_mode != ILONENA_MODE_TITLE_SCREEN) {
+		return 0;
+	}
+	// With eager commit, any key could complete a glyph
+	return key_id == ILONENA_KEY_ALA || key_id == ILONENA_KEY_PANA || key_id == ILONENA_KEY_WEKA || (LOOKUP_INCREMENTAL && ilonena_config.eager_commit);
+}
+
 int main() {
 	// Kickoff the watchdog as early as possible
 	watchdog_init();
@@ -210,6 +249,11 @@ int main() {
 	// Load settings from option bytes
 	uint16_t optbyte_data = optionbytes_get_data();
 	memcpy(&ilonena_config, &optbyte_data, sizeof(ilonena_config));
+	if(!KEYBOARD_COMPOSE_MODE && ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_COMPOSE) {
+		// Saved by a firmware with the compose mode
+		ilonena_config.output_mode = KEYBOARD_OUTPUT_MODE_LATIN;
+	}
+	keyboard_set_layout(ilonena_config.keyboard_layout);
 
 	uint32_t systick_now = SysTick->CNT;
 	uint8_t display_refresh_required = 1; // Set it to 1 for showing the title screen
@@ -222,6 +266,8 @@ int main() {
 	uint32_t last_input_tick = systick_now;
 	uint32_t seconds_elapsed_since_last_input = 0;
 
+	size_t keyboard_pending_count = 0; // For showing the pending output
+
 	watchdog_feed();
 
 	while(1) {
@@ -229,165 +275,207 @@ int main() {
 		uint32_t button_press_event = button_get_pressed_event();
 		for(size_t i=0; i<20; i++) {
 			if(button_press_event & (1U << i)) {
-				enum ilonena_key_id key_id = i+1;
-				reprocess_key:
-				switch(ilonena_mode) {
-					case ILONENA_MODE_TITLE_SCREEN:
-						if(key_id == ILONENA_KEY_WEKA) {
-							// Reset timeout if WEKA key is pressed.
-							// That's because holding WEKA key would enter persistent_config mode
-							// If we switched to ILONENA_MODE_INPUT like standard button handling, then
-							// the user would be unable to enter persistent_config mode
-							title_screen_timeout_start_counting_tick = systick_now;
-						} else {
-							ilonena_mode = ILONENA_MODE_INPUT;
-							// Required for keys like PANA or ALA, which doesn't update the screen in ILONENA_MODE_INPUT
-							display_refresh_required = 1;
-							goto reprocess_key;
-						}
-					break;
-					case ILONENA_MODE_INPUT:
-						switch(key_id) {
-							case ILONENA_KEY_ALA:
-							case ILONENA_KEY_PANA:
-								// ALA (space) or PANA (enter) has been pressed! Let's handle it!
-								if(input_buffer_index == 0) {
-									// If the input buffer is empty, send out either ENTER or SPACE
-									if(key_id == ILONENA_KEY_PANA) {
-										keyboard_write_codepoint(ilonena_config.output_mode, '\n');
-									} else {
-										keyboard_write_codepoint(ilonena_config.output_mode, ' ');
-									}
+				key_queue_push(i+1);
+			}
+		}
+		// keyboard_write_codepoint() never blocks. While there isn't enough room for writing anything, the key that
+		// might write something is held back in key_queue together with the ones after it. The main loop keeps running meanwhile.
+		while(key_queue_read_index != key_queue_write_index) {
+			enum ilonena_key_id key_id = key_queue[key_queue_read_index];
+			if(key_might_write(key_id) && !keyboard_is_writable()) {
+				break;
+			}
+			key_queue_read_index = (key_queue_read_index+1)%KEY_QUEUE_LENGTH;
+			reprocess_key:
+			switch(ilonena_mode) {
+				case ILONENA_MODE_TITLE_SCREEN:
+					if(key_id == ILONENA_KEY_WEKA) {
+						// Reset timeout if WEKA key is pressed.
+						// That's because holding WEKA key would enter persistent_config mode
+						// If we switched to ILONENA_MODE_INPUT like standard button handling, then
+						// the user would be unable to enter persistent_config mode
+						title_screen_timeout_start_counting_tick = systick_now;
+					} else {
+						ilonena_mode = ILONENA_MODE_INPUT;
+						// Required for keys like PANA or ALA, which doesn't update the screen in ILONENA_MODE_INPUT
+						display_refresh_required = 1;
+						goto reprocess_key;
+					}
+				break;
+				case ILONENA_MODE_INPUT:
+					switch(key_id) {
+						case ILONENA_KEY_ALA:
+						case ILONENA_KEY_PANA:
+							// ALA (space) or PANA (enter) has been pressed! Let's handle it!
+							if(input_buffer_index == 0) {
+								// If the input buffer is empty, send out either ENTER or SPACE
+								if(key_id == ILONENA_KEY_PANA) {
+									keyboard_write_codepoint(ilonena_config.output_mode, '\n');
 								} else {
-									// Input buffer has content on it.
-									// Search the lookup table, then send out the key according to the input buffer's content
-									uint32_t codepoint = lookup_search(input_buffer, input_buffer_index);
-									if(codepoint > 0) {
-										if(ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LATIN) {
-											if(ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space) {
-												// Force send trailing space for symbols like comma, dash, period, etc.
-												// This is useful when you're not using a sitelen pona font.
-												// Example: "mi pilin e ni : tenpo ni la , ona li moli . "
-												keyboard_write_codepoint(KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE, codepoint);
-											} else {
-												// Do not force sending trailing space for symbols.
-												// It looks more compact than the former option when you're using a sitelen pona font that
-												// comes with autmoatic conversion between ASCII and sitelen pona glyphs (font ligature).
-												// However, it looks terrible if displayed in ASCII
-												// Example: "mi pilin e ni :tenpo ni la ,ona li moli ."
-												keyboard_write_codepoint(KEYBOARD_OUTPUT_MODE_LATIN, codepoint);
-											}
+									keyboard_write_codepoint(ilonena_config.output_mode, ' ');
+								}
+							} else {
+								// Input buffer has content on it.
+								// Search the lookup table, then send out the key according to the input buffer's content
+								uint32_t codepoint = codepoint_found; // It's always up-to-date with the input buffer
+								if(codepoint > 0) {
+									if(ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LATIN) {
+										if(ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space) {
+											// Force send trailing space for symbols like comma, dash, period, etc.
+											// This is useful when you're not using a sitelen pona font.
+											// Example: "mi pilin e ni : tenpo ni la , ona li moli . "
+											keyboard_write_codepoint(KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE, codepoint);
 										} else {
-											if(!ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space) {
-												// Using ASCII punctuations instead of sitelen pona punctuations
-												switch(codepoint) {
-													case 0xF1990: codepoint = '['; break;
-													case 0xF1991: codepoint = ']'; break;
-													case 0xF199C: codepoint = '.'; break;
-													case 0xF199D: codepoint = ':'; break;
-													default: break; // No conversion required for other codepoints
-												}
-											}
-											// Write out the sitelen pona glyph in Windows/Linux/Mac mode
-											// (by sending out WinCompose/CTRL+SHIFT+U/HexInputMethod Unicode sequence)
-											keyboard_write_codepoint(ilonena_config.output_mode, codepoint);
+											// Do not force sending trailing space for symbols.
+											// It looks more compact than the former option when you're using a sitelen pona font that
+											// comes with autmoatic conversion between ASCII and sitelen pona glyphs (font ligature).
+											// However, it looks terrible if displayed in ASCII
+											// Example: "mi pilin e ni :tenpo ni la ,ona li moli ."
+											keyboard_write_codepoint(KEYBOARD_OUTPUT_MODE_LATIN, codepoint);
 										}
-										if(key_id == ILONENA_KEY_PANA) {
-											// Send a trailing enter if the enter key had been pressed
-											if(ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LINUX) {
-												// For linux, there's a bug in ibus that if we type out the enter immediately,
-												// sometimes the glyph would be typed twice.
-												// It happens more often when the CPU is straved or on low-end computer.
-												// This delay (slightly longer than 3*30ms) is a workaround of the ibus bug.
-												keyboard_write_codepoint(KEYBOARD_OUTPUT_MODE_DELAY, 30);
+									} else {
+										if(!ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space) {
+											// Using ASCII punctuations instead of sitelen pona punctuations
+											switch(codepoint) {
+												case 0xF1990: codepoint = '['; break;
+												case 0xF1991: codepoint = ']'; break;
+												case 0xF199C: codepoint = '.'; break;
+												case 0xF199D: codepoint = ':'; break;
+												default: break; // No conversion required for other codepoints
 											}
-											keyboard_write_codepoint(ilonena_config.output_mode, '\n');
 										}
-										// The input buffer is sent to the computer. Time to clear it and update display.
-										clear_input_buffer();
-										display_refresh_required = 1;
-									} else {
-										// Show visual feedback that the glyph hasn't been found.
-										codepoint_not_found = 1;
-										codepoint_not_found_blink_start_tick = systick_now;
-										display_refresh_required = 1;
+										// Write out the sitelen pona glyph in Windows/Linux/Mac/Compose mode
+										// (by sending out WinCompose/CTRL+SHIFT+U/HexInputMethod Unicode sequence, or the compose sequence)
+										keyboard_write_codepoint(ilonena_config.output_mode, codepoint);
 									}
-								}
-							break;
-							case ILONENA_KEY_WEKA:
-								if(input_buffer_index == 0) {
-									// Send backspace if the input buffer's empty
-									keyboard_write_codepoint(ilonena_config.output_mode, '\b');
-								} else {
-									// Remove a character from the input buffer
-									codepoint_not_found = 0;
-									input_buffer[input_buffer_index--] = 0;
-									codepoint_found = lookup_search(input_buffer, input_buffer_index);
-									display_refresh_required = 1;
-								}
-							break;
-							default:
-								if(input_buffer_index < INPUT_BUFFER_SIZE) {
-									// Append a character to the input buffer
-									codepoint_not_found = 0;
-									input_buffer[input_buffer_index++] = key_id;
-									codepoint_found = lookup_search(input_buffer, input_buffer_index);
+									if(key_id == ILONENA_KEY_PANA) {
+										// Send a trailing enter if the enter key had been pressed
+										if(ilonena_config.output_mode == KEYBOARD_OUTPUT_MODE_LINUX) {
+											// For linux, there's a bug in ibus that if we type out the enter immediately,
+											// sometimes the glyph would be typed twice.
+											// It happens more often when the CPU is straved or on low-end computer.
+											// This delay (slightly longer than 3*30ms) is a workaround of the ibus bug.
+											keyboard_write_codepoint(KEYBOARD_OUTPUT_MODE_DELAY, 30);
+										}
+										keyboard_write_codepoint(ilonena_config.output_mode, '\n');
+									}
+									// The input buffer is sent to the computer. Time to clear it and update display.
+									clear_input_buffer();
 									display_refresh_required = 1;
 								} else {
-									// Input buffer overflow. Let's ignore the extra input being supplied! :P
-								}
-							break;
-						}
-					break;
-					case ILONENA_MODE_CONFIG:
-						switch(key_id) {
-							case ILONENA_KEY_1:
-								// Cycle thru the avaialble output_mode
-								if(++ilonena_config.output_mode >= KEYBOARD_OUTPUT_MODE_END) {
-									ilonena_config.output_mode = 0;
+									// Show visual feedback that the glyph hasn't been found.
+									codepoint_not_found = 1;
+									codepoint_not_found_blink_start_tick = systick_now;
+									display_refresh_required = 1;
 								}
+							}
+						break;
+						case ILONENA_KEY_WEKA:
+							if(input_buffer_index == 0) {
+								// Send backspace if the input buffer's empty
+								keyboard_write_codepoint(ilonena_config.output_mode, '\b');
+							} else {
+								// Remove a character from the input buffer
+								codepoint_not_found = 0;
+								input_buffer[--input_buffer_index] = 0;
+								update_codepoint_found();
 								display_refresh_required = 1;
-							break;
-							case ILONENA_KEY_Q:
-								// Cycle thru the avaialble sitelen_pona_punctuation_or_extra_trailing_space (true or false)
-								ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space = !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space;
+							}
+						break;
+						default:
+							if(input_buffer_index < INPUT_BUFFER_SIZE) {
+								// Append a character to the input buffer
+								codepoint_not_found = 0;
+								input_buffer[input_buffer_index++] = key_id;
+#if LOOKUP_INCREMENTAL
+								input_trie_nodes[input_buffer_index] = lookup_trie_next(input_trie_nodes[input_buffer_index-1], key_id);
+#endif
+								update_codepoint_found();
 								display_refresh_required = 1;
-							break;
-							case ILONENA_KEY_WEKA:
-								// Discard the changes by reverting it.
-								ilonena_config = ilonena_config_prev;
-								ilonena_mode = ILONENA_MODE_INPUT;
-								display_refresh_required = 1;
-							break;
-							case ILONENA_KEY_PANA:
-								// Apply the changes (by not reverting the changes)
-								ilonena_mode = ILONENA_MODE_INPUT;
-								display_refresh_required = 1;
-								if(persistent_config) {
-									// In persistent_config, also write to the option bytes
-									uint16_t optbyte_data;
-									memcpy(&optbyte_data, &ilonena_config, sizeof(ilonena_config));
-									config_error_code = optionbytes_write_data(optbyte_data);
-									if(config_error_code) {
-										// Option Bytes write error occurred!
-										// Let's show the error screen instead of getting back to input mode
-										ilonena_mode = ILONENA_MODE_OPTBYTE_ERROR_SCREEN;
-									}
+#if LOOKUP_INCREMENTAL
+								if(ilonena_config.eager_commit && lookup_trie_is_unambiguous(input_trie_nodes[input_buffer_index])) {
+									// Nothing else could be typed from here. Send out the glyph as if ALA has been pressed.
+									key_id = ILONENA_KEY_ALA;
+									goto reprocess_key;
 								}
-							break;
-							default:
-								// For any other invalid keys, we ignore that by doing nothing.
-							break;
-						}
-					break;
-					case ILONENA_MODE_INPUT_TIMEOUT:
-						// Ignore all input! This mode would exit on its own after waiting for a while
-					break;
-					case ILONENA_MODE_OPTBYTE_ERROR_SCREEN:
-						// Ignore all input! The user is permanently stuck in this mode until power cycle.
-						// This mode should only happen extremely rarely.
-					break;
-				}
+#endif
+							} else {
+								// Input buffer overflow. Let's ignore the extra input being supplied! :P
+							}
+						break;
+					}
+				break;
+				case ILONENA_MODE_CONFIG:
+					switch(key_id) {
+						case ILONENA_KEY_1:
+							// Cycle thru the avaialble output_mode
+							if(++ilonena_config.output_mode >= (KEYBOARD_COMPOSE_MODE ? KEYBOARD_OUTPUT_MODE_END : KEYBOARD_OUTPUT_MODE_COMPOSE)) {
+								ilonena_config.output_mode = 0;
+							}
+							display_refresh_required = 1;
+						break;
+						case ILONENA_KEY_Q:
+							// Cycle thru the avaialble sitelen_pona_punctuation_or_extra_trailing_space (true or false)
+							// If the keyboard layout is shown, show the punctuation mode back first.
+							if(!config_show_layout) {
+								ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space = !ilonena_config.sitelen_pona_punctuation_or_extra_trailing_space;
+							}
+							config_show_layout = 0;
+							display_refresh_required = 1;
+						break;
+#if KEYBOARD_HOST_LAYOUTS
+						case ILONENA_KEY_W:
+							// Show the keyboard layout on the first press. Then cycle thru the available keyboard_layout
+							if(config_show_layout && ++ilonena_config.keyboard_layout >= KEYBOARD_LAYOUT_END) {
+								ilonena_config.keyboard_layout = 0;
+							}
+							keyboard_set_layout(ilonena_config.keyboard_layout);
+							config_show_layout = 1;
+							display_refresh_required = 1;
+						break;
+#endif
+#if LOOKUP_INCREMENTAL
+						case ILONENA_KEY_E:
+							// Toggle eager_commit
+							ilonena_config.eager_commit = !ilonena_config.eager_commit;
+							display_refresh_required = 1;
+						break;
+#endif
+						case ILONENA_KEY_WEKA:
+							// Discard the changes by reverting it.
+							ilonena_config = ilonena_config_prev;
+							keyboard_set_layout(ilonena_config.keyboard_layout);
+							ilonena_mode = ILONENA_MODE_INPUT;
+							display_refresh_required = 1;
+						break;
+						case ILONENA_KEY_PANA:
+							// Apply the changes (by not reverting the changes)
+							ilonena_mode = ILONENA_MODE_INPUT;
+							display_refresh_required = 1;
+							if(persistent_config) {
+								// In persistent_config, also write to the option bytes
+								uint16_t optbyte_data;
+								memcpy(&optbyte_data, &ilonena_config, sizeof(ilonena_config));
+								config_error_code = optionbytes_write_data(optbyte_data);
+								if(config_error_code) {
+									// Option Bytes write error occurred!
+									// Let's show the error screen instead of getting back to input mode
+									ilonena_mode = ILONENA_MODE_OPTBYTE_ERROR_SCREEN;
+								}
+							}
+						break;
+						default:
+							// For any other invalid keys, we ignore that by doing nothing.
+						break;
+					}
+				break;
+				case ILONENA_MODE_INPUT_TIMEOUT:
+					// Ignore all input! This mode would exit on its own after waiting for a while
+				break;
+				case ILONENA_MODE_OPTBYTE_ERROR_SCREEN:
+					// Ignore all input! The user is permanently stuck in this mode until power cycle.
+					// This mode should only happen extremely rarely.
+				break;
 			}
 		}
 
@@ -431,6 +519,7 @@ int main() {
 			(ilonena_mode == ILONENA_MODE_TITLE_SCREEN && (button_held_event & (1<<(ILONENA_KEY_WEKA-1)))) // If WEKA is held, enter persistent_config mode (persistent_config=1)
 			) {
 			ilonena_config_prev = ilonena_config;
+			config_show_layout = 0;
 			ilonena_mode = ILONENA_MODE_CONFIG;
 			display_refresh_required = 1;
 		}
@@ -461,10 +550,19 @@ int main() {
 			display_refresh_required = 1;
 		}
 
-		// When display refresh flag is set, only draw on the the display buffer and kick off the DMA while
-		// there's no data transfer to the display is going on. Updating the display buffer while the DMA is reading it
-		// would cause inconsistent pixels being displayed.
-		if(display_refresh_required && display_is_idle()) {
+		// Build the HID reports for typing out what has been written to the keyboard
+		keyboard_loop();
+
+		// Update the pending output shown in input mode
+		if(keyboard_get_pending_count() != keyboard_pending_count) {
+			keyboard_pending_count = keyboard_get_pending_count();
+			if(ilonena_mode == ILONENA_MODE_INPUT) {
+				display_refresh_required = 1;
+			}
+		}
+
+		// The display buffer can be drawn even while the previous frame is being sent. The DMA reads a copy of each window.
+		if(display_refresh_required) {
 			display_refresh_required = 0;
 			refresh_display();
 		}
@@ -31,21 +31,35 @@
 #include "rv003usb.h"
 #include <stdio.h>
 
-// How long it takes until we give up asserting the lock state. Unit depends on the USB polling frequency
+// How long it takes until we give up asserting the lock state, until we've learnt how the host echoes the lock changes.
+// Unit depends on the USB polling frequency
 #define KEYBOADRD_LOCK_CHANGE_TIMEOUT (100)
+// Once the host has echoed a lock change, the timeout is twice the slowest echo seen, plus this. Unit: USB polls
+#define KEYBOARD_LOCK_ECHO_MARGIN (4U)
+
+// Compose sequences of KEYBOARD_OUTPUT_MODE_COMPOSE: the compose key, KEYBOARD_COMPOSE_PREFIX, then the upper and the lower
+// 4 bits of the index of the sequence as 'a'~'p'. Must match the ones in generate_lookup_table.py
+#define KEYBOARD_COMPOSE_PREFIX ('q')
+#define KEYBOARD_COMPOSE_CODEPAGE_2_INDEX (0xF0U) // Index of the compose sequence of the first string of codepage 2
 
 // For keyboard_ascii_to_keycode, hold right shift if this flag exists
 #define KEYHID_SFT (0x80)
+// For LOOKUP_LAYOUT_KEYS only: hold AltGr (i.e. right alt) if this flag exists. The keycode takes the lower 6 bits.
+// Must match LAYOUT_KEY_ALTGR in generate_lookup_table.py
+#define KEYHID_ALTGR (0x40)
+// For LOOKUP_LAYOUT_KEYS only: stands for the extra key of ISO keyboards, HID_KEY_EUROPE_2, which doesn't fit into 6 bits.
+// It's one of the error codes of HID, which are never typed. Must match LAYOUT_KEY_ISO in generate_lookup_table.py
+#define KEYHID_ISO (0x03)
 
 // Table for converting ASCII-ish codepoints to HID_KEY_*, with KEYHID_SFT indicating requirement of holding shift
-// The codepoint 0x10~0x19 are stolen for outputting numpad keys, which is different from ASCII standard.
+// It's for the US layout. The others are in LOOKUP_LAYOUT_KEYS, see keyboard_get_key().
 const uint8_t keyboard_ascii_to_keycode[128] = {
 	// 0X
 	0, 0, 0, 0, 0, 0, 0, 0, HID_KEY_BACKSPACE, HID_KEY_TAB, HID_KEY_ENTER, 0, 0, HID_KEY_ENTER, 0, 0,
-	// 1X (The first 10 digits had been stolen for numpad keys)
-	HID_KEY_KEYPAD_0, HID_KEY_KEYPAD_1, HID_KEY_KEYPAD_2, HID_KEY_KEYPAD_3,
-	HID_KEY_KEYPAD_4, HID_KEY_KEYPAD_5, HID_KEY_KEYPAD_6, HID_KEY_KEYPAD_7,
-	HID_KEY_KEYPAD_8, HID_KEY_KEYPAD_9, 0, HID_KEY_ESCAPE,
+	// 1X
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, HID_KEY_ESCAPE,
 	0, 0, 0, 0,
 	// 2X
 	HID_KEY_SPACE, KEYHID_SFT|HID_KEY_1, KEYHID_SFT|HID_KEY_APOSTROPHE, KEYHID_SFT|HID_KEY_3,
@@ -78,29 +92,148 @@ const uint8_t keyboard_ascii_to_keycode[128] = {
 };
 #define KEYBOARD_MODE_START (sizeof(keyboard_ascii_to_keycode)/sizeof(*keyboard_ascii_to_keycode))
 
-// Ring buffer format: See keyboard_ascii_to_keycode if the value is <KEYBOARD_MODE_START. Otherwise see enum keyboard_output_mode.
-// It's written in the main loop and read from the usb_handle_user_in_request() in ISR
-// Example: {KEYBOARD_OUTPUT_MODE_LATIN, 'a', 'k', 'e', 's', 'i', KEYBOARD_OUTPUT_MODE_END}
-//   Effect: Type out "akesi" on keyboard.
-// Example: {KEYBOARD_OUTPUT_MODE_LINUX, '1', 'f', '5', '9', '5', ' ', KEYBOARD_OUTPUT_MODE_END}
+// Size of keyboard_out_queue. Each entry takes 4 bytes of RAM regardless of the length of the text it types.
+#define KEYBOARD_OUT_QUEUE_LENGTH (16U)
+
+// Entry of keyboard_out_queue: a codepoint to be typed in a mode. It gets expanded into the keys lazily by keyboard_loop().
+struct keyboard_out_descriptor {
+	uint32_t codepoint:24; // For KEYBOARD_OUTPUT_MODE_DELAY, it's the delay value instead. Unit: USB polls
+	                       // For KEYBOARD_OUTPUT_MODE_COMPOSE, it's the index of the compose sequence instead
+	uint32_t mode:4; // enum keyboard_output_mode. Never KEYBOARD_OUTPUT_MODE_END nor KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE
+	uint32_t force_trailing_space:1; // See KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE
+};
+
+static enum keyboard_layout keyboard_layout = KEYBOARD_LAYOUT_QWERTY; // Only used in the main loop
+
+// Ring buffer written by keyboard_write_codepoint() and read by keyboard_loop(), both in the main loop
+struct keyboard_out_descriptor keyboard_out_queue[KEYBOARD_OUT_QUEUE_LENGTH];
+size_t keyboard_out_queue_write_index = 0;
+size_t keyboard_out_queue_read_index = 0;
+
+// Size of keyboard_report_queue. The reports that can be queued is one less than this.
+// That's 6ms worth of reports with the usual 3ms USB polling interval.
+#define KEYBOARD_REPORT_QUEUE_LENGTH (3U)
+
+// Entry of keyboard_report_queue. One entry per USB poll.
+struct keyboard_report {
+	uint8_t data[8]; // Format: modifiers_keys (1 byte), reserved (1 byte), key_scancodes (6 bytes)
+	uint8_t unchanged; // Same as the previous report. The poll gets NAKed instead.
+};
+
+// Ring buffer of the HID reports built by keyboard_loop() in main loop, and sent by usb_handle_user_in_request() in ISR.
+// The poll gets NAKed while the queue is empty. The host keeps the keys of the last report pressed meanwhile.
+struct keyboard_report keyboard_report_queue[KEYBOARD_REPORT_QUEUE_LENGTH]; // CONCURRENCY_VARIABLE: written by main loop, read by usb_handle_user_in_request()
+size_t keyboard_report_queue_write_index = 0; // CONCURRENCY_VARIABLE: ditto
+size_t keyboard_report_queue_read_index = 0; // CONCURRENCY_VARIABLE: written by usb_handle_user_in_request(), read by main loop
+
+// keyboard_loop() reads each descriptor as a stream of entries. See keyboard_ascii_to_keycode if the value is <KEYBOARD_MODE_START.
+// Otherwise see enum keyboard_output_mode.
+// Example: {.codepoint=U+F1900 (akesi), .mode=KEYBOARD_OUTPUT_MODE_LATIN}
+//   Stream: {KEYBOARD_OUTPUT_MODE_LATIN, 'a', 'k', 'e', 's', 'i', ' ', KEYBOARD_OUTPUT_MODE_END}
+//   Effect: Type out "akesi " on keyboard.
+// Example: {.codepoint=U+1F595, .mode=KEYBOARD_OUTPUT_MODE_LINUX}
+//   Stream: {KEYBOARD_OUTPUT_MODE_LINUX, '1', 'f', '5', '9', '5', ' ', KEYBOARD_OUTPUT_MODE_END}
 //   Effect: Type out CTRL+SHIFT+U, then "1f595 " on keyboard. That'd output U+1F595 on linux.
 // Lock keys such as Caps lock and Num lock are automatically toggled during the operation because
 // the unicode-input mechanism only works when the locks are in correct state.
-uint8_t keyboard_out_buffer[128] = {0}; // CONCURRENCY_VARIABLE: written by main loop, read by usb_handle_user_in_request()
-size_t keyboard_out_buffer_write_index = 0; // CONCURRENCY_VARIABLE: ditto
-size_t keyboard_out_buffer_read_index = 0; // CONCURRENCY_VARIABLE: written by usb_handle_user_in_request(), read by main loop
+// If a descriptor is immediately followed by another one of the same mode, both are typed in the same session:
+// the locks are set up and restored once, and for Mac the ALT key is held across them.
+static struct {
+	enum {
+		KEYBOARD_OUT_PHASE_START, // The descriptor hasn't been read yet
+		KEYBOARD_OUT_PHASE_PREFIX, // 'u' of Windows, KEYBOARD_COMPOSE_PREFIX of compose
+		KEYBOARD_OUT_PHASE_BODY, // The characters of the string, the hex digits or the delay value
+		KEYBOARD_OUT_PHASE_SUFFIX, // Trailing space of Latin, enter of Windows, space of Linux
+		KEYBOARD_OUT_PHASE_END, // KEYBOARD_OUTPUT_MODE_END
+		KEYBOARD_OUT_PHASE_DONE, // The KEYBOARD_OUTPUT_MODE_END is the current entry
+	} phase;
+	uint8_t key_id; // The current entry of the stream
+	uint8_t body_length; // Hex digits or characters left to type. Not used for the strings.
+	uint8_t has_string; // The body is str
+	struct lookup_ascii_string str;
+	uint32_t value; // The hex value, or the only character of the body
+	char first; // First and last characters of the body, for the trailing space of Latin
+	char last;
+	uint8_t is_emoticon;
+} keyboard_out_expansion; // Only used in the main loop
+
+#if USB_VENDOR_INTERFACE
+// Size of keyboard_vendor_queue. The entry at the write index is the one being filled by the main loop.
+// Room for KEYBOARD_WRITE_LENGTH_MAX codepoints of 4 bytes of UTF-8 when it's empty.
+#define KEYBOARD_VENDOR_QUEUE_LENGTH (5U)
+#define KEYBOARD_VENDOR_REPORT_PAYLOAD (7U)
+// Output report of the helper for announcing itself. The helper sends it again every second.
+#define KEYBOARD_VENDOR_HELPER_HELLO (0x01U)
+// The helper is deemed gone if the vendor endpoint hasn't been polled for this long. The host only polls it while the
+// helper has it opened. Unit: polls of the keyboard endpoint
+#define KEYBOARD_VENDOR_HELPER_TIMEOUT (100U)
+
+// Input report of the vendor interface. See vendor_hid_desc in usb_config.h
+struct keyboard_vendor_report {
+	uint8_t length;
+	uint8_t data[KEYBOARD_VENDOR_REPORT_PAYLOAD]; // UTF-8 stream
+};
 
-uint8_t keyboard_locks_indicator = 0; // Not a concurrent variable. Used in usb_handle_user_data() and usb_handle_user_in_request(), both handled in the same ISR
+// Ring buffer of the reports of the vendor interface, filled by keyboard_write_codepoint() and sent by
+// usb_handle_user_in_request(). It's only used while the helper on the host is active.
+struct keyboard_vendor_report keyboard_vendor_queue[KEYBOARD_VENDOR_QUEUE_LENGTH]; // CONCURRENCY_VARIABLE: written by main loop, read by usb_handle_user_in_request()
+size_t keyboard_vendor_queue_write_index = 0; // CONCURRENCY_VARIABLE: ditto
+size_t keyboard_vendor_queue_read_index = 0; // CONCURRENCY_VARIABLE: written by usb_handle_user_in_request() and usb_handle_user_data(), read by main loop
+uint8_t keyboard_vendor_helper_announced = 0; // CONCURRENCY_VARIABLE: set by usb_handle_user_data(), cleared by main loop
+uint32_t keyboard_vendor_last_poll = 0; // CONCURRENCY_VARIABLE: written by ISR, read by main loop. Unit: polls of the keyboard endpoint
+#endif
+
+struct keyboard_usb_stats keyboard_usb_stats = {0};
+
+uint8_t keyboard_locks_indicator = 0; // CONCURRENCY_VARIABLE: written by usb_handle_user_data(), read by main loop
+uint8_t keyboard_locks_indicator_updates = 0; // CONCURRENCY_VARIABLE: incremented by usb_handle_user_data(), read by main loop
+
+// What's learnt about the LED output reports of the host since the power up, for the lock handshake: the lock keys are
+// pressed, then we wait for the host to echo the new lock state. The lock state is cached across the packets.
+static struct {
+	enum {
+		KEYBOARD_LOCK_ECHO_UNKNOWN, // Wait for up to KEYBOADRD_LOCK_CHANGE_TIMEOUT
+		KEYBOARD_LOCK_ECHO_SEEN, // Wait for up to twice echo_polls
+		KEYBOARD_LOCK_ECHO_NONE, // Don't wait. The host takes the lock keys without telling.
+	} echo;
+	uint8_t echo_polls; // Slowest echo seen. Unit: USB polls
+	uint8_t locks; // Last known lock state: the last LED output report, or the one expected after pressing the lock keys
+	uint8_t updates_seen; // keyboard_locks_indicator_updates when locks got synchronized
+	uint8_t toggled; // The lock keys pressed for the current handshake
+	uint8_t waited; // Polls waited in the current handshake
+	uint8_t timeout;
+} keyboard_lock_handshake; // Only used in main loop
+
+#if USB_VENDOR_INTERFACE
+static uint32_t keyboard_get_poll_count(void) {
+	return keyboard_usb_stats.reports_sent+keyboard_usb_stats.naks;
+}
+#endif
 
 // Grab the LED indicator of the keyboard. Purpose: To assert Num lock, Caps lock, etc. for entering unicode if needed
+// Also takes the announcement of the helper from the vendor interface
 void usb_handle_user_data(struct usb_endpoint *e, int current_endpoint, uint8_t *data, int len, struct rv003usb_internal *ist) {
-	if (len > 0) {
+#if USB_VENDOR_INTERFACE
+	if(current_endpoint == 2) {
+		if(len > 0 && data[0] == KEYBOARD_VENDOR_HELPER_HELLO) {
+			if(!keyboard_vendor_helper_announced) {
+				// A new helper. Drop what was left for the previous one.
+				keyboard_vendor_queue_read_index = keyboard_vendor_queue_write_index;
+			}
+			keyboard_vendor_last_poll = keyboard_get_poll_count();
+			keyboard_vendor_helper_announced = 1;
+		}
+		return;
+	}
+#endif
+	if(len > 0) {
 		keyboard_locks_indicator = data[0];
+		keyboard_locks_indicator_updates++;
 	}
 }
 
 // For toggling lock buttons based on the current lock state and the targeted lock state.
-uint8_t usb_handle_user_in_request_toggle_locks(uint8_t usb_response[8], uint8_t lock_indicator_current, uint8_t lock_indicator_target, uint8_t lock_indicator_target_mask) {
+static uint8_t keyboard_toggle_locks(uint8_t usb_response[8], uint8_t lock_indicator_current, uint8_t lock_indicator_target, uint8_t lock_indicator_target_mask) {
 	uint8_t lock_change_required = (lock_indicator_current ^ lock_indicator_target) & lock_indicator_target_mask;
 
 	size_t usb_index = 2;
@@ -123,63 +256,494 @@ uint8_t usb_handle_user_in_request_toggle_locks(uint8_t usb_response[8], uint8_t
 	return lock_change_required;
 }
 
-// For sending key signals when the USB hosts request for it.
+// Returns the HID_KEY_* typing the ASCII character c on the host, or HID_KEY_NONE. The modifiers to be held with it, right
+// shift and/or right alt (AltGr), are written to modifiers.
+static uint8_t keyboard_get_key(enum keyboard_output_mode mode, uint8_t c, uint8_t *modifiers) {
+	uint8_t key = keyboard_ascii_to_keycode[c];
+	*modifiers = (key & KEYHID_SFT) ? KEYBOARD_MODIFIER_RIGHTSHIFT : 0;
+	key &= ~KEYHID_SFT;
+	if(!KEYBOARD_HOST_LAYOUTS || keyboard_layout == KEYBOARD_LAYOUT_QWERTY || mode == KEYBOARD_OUTPUT_MODE_MACOS) {
+		return key;
+	}
+	const char *layout_char = memchr(LOOKUP_LAYOUT_CHARS, c, LOOKUP_LAYOUT_CHARS_LENGTH);
+	if(layout_char == NULL) {
+		return key; // Same key in every layout
+	}
+	key = LOOKUP_LAYOUT_KEYS[(keyboard_layout-1)*LOOKUP_LAYOUT_CHARS_LENGTH + (layout_char-LOOKUP_LAYOUT_CHARS)];
+	*modifiers = ((key & KEYHID_SFT) ? KEYBOARD_MODIFIER_RIGHTSHIFT : 0) | ((key & KEYHID_ALTGR) ? KEYBOARD_MODIFIER_RIGHTALT : 0);
+	key &= ~(KEYHID_SFT|KEYHID_ALTGR);
+	return key == KEYHID_ISO ? HID_KEY_EUROPE_2 : key;
+}
+
+// Sets up keyboard_out_expansion for typing the descriptor at keyboard_out_queue_read_index
+static void keyboard_out_expansion_start(const struct keyboard_out_descriptor *descriptor) {
+	uint32_t codepoint = descriptor->codepoint;
+	keyboard_out_expansion.has_string = 0;
+	keyboard_out_expansion.body_length = 1;
+	keyboard_out_expansion.value = codepoint;
+	keyboard_out_expansion.first = '\0';
+	keyboard_out_expansion.last = '\0';
+	keyboard_out_expansion.is_emoticon = 0;
+	switch(descriptor->mode) {
+		case KEYBOARD_OUTPUT_MODE_LATIN:
+			if(codepoint <= 0x7F) {
+				// direct output - no conversion needed
+			} else if(codepoint >= LOOKUP_CODEPAGE_0_START &&
+				codepoint < LOOKUP_CODEPAGE_0_START+LOOKUP_CODEPAGE_0_LENGTH) {
+				// Convert sitelen pona codepoint to sitelen Lasin
+				keyboard_out_expansion.has_string = lookup_get_ascii_string(&keyboard_out_expansion.str, 0, codepoint-LOOKUP_CODEPAGE_0_START);
+			} else if(codepoint >= LOOKUP_CODEPAGE_1_START &&
+				codepoint < LOOKUP_CODEPAGE_1_START+LOOKUP_CODEPAGE_1_LENGTH) {
+				// Convert codepage 1 codepoint to sitelen Lasin
+				keyboard_out_expansion.has_string = lookup_get_ascii_string(&keyboard_out_expansion.str, 1, codepoint-LOOKUP_CODEPAGE_1_START);
+			} else if(codepoint == 0x3000) {
+				keyboard_out_expansion.value = ' ';
+			} else {
+				// Unsupported codepoint. Let's output a questionmark.
+				keyboard_out_expansion.value = '?';
+			}
+		break;
+		case KEYBOARD_OUTPUT_MODE_MACOS:
+			// Send the codepoint as hex in UTF-16 encoding
+			if(codepoint > 0xFFFF) {
+				uint32_t codepoint_base = codepoint - 0x10000U;
+				codepoint = ((0xD800 | ((codepoint_base & (0x3FF<<10)) >> 10)) << 16) | (0xDC00 | (codepoint_base & 0x3FF));
+			}
+			// Exactly 4 digits per UTF-16 code unit. Option is held across consecutive codepoints, so a short one would
+			// be merged with the next.
+			keyboard_out_expansion.value = codepoint;
+			keyboard_out_expansion.body_length = (codepoint > 0xFFFF) ? 8 : 4;
+		break;
+		case KEYBOARD_OUTPUT_MODE_COMPOSE:
+			// The index as 2 digits of 'a'~'p'
+			keyboard_out_expansion.body_length = 2;
+		break;
+		case KEYBOARD_OUTPUT_MODE_WINDOWS:
+		case KEYBOARD_OUTPUT_MODE_LINUX:
+			// Send the codepoint as hex. Do not type out leading zeros
+			keyboard_out_expansion.body_length = 0;
+			while(codepoint >> (keyboard_out_expansion.body_length*4)) {
+				keyboard_out_expansion.body_length++;
+			}
+		break;
+		case KEYBOARD_OUTPUT_MODE_DELAY:
+		default:
+		break;
+	}
+}
+
+// Returns 1 if keyboard_out_expansion.key_id got a new entry of the body, or 0 at the end of the body
+static uint8_t keyboard_out_expansion_body(enum keyboard_output_mode mode) {
+	if(mode == KEYBOARD_OUTPUT_MODE_LATIN) {
+		char c;
+		if(keyboard_out_expansion.has_string) {
+			// The string is decoded on the fly
+			c = lookup_ascii_string_next(&keyboard_out_expansion.str);
+		} else {
+			c = keyboard_out_expansion.body_length ? keyboard_out_expansion.value : '\0';
+			keyboard_out_expansion.body_length = 0;
+		}
+		if(c == '\0') {
+			return 0;
+		}
+		// Only keep the characters needed for deciding on the trailing space
+		if(keyboard_out_expansion.first == '\0') {
+			keyboard_out_expansion.first = c;
+		} else if(keyboard_out_expansion.first == ':') {
+			keyboard_out_expansion.is_emoticon = 1;
+		}
+		keyboard_out_expansion.last = c;
+		keyboard_out_expansion.key_id = c;
+		return 1;
+	}
+	if(!keyboard_out_expansion.body_length) {
+		return 0;
+	}
+	keyboard_out_expansion.body_length--;
+	if(mode == KEYBOARD_OUTPUT_MODE_DELAY) {
+		keyboard_out_expansion.key_id = keyboard_out_expansion.value;
+		return 1;
+	}
+	// Hex digit, from the most significant one
+	uint8_t digit = (keyboard_out_expansion.value >> (keyboard_out_expansion.body_length*4)) & 0xF;
+	if(KEYBOARD_COMPOSE_MODE && mode == KEYBOARD_OUTPUT_MODE_COMPOSE) {
+		keyboard_out_expansion.key_id = 'a'+digit;
+	} else if(digit < 10) {
+		keyboard_out_expansion.key_id = '0'+digit;
+	} else {
+		keyboard_out_expansion.key_id = 'a'+digit-10;
+	}
+	return 1;
+}
+
+// Moves keyboard_out_expansion.key_id to the next entry of the stream of the current descriptor
+static void keyboard_out_expansion_next(void) {
+	const struct keyboard_out_descriptor *descriptor = &keyboard_out_queue[keyboard_out_queue_read_index];
+	enum keyboard_output_mode mode = descriptor->mode;
+	while(1) {
+		switch(keyboard_out_expansion.phase) {
+			case KEYBOARD_OUT_PHASE_START:
+				keyboard_out_expansion_start(descriptor);
+				keyboard_out_expansion.key_id = KEYBOARD_MODE_START+mode;
+				keyboard_out_expansion.phase = KEYBOARD_OUT_PHASE_PREFIX;
+			return;
+			case KEYBOARD_OUT_PHASE_PREFIX:
+				keyboard_out_expansion.phase = KEYBOARD_OUT_PHASE_BODY;
+				if(mode == KEYBOARD_OUTPUT_MODE_WINDOWS) {
+					keyboard_out_expansion.key_id = 'u';
+					return;
+				} else if(KEYBOARD_COMPOSE_MODE && mode == KEYBOARD_OUTPUT_MODE_COMPOSE) {
+					keyboard_out_expansion.key_id = KEYBOARD_COMPOSE_PREFIX;
+					return;
+				}
+			break;
+			case KEYBOARD_OUT_PHASE_BODY:
+				if(keyboard_out_expansion_body(mode)) {
+					return;
+				}
+				keyboard_out_expansion.phase = KEYBOARD_OUT_PHASE_SUFFIX;
+			break;
+			case KEYBOARD_OUT_PHASE_SUFFIX:
+			{
+				keyboard_out_expansion.phase = KEYBOARD_OUT_PHASE_END;
+				char last = keyboard_out_expansion.last;
+				// Force adding trailing space with KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE (except for space and newline)
+				uint8_t trailing_space = descriptor->force_trailing_space && last != ' ' && last != '\n';
+				if(keyboard_out_expansion.has_string) {
+					// Add a space after the end of emoticon or end of a word
+					trailing_space |= keyboard_out_expansion.is_emoticon || (last >= 'a' && last <= 'z');
+				} else if(descriptor->codepoint > 0x7F) {
+					trailing_space = 0; // The replacement characters of Latin doesn't take a trailing space
+				}
+				if(mode == KEYBOARD_OUTPUT_MODE_LATIN && trailing_space) {
+					keyboard_out_expansion.key_id = ' ';
+					return;
+				} else if(mode == KEYBOARD_OUTPUT_MODE_WINDOWS) {
+					keyboard_out_expansion.key_id = '\n'; // Press enter after complete entering the unicode
+					return;
+				} else if(mode == KEYBOARD_OUTPUT_MODE_LINUX) {
+					keyboard_out_expansion.key_id = ' '; // Press space after complete entering the unicode
+					return;
+				}
+			}
+			break;
+			case KEYBOARD_OUT_PHASE_END:
+			case KEYBOARD_OUT_PHASE_DONE:
+				keyboard_out_expansion.key_id = KEYBOARD_MODE_START+KEYBOARD_OUTPUT_MODE_END;
+				keyboard_out_expansion.phase = KEYBOARD_OUT_PHASE_DONE;
+			return;
+		}
+	}
+}
+
+// Returns 1 if there's something to be typed in keyboard_out_queue
+static uint8_t keyboard_out_available(void) {
+	return keyboard_out_queue_read_index != keyboard_out_queue_write_index;
+}
+
+// Returns the current entry of the stream. Only valid if keyboard_out_available()
+static uint8_t keyboard_out_peek(void) {
+	if(keyboard_out_expansion.phase == KEYBOARD_OUT_PHASE_START) {
+		keyboard_out_expansion_next();
+	}
+	return keyboard_out_expansion.key_id;
+}
+
+// Read the next entry of the stream after the current one has been processed
+static void keyboard_out_pop(void) {
+	keyboard_out_peek();
+	if(keyboard_out_expansion.phase == KEYBOARD_OUT_PHASE_DONE) {
+		// The whole descriptor had been typed
+		keyboard_out_expansion.phase = KEYBOARD_OUT_PHASE_START;
+		if(++keyboard_out_queue_read_index >= KEYBOARD_OUT_QUEUE_LENGTH) {
+			keyboard_out_queue_read_index = 0;
+		}
+	} else {
+		keyboard_out_expansion_next();
+	}
+}
+
+// Returns 1 if the current entry is the last one of the descriptor, and the next descriptor is of the mode
+static uint8_t keyboard_out_next_has_mode(enum keyboard_output_mode mode) {
+	size_t next_index = (keyboard_out_queue_read_index+1)%KEYBOARD_OUT_QUEUE_LENGTH;
+	return keyboard_out_expansion.phase == KEYBOARD_OUT_PHASE_DONE && next_index != keyboard_out_queue_write_index &&
+		keyboard_out_queue[next_index].mode == mode;
+}
+
+// PID of the NAK handshake, along with its check bits
+#define KEYBOARD_USB_PID_NAK (0x5A)
+
+// rv003usb doesn't answer an IN token on its own: without any usb_send_*() call, the host sees a bus timeout instead of
+// a handshake. A NAK is a packet of its own, sent without any data nor CRC.
+static void keyboard_send_nak(void) {
+	usb_send_data(0, 0, 2, KEYBOARD_USB_PID_NAK);
+}
+
+// For sending key signals when the USB hosts request for it. The reports are built by keyboard_loop() in advance.
 void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int endp, uint32_t sendtok, struct rv003usb_internal *ist) {
 	if(endp == 0) {
 		// Always make empty response for control transfer
 		usb_send_empty( sendtok );
 	} else if(endp == 1) {
-		asm volatile ("" ::: "memory");
 		// Keyboard end point
-		// Send the previous payload. We want to send out the response as soon as possible and cannot afford to wait for building the payload
-		static uint8_t usb_response[8] = { 0x00 }; // Format: modifiers_keys (1 byte), reserved (1 byte), key_scancodes (6 bytes)
-		static enum keyboard_output_mode mode;
-		// The procedure of sending a key goes like this: key 1 press -> key 1 release -> key 2 press -> key 2 release and so on.
-		// This is required in case two consecutive identical keys are to be typed
-		static uint8_t key_release_sent = 1;
-		// The Num Lock, Caps Lock, etc. that we're gonna modify
-		static uint8_t lock_indicator_target = 0;
-		static uint8_t lock_indicator_target_mask = 0;
-		static uint8_t lock_indicator_original = 0;
-		static uint32_t lock_release_wait_counter = 0;
-		// For inserting delay
-		static uint8_t key_step_delay_counter;
-		static enum {
-			// Wait for a command (i.e. enum keyboard_output_mode) in the output buffer
-			// If a command is detected, toggle lock keys (Num lock, Caps lock, etc.)
-			KEY_STEP_WAIT_COMMAND,
-			// Release the lock keys. Also wait for the lock key toggle to take effect
-			KEY_STEP_TOGGLE_LOCKS_WAIT,
-			// Press the modifier keys. For Windows, it's R_ALT (WinCompose). For Mac, it's ALT and it's held. For Linux, it's CTRL+SHIFT+U. For Latin, this step is skipped
-			KEY_STEP_PRESS_MODIFIER_KEYS,
-			// Release the modifier key so that it'd get taken. For Mac, the modifier key is to be held and this step is skipped.
-			// For Latin, this step is also skipped.
-			KEY_STEP_RELEASE_MODIFIER_KEYS,
-			// Wait for ASCII characters or KEYBOARD_OUTPUT_MODE_END. Send key presses based on the ASCII character received in the output buffer.
-			// Upon KEYBOARD_OUTPUT_MODE_END is received, go to the next step
-			KEY_STEP_SEND_KEYS,
-			// Release the ALT key for Mac. Skipped for Windows/Linux/Latin
-			KEY_STEP_RELEASE_MODIFIER_KEYS_2,
-			// Toggle lock key so that it restore back to original state
-			KEY_STEP_TOGGLE_LOCKS_2,
-			// Release the lock keys. Also wait for the lock key toggle to take effect
-			KEY_STEP_TOGGLE_LOCKS_2_WAIT,
-			// For KEYBOARD_OUTPUT_MODE_DELAY only: loads the delay value
-			KEY_STEP_DELAY_SET,
-			// Wait for completion of the delay
-			KEY_STEP_DELAY_WAIT,
-		} key_step = KEY_STEP_WAIT_COMMAND;
-
-		// Make a response first! The USB host can't wait
-		usb_send_data(usb_response, 8, 0, sendtok);
-
-		// After making the response based on the previous usb_response value, we can slowly build the next usb_response
-		uint8_t buffer_read_next_index = 0; // Read the next index after the current one has been processed
+		// Send the next report. If there isn't any new report, the poll gets NAKed, as HID allows: the host keeps the
+		// previous one. It saves the CPU time and the bus time of sending it again.
+		asm volatile ("" ::: "memory");
+		size_t index = keyboard_report_queue_read_index;
+		if(index != keyboard_report_queue_write_index && !keyboard_report_queue[index].unchanged) {
+			usb_send_data(keyboard_report_queue[index].data, 8, 0, sendtok);
+			keyboard_usb_stats.reports_sent++;
+		} else {
+			keyboard_send_nak();
+			keyboard_usb_stats.naks++;
+		}
+		if(index != keyboard_report_queue_write_index) {
+			if(++index >= KEYBOARD_REPORT_QUEUE_LENGTH) {
+				index = 0;
+			}
+			keyboard_report_queue_read_index = index;
+		}
+#if USB_VENDOR_INTERFACE
+	} else if(endp == 2) {
+		// Vendor end point. Only polled while the helper has it opened.
+		asm volatile ("" ::: "memory");
+		keyboard_vendor_last_poll = keyboard_get_poll_count();
+		size_t index = keyboard_vendor_queue_read_index;
+		if(keyboard_vendor_helper_announced && index != keyboard_vendor_queue_write_index) {
+			usb_send_data(&keyboard_vendor_queue[index], sizeof(struct keyboard_vendor_report), 0, sendtok);
+			if(++index >= KEYBOARD_VENDOR_QUEUE_LENGTH) {
+				index = 0;
+			}
+			keyboard_vendor_queue_read_index = index;
+			keyboard_usb_stats.vendor_reports_sent++;
+		} else {
+			keyboard_send_nak();
+		}
+#endif
+	}
+}
+
+// Takes the LED output report of the host, if there's a new one
+static void keyboard_lock_handshake_sync(void) {
+	asm volatile ("" ::: "memory");
+	uint8_t updates = keyboard_locks_indicator_updates;
+	if(updates != keyboard_lock_handshake.updates_seen) {
+		keyboard_lock_handshake.updates_seen = updates;
+		keyboard_lock_handshake.locks = keyboard_locks_indicator;
+		if(keyboard_lock_handshake.echo == KEYBOARD_LOCK_ECHO_NONE) {
+			// It does send the LED output reports after all. Learn again.
+			keyboard_lock_handshake.echo = KEYBOARD_LOCK_ECHO_UNKNOWN;
+		}
+	}
+}
+
+// Press the lock keys for getting into lock_indicator_target, based on the last known lock state. Returns the locks toggled.
+// Without wait_for_echo, only the poll releasing the lock keys is waited. The host takes the lock keys in order with the
+// other keys, so the lock state expected is cached right away. The echo corrects it later on if it's different.
+static uint8_t keyboard_lock_handshake_start(uint8_t usb_response[8], uint8_t lock_indicator_target, uint8_t lock_indicator_target_mask, uint8_t wait_for_echo) {
+	keyboard_lock_handshake_sync();
+	keyboard_lock_handshake.toggled = keyboard_toggle_locks(usb_response, keyboard_lock_handshake.locks, lock_indicator_target, lock_indicator_target_mask);
+	keyboard_lock_handshake.waited = 0;
+	keyboard_lock_handshake.timeout = KEYBOADRD_LOCK_CHANGE_TIMEOUT;
+	if(keyboard_lock_handshake.echo == KEYBOARD_LOCK_ECHO_SEEN) {
+		uint32_t timeout = keyboard_lock_handshake.echo_polls*2U+KEYBOARD_LOCK_ECHO_MARGIN;
+		keyboard_lock_handshake.timeout = timeout < KEYBOADRD_LOCK_CHANGE_TIMEOUT ? timeout : KEYBOADRD_LOCK_CHANGE_TIMEOUT;
+	}
+	if(!wait_for_echo || keyboard_lock_handshake.echo == KEYBOARD_LOCK_ECHO_NONE) {
+		// Not waiting for the echo, or it won't come
+		keyboard_lock_handshake.locks = (keyboard_lock_handshake.locks & ~lock_indicator_target_mask) | lock_indicator_target;
+		keyboard_lock_handshake.toggled = 0; // Nothing to be learnt from this handshake
+	}
+	return keyboard_lock_handshake.toggled;
+}
+
+// Returns 1 once the locks are in lock_indicator_target, or if we give up waiting. Called once per USB poll.
+// It takes at least one poll, for releasing the lock keys.
+static uint8_t keyboard_lock_handshake_wait(uint8_t lock_indicator_target, uint8_t lock_indicator_target_mask) {
+	keyboard_lock_handshake.waited++;
+	keyboard_usb_stats.lock_wait_polls++;
+	keyboard_lock_handshake_sync();
+	if((keyboard_lock_handshake.locks & lock_indicator_target_mask) == lock_indicator_target) {
+		if(keyboard_lock_handshake.toggled) {
+			keyboard_lock_handshake.echo = KEYBOARD_LOCK_ECHO_SEEN;
+			if(keyboard_lock_handshake.waited > keyboard_lock_handshake.echo_polls) {
+				keyboard_lock_handshake.echo_polls = keyboard_lock_handshake.waited;
+			}
+		}
+		return 1;
+	}
+	if(keyboard_lock_handshake.waited >= keyboard_lock_handshake.timeout) {
+		// No echo in time. Assume that the host took the lock keys anyway. If it had echoed before, it's just slower than
+		// expected: wait for the whole KEYBOADRD_LOCK_CHANGE_TIMEOUT next time. Otherwise stop waiting for it.
+		keyboard_lock_handshake.echo = (keyboard_lock_handshake.echo == KEYBOARD_LOCK_ECHO_SEEN) ? KEYBOARD_LOCK_ECHO_UNKNOWN : KEYBOARD_LOCK_ECHO_NONE;
+		keyboard_lock_handshake.locks = (keyboard_lock_handshake.locks & ~lock_indicator_target_mask) | lock_indicator_target;
+		return 1;
+	}
+	return 0;
+}
+
+#if USB_VENDOR_INTERFACE
+// Returns 1 if the helper on the host is taking the text from the vendor interface. Called from main loop.
+static uint8_t keyboard_vendor_is_active(void) {
+	asm volatile ("" ::: "memory");
+	uint32_t last_poll = keyboard_vendor_last_poll; // Read before the poll count, which could only get ahead of it
+	if(keyboard_vendor_helper_announced && keyboard_get_poll_count()-last_poll < KEYBOARD_VENDOR_HELPER_TIMEOUT) {
+		return 1;
+	}
+	keyboard_vendor_helper_announced = 0;
+	return 0;
+}
+
+// Returns the amount of reports handed to usb_handle_user_in_request() and not sent yet
+static size_t keyboard_vendor_get_queued_reports(void) {
+	asm volatile ("" ::: "memory");
+	size_t read_index = keyboard_vendor_queue_read_index;
+	size_t write_index = keyboard_vendor_queue_write_index;
+	if(write_index < read_index) {
+		write_index += KEYBOARD_VENDOR_QUEUE_LENGTH;
+	}
+	return write_index-read_index;
+}
+
+// Returns the amount of bytes that can be written to keyboard_vendor_queue right now
+static size_t keyboard_vendor_get_free_bytes(void) {
+	size_t free_reports = KEYBOARD_VENDOR_QUEUE_LENGTH-1-keyboard_vendor_get_queued_reports();
+	return free_reports*KEYBOARD_VENDOR_REPORT_PAYLOAD + KEYBOARD_VENDOR_REPORT_PAYLOAD-keyboard_vendor_queue[keyboard_vendor_queue_write_index].length;
+}
+
+// Returns 1 if there's anything in keyboard_vendor_queue that hasn't been sent yet
+static uint8_t keyboard_vendor_is_pending(void) {
+	asm volatile ("" ::: "memory");
+	return keyboard_vendor_queue_read_index != keyboard_vendor_queue_write_index || keyboard_vendor_queue[keyboard_vendor_queue_write_index].length;
+}
+
+// Hands the report being filled to usb_handle_user_in_request(), if there's room for starting another one
+static void keyboard_vendor_commit(void) {
+	size_t write_index = keyboard_vendor_queue_write_index;
+	size_t next_write_index = write_index+1;
+	if(next_write_index >= KEYBOARD_VENDOR_QUEUE_LENGTH) {
+		next_write_index = 0;
+	}
+	asm volatile ("" ::: "memory");
+	if(!keyboard_vendor_queue[write_index].length || next_write_index == keyboard_vendor_queue_read_index) {
+		return;
+	}
+	keyboard_vendor_queue[next_write_index].length = 0;
+	asm volatile ("" ::: "memory");
+	keyboard_vendor_queue_write_index = next_write_index;
+}
+
+// Appends the codepoint as UTF-8 to keyboard_vendor_queue. The caller makes sure that there's room for 4 bytes.
+static void keyboard_vendor_push_codepoint(uint32_t codepoint) {
+	uint8_t utf8[4];
+	size_t length;
+	if(codepoint < 0x80) {
+		utf8[0] = codepoint;
+		length = 1;
+	} else if(codepoint < 0x800) {
+		utf8[0] = 0xC0 | (codepoint >> 6);
+		length = 2;
+	} else if(codepoint < 0x10000) {
+		utf8[0] = 0xE0 | (codepoint >> 12);
+		length = 3;
+	} else {
+		utf8[0] = 0xF0 | (codepoint >> 18);
+		length = 4;
+	}
+	for(size_t i=1; i<length; i++) {
+		utf8[i] = 0x80 | ((codepoint >> ((length-1-i)*6)) & 0x3F);
+	}
+	for(size_t i=0; i<length; i++) {
+		struct keyboard_vendor_report *report = &keyboard_vendor_queue[keyboard_vendor_queue_write_index];
+		if(report->length >= KEYBOARD_VENDOR_REPORT_PAYLOAD) {
+			keyboard_vendor_commit();
+			report = &keyboard_vendor_queue[keyboard_vendor_queue_write_index];
+		}
+		report->data[report->length++] = utf8[i];
+	}
+}
+#endif
+
+// Builds the HID reports for typing out keyboard_out_queue into keyboard_report_queue. Called from the main loop.
+// Each report built is sent for one USB poll. The main loop must not stall with keys pressed in the report last built,
+// or else they'd be held long enough for being repeated by the host.
+void keyboard_loop(void) {
+	static uint8_t usb_response[8] = { 0x00 }; // The report last built
+	static enum keyboard_output_mode mode;
+	// The Num Lock, Caps Lock, etc. that we're gonna modify
+	static uint8_t lock_indicator_target = 0;
+	static uint8_t lock_indicator_target_mask = 0;
+	static uint8_t lock_indicator_original = 0;
+	// For inserting delay
+	static uint8_t key_step_delay_counter;
+	static enum {
+		// Wait for a command (i.e. enum keyboard_output_mode) in the output buffer
+		// If a command is detected, toggle lock keys (Num lock, Caps lock, etc.)
+		KEY_STEP_WAIT_COMMAND,
+		// Release the lock keys. Also wait for the lock key toggle to take effect
+		KEY_STEP_TOGGLE_LOCKS_WAIT,
+		// Press the modifier keys. For Windows, it's R_ALT (WinCompose). For Mac, it's ALT and it's held. For Linux, it's CTRL+SHIFT+U. For Latin, this step is skipped
+		KEY_STEP_PRESS_MODIFIER_KEYS,
+		// Release the modifier key so that it'd get taken. For Mac, the modifier key is to be held and this step is skipped.
+		// For Latin, this step is also skipped.
+		KEY_STEP_RELEASE_MODIFIER_KEYS,
+		// Wait for ASCII characters or KEYBOARD_OUTPUT_MODE_END. Send key presses based on the ASCII character received in the output buffer.
+		// Upon KEYBOARD_OUTPUT_MODE_END is received, go to the next step
+		KEY_STEP_SEND_KEYS,
+		// Release the ALT key for Mac. Skipped for Windows/Linux/Latin
+		KEY_STEP_RELEASE_MODIFIER_KEYS_2,
+		// Toggle lock key so that it restore back to original state
+		KEY_STEP_TOGGLE_LOCKS_2,
+		// Release the lock keys. The echo isn't waited for, see keyboard_lock_handshake_start()
+		KEY_STEP_TOGGLE_LOCKS_2_WAIT,
+		// For KEYBOARD_OUTPUT_MODE_DELAY only: loads the delay value
+		KEY_STEP_DELAY_SET,
+		// Wait for completion of the delay
+		KEY_STEP_DELAY_WAIT,
+	} key_step = KEY_STEP_WAIT_COMMAND;
+
+#if USB_VENDOR_INTERFACE
+	// Hand the text written to the vendor interface over to the ISR, or drop it if the helper is gone
+	if(keyboard_vendor_is_active()) {
+		keyboard_vendor_commit();
+	} else {
+		keyboard_vendor_queue[keyboard_vendor_queue_write_index].length = 0;
+	}
+#endif
+
+	while(1) {
+		asm volatile ("" ::: "memory");
+		size_t write_index = keyboard_report_queue_write_index;
+		size_t next_write_index = write_index+1;
+		if(next_write_index >= KEYBOARD_REPORT_QUEUE_LENGTH) {
+			next_write_index = 0;
+		}
+		uint8_t report_queue_empty = (write_index == keyboard_report_queue_read_index);
+		if(next_write_index == keyboard_report_queue_read_index) {
+			break; // The queue is full
+		}
+		if(key_step == KEY_STEP_WAIT_COMMAND && !keyboard_out_available()) {
+			break; // Nothing to be typed. The polls get NAKed, and the host keeps the last report.
+		}
+#if USB_VENDOR_INTERFACE
+		if(key_step == KEY_STEP_WAIT_COMMAND && keyboard_vendor_is_active() && keyboard_vendor_is_pending()) {
+			break; // The text written before to the vendor interface goes first
+		}
+#endif
+		if(!report_queue_empty && (key_step == KEY_STEP_TOGGLE_LOCKS_WAIT || key_step == KEY_STEP_TOGGLE_LOCKS_2_WAIT)) {
+			// The lock state is checked once per USB poll, after the reports queued before have been sent. Otherwise the
+			// reports queued in advance would delay the next step after the LED output report of the host comes in.
+			break;
+		}
+
+		// Build the next report based on the previous one
+		uint8_t previous_response[8];
+		memcpy(previous_response, usb_response, sizeof(usb_response));
 		switch(key_step) {
 			case KEY_STEP_WAIT_COMMAND:
 			{
-				uint8_t key_id = keyboard_out_buffer[keyboard_out_buffer_read_index];
-				if(keyboard_out_buffer_read_index != keyboard_out_buffer_write_index) {
+				if(keyboard_out_available()) {
+					uint8_t key_id = keyboard_out_peek();
 					uint8_t skip_postprocessing = 0;
 					// Press the lock keys (num lock, caps lock, etc.) state according to the mode received
 					mode = key_id-KEYBOARD_MODE_START;
@@ -187,15 +751,13 @@ void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int
 						case KEYBOARD_OUTPUT_MODE_LATIN:
 						case KEYBOARD_OUTPUT_MODE_MACOS:
 						case KEYBOARD_OUTPUT_MODE_WINDOWS:
-							// Need to ensure Capslock is inactive
+						case KEYBOARD_OUTPUT_MODE_LINUX:
+						case KEYBOARD_OUTPUT_MODE_COMPOSE:
+							// Need to ensure Capslock is inactive. The digits are typed with the main row as per keyboard_layout,
+							// so Numlock doesn't matter.
 							lock_indicator_target = 0;
 							lock_indicator_target_mask = KEYBOARD_LED_CAPSLOCK;
 						break;
-						case KEYBOARD_OUTPUT_MODE_LINUX:
-							// Need to ensure Capslock is inactive and Numlock is active
-							lock_indicator_target = KEYBOARD_LED_NUMLOCK;
-							lock_indicator_target_mask = KEYBOARD_LED_CAPSLOCK|KEYBOARD_LED_NUMLOCK;
-						break;
 						case KEYBOARD_OUTPUT_MODE_DELAY:
 							key_step = KEY_STEP_DELAY_SET;
 							skip_postprocessing = 1;
@@ -206,19 +768,20 @@ void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int
 						break;
 					}
 					if(!skip_postprocessing) {
-						lock_indicator_original = keyboard_locks_indicator;
-						usb_handle_user_in_request_toggle_locks(usb_response, keyboard_locks_indicator, lock_indicator_target, lock_indicator_target_mask);
-						lock_release_wait_counter = KEYBOADRD_LOCK_CHANGE_TIMEOUT; // Timeout for waiting for the target lock state
+						keyboard_lock_handshake_sync();
+						lock_indicator_original = keyboard_lock_handshake.locks;
+						// The unicode input needs the locks in place. Wait for the host to echo them.
+						keyboard_lock_handshake_start(usb_response, lock_indicator_target, lock_indicator_target_mask, 1);
 						key_step = KEY_STEP_TOGGLE_LOCKS_WAIT;
 					}
-					buffer_read_next_index = 1;
+					keyboard_out_pop();
 				}
 			}
 			break;
 			case KEY_STEP_TOGGLE_LOCKS_WAIT:
-				// Release lock keys and wait for the lock state to be restored (or timeout)
+				// Release lock keys
 				memset(usb_response, 0, sizeof(usb_response));
-				if(!(--lock_release_wait_counter) || (keyboard_locks_indicator & lock_indicator_target_mask) == lock_indicator_target) {
+				if(keyboard_lock_handshake_wait(lock_indicator_target, lock_indicator_target_mask)) {
 					if(mode == KEYBOARD_OUTPUT_MODE_LATIN) {
 						// For latin mode, we skip KEY_STEP_PRESS_MODIFIER_KEYS and KEY_STEP_RELEASE_MODIFIER_KEYS
 						key_step = KEY_STEP_SEND_KEYS;
@@ -236,14 +799,19 @@ void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int
 						key_step = KEY_STEP_SEND_KEYS;
 					break;
 					case KEYBOARD_OUTPUT_MODE_WINDOWS:
+					case KEYBOARD_OUTPUT_MODE_COMPOSE:
+						// Tap the compose key. It's R_ALT for both WinCompose and the generated compose files
 						usb_response[0] = KEYBOARD_MODIFIER_RIGHTALT;
 						key_step = KEY_STEP_RELEASE_MODIFIER_KEYS;
 					break;
 					case KEYBOARD_OUTPUT_MODE_LINUX:
-						// Send CTRL+SHIFT+U prefix
+					{
+						// Send CTRL+SHIFT+U prefix. ibus takes the U of the layout.
+						uint8_t modifiers;
 						usb_response[0] = KEYBOARD_MODIFIER_LEFTCTRL|KEYBOARD_MODIFIER_LEFTSHIFT;
-						usb_response[2] = HID_KEY_U;
+						usb_response[2] = keyboard_get_key(mode, 'u', &modifiers);
 						key_step = KEY_STEP_RELEASE_MODIFIER_KEYS;
+					}
 					break;
 					case KEYBOARD_OUTPUT_MODE_LATIN:
 					case KEYBOARD_OUTPUT_MODE_END:
@@ -259,10 +827,39 @@ void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int
 			break;
 			case KEY_STEP_SEND_KEYS:
 			{
-				if(keyboard_out_buffer_read_index != keyboard_out_buffer_write_index) {
-					uint8_t key_id = keyboard_out_buffer[keyboard_out_buffer_read_index];
+				// Pack up to 6 distinct keys into the report, in the order of the output buffer. The keys of the previous report
+				// get released by the same report. A report without any key is sent in between if the next key is in the
+				// previous report (the host would see it as being held rather than pressed again), or if the next key
+				// requires a shift/AltGr state different from the one of the previous report.
+				uint8_t previous_keys[6];
+				memcpy(previous_keys, &usb_response[2], sizeof(previous_keys));
+				memset(&usb_response[2], HID_KEY_NONE, sizeof(previous_keys));
+				uint8_t shift = usb_response[0] & (KEYBOARD_MODIFIER_RIGHTSHIFT|KEYBOARD_MODIFIER_RIGHTALT);
+				uint8_t shift_fixed = (previous_keys[0] != HID_KEY_NONE);
+				size_t key_count = 0;
+				while(key_count < sizeof(previous_keys) && keyboard_out_available()) {
+					uint8_t key_id = keyboard_out_peek();
 					if(key_id >= KEYBOARD_MODE_START) {
-						// Detect end of input sequence, release keys and go to the next step
+						// Detect end of input sequence. The keys already in this report are sent out first.
+						if(keyboard_out_next_has_mode(mode)) {
+							// The next packet is of the same mode. Keep the session open: the locks are already in the
+							// targeted state, and for Mac the ALT key is still held. Skip the END and the mode of the next packet.
+							if(mode == KEYBOARD_OUTPUT_MODE_LATIN || mode == KEYBOARD_OUTPUT_MODE_MACOS) {
+								keyboard_out_pop();
+								keyboard_out_pop();
+								continue; // Keep on packing the keys of the next packet into this report
+							}
+							// Windows and Linux need the modifier keys for starting each codepoint. The keys of this report go out first.
+							if(!key_count) {
+								keyboard_out_pop();
+								keyboard_out_pop();
+								key_step = KEY_STEP_PRESS_MODIFIER_KEYS;
+							}
+							break;
+						}
+						if(key_count) {
+							break;
+						}
 						if((key_id-KEYBOARD_MODE_START) == KEYBOARD_OUTPUT_MODE_END) {
 							// Update the lock_indicator_target for restoring to the original lock state
 							lock_indicator_target = lock_indicator_original & lock_indicator_target_mask;
@@ -270,6 +867,7 @@ void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int
 								case KEYBOARD_OUTPUT_MODE_LATIN:
 								case KEYBOARD_OUTPUT_MODE_LINUX:
 								case KEYBOARD_OUTPUT_MODE_WINDOWS:
+								case KEYBOARD_OUTPUT_MODE_COMPOSE:
 									// Skip releasing modifier key and just go toggle the lock keys
 									key_step = KEY_STEP_TOGGLE_LOCKS_2;
 								break;
@@ -284,26 +882,25 @@ void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int
 						} else {
 							while(1); // Should never reach here
 						}
-						buffer_read_next_index = 1;
-					} else {
-						// Process the input sequence
-						// For each key, press it once, then release it before processing the next key.
-						if(key_release_sent) {
-							// Send out the key. Hold right shift if needed
-							if(keyboard_ascii_to_keycode[key_id] & KEYHID_SFT) {
-								usb_response[0] |= KEYBOARD_MODIFIER_RIGHTSHIFT;
-							}
-							usb_response[2] = (keyboard_ascii_to_keycode[key_id] & ~KEYHID_SFT);
-							key_release_sent = 0;
-						} else {
-							// Release the right shift and the key
-							usb_response[0] &= ~KEYBOARD_MODIFIER_RIGHTSHIFT;
-							usb_response[2] = HID_KEY_NONE;
-							key_release_sent = 1;
-							buffer_read_next_index = 1;
+						keyboard_out_pop();
+						break;
+					}
+					uint8_t key_shift;
+					uint8_t keycode = keyboard_get_key(mode, key_id, &key_shift);
+					if(keycode != HID_KEY_NONE) {
+						if((shift_fixed && key_shift != shift) ||
+							memchr(previous_keys, keycode, sizeof(previous_keys)) || memchr(&usb_response[2], keycode, key_count)) {
+							break;
 						}
+						// Hold right shift and/or AltGr if needed
+						shift = key_shift;
+						shift_fixed = 1;
+						usb_response[2+key_count++] = keycode;
 					}
+					keyboard_out_pop();
 				}
+				// Release the right shift and AltGr along with the keys
+				usb_response[0] = (usb_response[0] & ~(KEYBOARD_MODIFIER_RIGHTSHIFT|KEYBOARD_MODIFIER_RIGHTALT)) | (key_count ? shift : 0);
 			}
 			break;
 			case KEY_STEP_RELEASE_MODIFIER_KEYS_2:
@@ -313,83 +910,90 @@ void usb_handle_user_in_request(struct usb_endpoint *e, uint8_t *scratchpad, int
 			break;
 			case KEY_STEP_TOGGLE_LOCKS_2:
 				// Press the lock keys
-				usb_handle_user_in_request_toggle_locks(usb_response, keyboard_locks_indicator, lock_indicator_target, lock_indicator_target_mask);
-				lock_release_wait_counter = KEYBOADRD_LOCK_CHANGE_TIMEOUT; // Timeout for waiting for the target lock state
+				// Nothing is typed until the next packet, which checks the locks again. No need to wait for the echo.
+				keyboard_lock_handshake_start(usb_response, lock_indicator_target, lock_indicator_target_mask, 0);
 				key_step = KEY_STEP_TOGGLE_LOCKS_2_WAIT;
 			break;
 			case KEY_STEP_TOGGLE_LOCKS_2_WAIT:
-				// Release lock keys and wait for the lock state to be restored (or timeout)
+				// Release lock keys
 				memset(usb_response, 0, sizeof(usb_response));
-				if(!(--lock_release_wait_counter) || (keyboard_locks_indicator & lock_indicator_target_mask) == lock_indicator_target) {
+				if(keyboard_lock_handshake_wait(lock_indicator_target, lock_indicator_target_mask)) {
 					key_step = KEY_STEP_WAIT_COMMAND;
 				}
 			break;
 			case KEY_STEP_DELAY_SET:
-				key_step_delay_counter = keyboard_out_buffer[keyboard_out_buffer_read_index];
+				key_step_delay_counter = keyboard_out_peek();
 				key_step = KEY_STEP_DELAY_WAIT;
-				buffer_read_next_index = 1;
+				keyboard_out_pop();
 			break;
 			case KEY_STEP_DELAY_WAIT:
 				if(!(key_step_delay_counter--)) {
 					key_step = KEY_STEP_WAIT_COMMAND;
-					buffer_read_next_index = 1; // Gets rid of the KEYBOARD_OUTPUT_MODE_END
+					keyboard_out_pop(); // Gets rid of the KEYBOARD_OUTPUT_MODE_END
 				}
 			break;
 		}
-		if(buffer_read_next_index) {
-			if(++keyboard_out_buffer_read_index >= sizeof(keyboard_out_buffer)) {
-				keyboard_out_buffer_read_index = 0;
-			}
-		}
+
+		memcpy(keyboard_report_queue[write_index].data, usb_response, sizeof(usb_response));
+		keyboard_report_queue[write_index].unchanged = !memcmp(previous_response, usb_response, sizeof(usb_response));
+		asm volatile ("" ::: "memory");
+		keyboard_report_queue_write_index = next_write_index;
 	}
 }
 
-// Push a mode or ASCII key into the output buffer
-static void keyboard_push_to_out_buffer(uint8_t key_id) {
+// Returns the amount of descriptors that can be pushed into the output queue right now
+static size_t keyboard_out_queue_get_free_count(void) {
 	asm volatile ("" ::: "memory");
-	while((keyboard_out_buffer_write_index+1)%sizeof(keyboard_out_buffer) == keyboard_out_buffer_read_index) {
-		// Block until keyboard output buffer is available before inserting the next character
-		asm volatile ("" ::: "memory");
-	}
-	keyboard_out_buffer[keyboard_out_buffer_write_index] = key_id;
-	if(++keyboard_out_buffer_write_index >= sizeof(keyboard_out_buffer)) {
-		keyboard_out_buffer_write_index = 0;
-	}
+	return (keyboard_out_queue_read_index+KEYBOARD_OUT_QUEUE_LENGTH-keyboard_out_queue_write_index-1)%KEYBOARD_OUT_QUEUE_LENGTH;
 }
 
-// Push a lower-case hex value to the output buffer
-static void keyboard_push_hex_to_out_buffer(uint32_t codepoint, uint8_t use_numpad) {
-	uint8_t handled_leading_zeros = 0;
-	// reverse iteration from 7 to 0 inclusive using unsigned integer
-	for(uint32_t i=8; i-->0; ) {
-		uint8_t digit = (codepoint & (0xF<<(i*4))) >> (i*4);
-		if(!handled_leading_zeros && !digit) {
-			continue; // Do not type out leading zeros
-		}
-		if(digit < 10) {
-			keyboard_push_to_out_buffer((use_numpad ? 0x10 : '0')+digit);
-		} else {
-			keyboard_push_to_out_buffer('a'+digit-10);
-		}
-		handled_leading_zeros = 1;
+// Push a descriptor into the output queue. The caller makes sure that there's room for it.
+static void keyboard_push_to_out_queue(enum keyboard_output_mode mode, uint32_t codepoint, uint8_t force_trailing_space) {
+	keyboard_out_queue[keyboard_out_queue_write_index] = (struct keyboard_out_descriptor){
+		.codepoint = codepoint,
+		.mode = mode,
+		.force_trailing_space = force_trailing_space,
+	};
+	asm volatile ("" ::: "memory");
+	if(++keyboard_out_queue_write_index >= KEYBOARD_OUT_QUEUE_LENGTH) {
+		keyboard_out_queue_write_index = 0;
 	}
 }
 
-static void keyboard_write_ascii_string(uint8_t codepage, size_t character_id, uint8_t force_trailing_space) {
-	const char *str = lookup_get_ascii_string(codepage, character_id);
-	uint8_t is_emoticon = (*str == ':') && (*(str+1) != '\0');
-	while(*str) {
-		keyboard_push_to_out_buffer(*str);
-		str++;
+// The layout applies to what's typed from now on, including what's already pending
+void keyboard_set_layout(enum keyboard_layout layout) {
+	// Unknown layout, such as the one of a config saved by a newer firmware
+	keyboard_layout = layout < KEYBOARD_LAYOUT_END ? layout : KEYBOARD_LAYOUT_QWERTY;
+}
+
+// Returns 1 if any action of the user can be written out right away. i.e. there's room for KEYBOARD_WRITE_LENGTH_MAX descriptors,
+// and for as many codepoints in the vendor interface if the helper is active.
+uint8_t keyboard_is_writable(void) {
+#if USB_VENDOR_INTERFACE
+	if(keyboard_vendor_is_active() && keyboard_vendor_get_free_bytes() < KEYBOARD_WRITE_LENGTH_MAX*4) {
+		return 0;
 	}
+#endif
+	return keyboard_out_queue_get_free_count() >= KEYBOARD_WRITE_LENGTH_MAX;
+}
 
-	// Add a space after the end of emoticon or end of a word. Also add if force_trailing_space=1 (except for space and newline)
-	if(is_emoticon || (*(str-1) >= 'a' && *(str-1) <= 'z') || (force_trailing_space && *(str-1) != ' ' && *(str-1) != '\n')) {
-		keyboard_push_to_out_buffer(' ');
+// Returns the amount of codepoints that haven't been completely typed out yet. For the vendor interface, it's the amount
+// of reports not sent yet instead.
+size_t keyboard_get_pending_count(void) {
+	asm volatile ("" ::: "memory");
+	size_t count = (keyboard_out_queue_write_index+KEYBOARD_OUT_QUEUE_LENGTH-keyboard_out_queue_read_index)%KEYBOARD_OUT_QUEUE_LENGTH;
+#if USB_VENDOR_INTERFACE
+	if(keyboard_vendor_is_active()) {
+		// What's left for a helper that has gone away is never sent
+		count += keyboard_vendor_get_queued_reports() + (keyboard_vendor_queue[keyboard_vendor_queue_write_index].length != 0);
 	}
+#endif
+	return count;
 }
 
-void keyboard_write_codepoint(enum keyboard_output_mode mode, uint32_t codepoint) {
+// Never blocks. Returns 1 if the codepoint is queued for being typed out, or 0 if there isn't enough room in the queue,
+// in which case nothing is queued. See keyboard_is_writable()
+uint8_t keyboard_write_codepoint(enum keyboard_output_mode mode, uint32_t codepoint) {
 	uint8_t force_trailing_space = 0;
 	if(mode == KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE) {
 		force_trailing_space = 1;
@@ -400,90 +1004,70 @@ void keyboard_write_codepoint(enum keyboard_output_mode mode, uint32_t codepoint
 		if(codepoint <= 0x7F || (codepoint >= LOOKUP_CODEPAGE_1_START && codepoint < LOOKUP_CODEPAGE_1_START+LOOKUP_CODEPAGE_1_LENGTH)) {
 			// Force latin mode for first 128 codepoints (ASCII) and for codepage 1 (ASCII string)
 			mode = KEYBOARD_OUTPUT_MODE_LATIN;
+#if USB_VENDOR_INTERFACE
+		} else if(mode != KEYBOARD_OUTPUT_MODE_LATIN && keyboard_vendor_is_active() && keyboard_out_queue_read_index == keyboard_out_queue_write_index) {
+			// The helper on the host types it. It's only done while nothing is pending on the keyboard, so that the text
+			// stays in order. The keyboard in turn waits for the vendor interface in keyboard_loop().
+			size_t length = 1;
+			const uint32_t *str = &codepoint;
+			if(codepoint >= LOOKUP_CODEPAGE_2_START && codepoint < LOOKUP_CODEPAGE_2_START+LOOKUP_CODEPAGE_2_LENGTH) {
+				str = lookup_get_unicode_string(2, codepoint-LOOKUP_CODEPAGE_2_START);
+				for(length=0; str[length]; length++);
+			}
+			// All or nothing. 4 bytes at most per codepoint.
+			if(keyboard_vendor_get_free_bytes() < length*4) {
+				return 0;
+			}
+			for(size_t i=0; i<length; i++) {
+				keyboard_vendor_push_codepoint(str[i]);
+			}
+			return 1;
+#endif
+		} else if(KEYBOARD_COMPOSE_MODE && mode == KEYBOARD_OUTPUT_MODE_COMPOSE) {
+			// Each glyph of codepage 0 and each string of codepage 2 has its own compose sequence. It's typed by the index.
+			if(codepoint >= LOOKUP_CODEPAGE_0_START && codepoint < LOOKUP_CODEPAGE_0_START+LOOKUP_CODEPAGE_0_LENGTH) {
+				codepoint -= LOOKUP_CODEPAGE_0_START;
+			} else if(codepoint >= LOOKUP_CODEPAGE_2_START && codepoint < LOOKUP_CODEPAGE_2_START+LOOKUP_CODEPAGE_2_LENGTH) {
+				codepoint = KEYBOARD_COMPOSE_CODEPAGE_2_INDEX+codepoint-LOOKUP_CODEPAGE_2_START;
+			} else {
+				// No compose sequence for that. Let latin mode handle it.
+				mode = KEYBOARD_OUTPUT_MODE_LATIN;
+			}
 		} else if (codepoint >= LOOKUP_CODEPAGE_2_START && codepoint < LOOKUP_CODEPAGE_2_START+LOOKUP_CODEPAGE_2_LENGTH) {
 			// For codepage 2, type out each of the unicode codepoint inside the array one-by-one
 			uint32_t charcter_id = codepoint-LOOKUP_CODEPAGE_2_START;
 			const uint32_t *str = lookup_get_unicode_string(2, charcter_id);
+			size_t length = 0;
+			while(str[length]) {
+				length++;
+			}
+			// All or nothing
+			if(keyboard_out_queue_get_free_count() < length) {
+				return 0;
+			}
 			while(*str) {
 				keyboard_write_codepoint(mode, *str);
 				str++;
 			}
-			return;
+			return 1;
 		}
+	} else if(mode != KEYBOARD_OUTPUT_MODE_DELAY) {
+		while(1); // Should never happen!
 	}
 
-	// Send start of packet with mode information
-	keyboard_push_to_out_buffer(KEYBOARD_MODE_START+mode);
-
-	switch(mode) {
-		case KEYBOARD_OUTPUT_MODE_LATIN:
-			if(codepoint <= 0x7F) {
-				// direct output - no conversion needed
-				keyboard_push_to_out_buffer(codepoint);
-
-				// Force adding trailing spcace with KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE
-				if(force_trailing_space && (codepoint != ' ' && codepoint != '\n')) {
-					keyboard_push_to_out_buffer(' ');
-				}
-			} else if(codepoint >= LOOKUP_CODEPAGE_0_START &&
-				codepoint < LOOKUP_CODEPAGE_0_START+LOOKUP_CODEPAGE_0_LENGTH) {
-				// Convert sitelen pona codepoint to sitelen Lasin
-				keyboard_write_ascii_string(0, codepoint-LOOKUP_CODEPAGE_0_START, force_trailing_space);
-			} else if(codepoint >= LOOKUP_CODEPAGE_1_START &&
-				codepoint < LOOKUP_CODEPAGE_1_START+LOOKUP_CODEPAGE_1_LENGTH) {
-				// Convert codepage 1 codepoint to sitelen Lasin
-				keyboard_write_ascii_string(1, codepoint-LOOKUP_CODEPAGE_1_START, force_trailing_space);
-			} else {
-				switch(codepoint){
-					case 0x3000:
-						keyboard_push_to_out_buffer(' ');
-					break;
-					default:
-						// Unsupported codepoint. Let's output a questionmark.
-						keyboard_push_to_out_buffer('?');
-					break;
-				}
-			}
-		break;
-		case KEYBOARD_OUTPUT_MODE_WINDOWS:
-			// Send the codepoint as hex
-			keyboard_push_to_out_buffer('u'); // Press enter after complete entering the unicode
-			keyboard_push_hex_to_out_buffer(codepoint, 0);
-			keyboard_push_to_out_buffer('\n'); // Press enter after complete entering the unicode
-		break;
-		case KEYBOARD_OUTPUT_MODE_LINUX:
-			// Send the codepoint as hex
-			keyboard_push_hex_to_out_buffer(codepoint, 1);
-			keyboard_push_to_out_buffer(' '); // Press space after complete entering the unicode
-		break;
-		case KEYBOARD_OUTPUT_MODE_MACOS:
-			// Send the codepoint as hex in UTF-16 encoding
-			uint32_t utf16_codepoint;
-			if(codepoint <= 0xFFFF) {
-				utf16_codepoint = codepoint;
-			} else if (codepoint <= 0x10FFFF) {
-				uint32_t codepoint_base = codepoint - 0x10000U;
-				utf16_codepoint = ((0xD800 | ((codepoint_base & (0x3FF<<10)) >> 10)) << 16) | (0xDC00 | (codepoint_base & 0x3FF));
-			} else {
-				// Outside of UTF-16's range. Let's fill in a middle finger emoji
-				utf16_codepoint = 0xD83DDD95;
-			}
-			keyboard_push_hex_to_out_buffer(utf16_codepoint, 0);
-		break;
-		case KEYBOARD_OUTPUT_MODE_DELAY:
-			keyboard_push_to_out_buffer(codepoint);
-		break;
-		case KEYBOARD_OUTPUT_MODE_END:
-		case KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE:
-			while(1); // Should never happen!
-		break;
+	if(!keyboard_out_queue_get_free_count()) {
+		return 0;
 	}
-
-	// Send end of packet with mode information
-	keyboard_push_to_out_buffer(KEYBOARD_MODE_START+KEYBOARD_OUTPUT_MODE_END);
+	// keyboard_loop() turns it into reports for the ISR
+	keyboard_push_to_out_queue(mode, codepoint, force_trailing_space);
+	return 1;
 }
 
 void keyboard_init(void) {
+	memset(&keyboard_lock_handshake, 0, sizeof(keyboard_lock_handshake)); // Learn the host from scratch
+#if USB_VENDOR_INTERFACE
+	keyboard_vendor_helper_announced = 0; // The helper announces itself again after the enumeration
+#endif
 	Delay_Ms(1); // Ensures USB re-enumeration after bootloader or reset; Spec demand >2.5us ( TDDIS )
 	usb_setup();
 }
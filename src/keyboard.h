@@ -25,24 +25,68 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdint.h>
+#include <stddef.h>
 
 enum keyboard_output_mode {
 	KEYBOARD_OUTPUT_MODE_LATIN,
 	KEYBOARD_OUTPUT_MODE_WINDOWS,
 	KEYBOARD_OUTPUT_MODE_LINUX,
 	KEYBOARD_OUTPUT_MODE_MACOS,
-	// Upon detection in keyboard_out_buffer, perform teardown action. Not an actual usable output mode by user
+	// Short compose sequences with Right Alt as the compose key. Requires the compose files generated by
+	// generate_lookup_table.py to be installed on the host (XCompose or WinCompose). See src/compose/
+	KEYBOARD_OUTPUT_MODE_COMPOSE,
+	// Upon detection in the output stream of the ISR, perform teardown action. Not an actual usable output mode by user
 	KEYBOARD_OUTPUT_MODE_END,
 
 	// Special modes that can be passed into keyboard_write_codepoint, but inaccessible via the config menu:
 
-	// For adding trailing space in LATIN mode, not passed into keyboard_out_buffer
+	// For adding trailing space in LATIN mode, not passed into keyboard_out_queue
 	KEYBOARD_OUTPUT_MODE_LATIN_WITH_TRAILING_SPACE,
-	// For making a delay, passed into keyboard_out_buffer
+	// For making a delay, passed into keyboard_out_queue
 	// There's a bug on linux ibus that, after sending out a glyph and pressing enter immediately,
 	// the glyph might be double-entered. It happens more often with low-end computers.
 	KEYBOARD_OUTPUT_MODE_DELAY,
 };
 
+// Keyboard layout of the host, for typing the ASCII characters. Not used by KEYBOARD_OUTPUT_MODE_MACOS: Unicode Hex
+// Input is a layout by itself. Only the characters typed by the firmware are covered. See LAYOUTS in generate_lookup_table.py
+enum keyboard_layout {
+	KEYBOARD_LAYOUT_QWERTY, // US
+	KEYBOARD_LAYOUT_AZERTY, // French
+	KEYBOARD_LAYOUT_QWERTZ, // German
+	KEYBOARD_LAYOUT_CZECH, // Czech QWERTZ, which types the digits with shift
+	KEYBOARD_LAYOUT_DVORAK, // US Dvorak
+	KEYBOARD_LAYOUT_END,
+};
+
+// 1: KEYBOARD_OUTPUT_MODE_COMPOSE can be picked in the config scene. It takes about 200 bytes of flash, which doesn't fit
+// along with the rest.
+#ifndef KEYBOARD_COMPOSE_MODE
+#define KEYBOARD_COMPOSE_MODE (0)
+#endif
+
+// 1: The layouts after KEYBOARD_LAYOUT_QWERTY can be picked with the W key of the config scene. Otherwise the host is
+// always taken as KEYBOARD_LAYOUT_QWERTY. They take about 500 bytes of flash, which doesn't fit along with the rest.
+#ifndef KEYBOARD_HOST_LAYOUTS
+#define KEYBOARD_HOST_LAYOUTS (0)
+#endif
+
+// Codepoints queued by the largest action of the user: a string of codepage 2, the delay and the enter
+// after it. Must be at least the longest string of LOOKUP_CODEPAGE_2 plus 2.
+#define KEYBOARD_WRITE_LENGTH_MAX (6U)
+
+// Counters of the polls of the keyboard endpoint
+struct keyboard_usb_stats {
+	uint32_t reports_sent;
+	uint32_t naks; // Polls without a new report
+	uint32_t vendor_reports_sent; // Reports sent on the vendor endpoint
+	uint32_t lock_wait_polls; // Polls spent waiting for the host to take the lock keys, including the ones releasing them
+};
+
 void keyboard_init(void);
-void keyboard_write_codepoint(enum keyboard_output_mode mode, uint32_t codepoint);
+void keyboard_loop(void);
+uint8_t keyboard_write_codepoint(enum keyboard_output_mode mode, uint32_t codepoint);
+void keyboard_set_layout(enum keyboard_layout layout);
+uint8_t keyboard_is_writable(void);
+size_t keyboard_get_pending_count(void);
+extern struct keyboard_usb_stats keyboard_usb_stats;
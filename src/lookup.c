@@ -98,6 +98,40 @@ static uint32_t encode_input_buffer_as_u24(uint8_t input_buffer[6], size_t input
 	return ret;
 }
 
+#if LOOKUP_PERFECT_HASH
+// Hash function of the minimal perfect hash. Must match lookup_hash() of generate_lookup_table.py
+// Shift-and-add only because RV32EC doesn't have hardware multiplication.
+static uint32_t lookup_hash(uint32_t key, uint32_t seed) {
+	uint32_t a = key ^ seed;
+	a = (a + 0x7ED55D16U) + (a << 12);
+	a = (a ^ 0xC761C23CU) ^ (a >> 19);
+	a = (a + 0x165667B1U) + (a << 5);
+	a = (a + 0xD3A2646CU) ^ (a << 9);
+	a = (a + 0xFD7046C5U) + (a << 3);
+	a = (a ^ 0xB55A4F09U) ^ (a >> 16);
+	return a;
+}
+
+// Returns the only slot of the table that could contain the key. The caller has to compare the entry of that slot with the key.
+static size_t lookup_hash_slot(uint32_t key, const struct lookup_perfect_hash *perfect_hash, size_t table_length) {
+	uint32_t h = lookup_hash(key, perfect_hash->seed);
+	size_t slot = ((h >> 16) & perfect_hash->slot_mask) + perfect_hash->displacement[h & perfect_hash->displacement_mask];
+	// slot < 3*table_length. Equivalent to slot %= table_length, which would be a software division on RV32EC
+	if(slot >= table_length) {
+		slot -= table_length;
+	}
+	if(slot >= table_length) {
+		slot -= table_length;
+	}
+	return slot;
+}
+
+// Folds the 52-bit input into the 32-bit key of lookup_hash_slot(). Must match lookup_hash_fold_u52() of generate_lookup_table.py
+static uint32_t lookup_hash_fold_u52(uint64_t input_u52) {
+	return (uint32_t)(input_u52 ^ (input_u52 >> 24));
+}
+#endif
+
 uint32_t lookup_search(uint8_t input_buffer[12], size_t input_buffer_length) {
 	if(input_buffer_length <= 0 || input_buffer_length > 12) {
 		return 0;
@@ -107,58 +141,139 @@ uint32_t lookup_search(uint8_t input_buffer[12], size_t input_buffer_length) {
 	uint32_t target = encode_input_buffer_as_u24(input_buffer, input_buffer_length);
 	// Only check COMPACT_TABLE if the input criteria has been met (such that encode_input_buffer_as_u24() returns a valid value)
 	if(target != 0) {
+#if LOOKUP_PERFECT_HASH
+		const struct lookup_compact_entry *entry = &LOOKUP_COMPACT_TABLE[lookup_hash_slot(target, &LOOKUP_COMPACT_TABLE_HASH, LOOKUP_COMPACT_TABLE_LENGTH)];
+		if(target == entry->input) {
+			ret = LOOKUP_CODEPAGE_0_START + entry->sitelen_pona_id;
+		}
+#else
 		for(size_t i=0; i<LOOKUP_COMPACT_TABLE_LENGTH; i++) {
 			if(target == LOOKUP_COMPACT_TABLE[i].input) {
 				ret = LOOKUP_CODEPAGE_0_START + LOOKUP_COMPACT_TABLE[i].sitelen_pona_id;
+				break;
 			}
 		}
+#endif
 	}
 
 	// Couldn't find the entry in LOOKUP_COMPACT_TABLE. Let's check the other more complicated table
 	if(!ret) {
 		uint64_t target = encode_input_buffer_as_u52(input_buffer, input_buffer_length);
+#if LOOKUP_PERFECT_HASH
+		const struct lookup_full_entry *entry = &LOOKUP_FULL_TABLE[lookup_hash_slot(lookup_hash_fold_u52(target), &LOOKUP_FULL_TABLE_HASH, LOOKUP_FULL_TABLE_LENGTH)];
+#else
+		const struct lookup_full_entry *entry = NULL;
 		for(size_t i=0; i<LOOKUP_FULL_TABLE_LENGTH; i++) {
 			if(target == LOOKUP_FULL_TABLE[i].input_u52) {
-				switch(LOOKUP_FULL_TABLE[i].codepage) {
-					case 0:
-						ret = LOOKUP_CODEPAGE_0_START + LOOKUP_FULL_TABLE[i].code_id;
-					break;
-					case 1:
-						ret = LOOKUP_CODEPAGE_1_START + LOOKUP_FULL_TABLE[i].code_id;
-					break;
-					case 2:
-						ret = LOOKUP_CODEPAGE_2_START + LOOKUP_FULL_TABLE[i].code_id;
-					break;
-					case 3:
-						ret = 0; // Reserved for future use
-					break;
-				}
+				entry = &LOOKUP_FULL_TABLE[i];
+				break;
+			}
+		}
+#endif
+		if(entry && target == entry->input_u52) {
+			switch(entry->codepage) {
+				case 0:
+					ret = LOOKUP_CODEPAGE_0_START + entry->code_id;
+				break;
+				case 1:
+					ret = LOOKUP_CODEPAGE_1_START + entry->code_id;
+				break;
+				case 2:
+					ret = LOOKUP_CODEPAGE_2_START + entry->code_id;
+				break;
+				case 3:
+					ret = 0; // Reserved for future use
+				break;
 			}
 		}
 	}
 	return ret;
 }
 
-const char* lookup_get_ascii_string(uint8_t codepage, size_t index) {
-	const char *ret = NULL;
+// Returns the node reached by typing key_id after node, or LOOKUP_TRIE_DEAD_END if no input sequence continues with that key
+uint16_t lookup_trie_next(uint16_t node, uint8_t key_id) {
+	if(node == LOOKUP_TRIE_DEAD_END) {
+		return LOOKUP_TRIE_DEAD_END;
+	}
+	uint16_t child = LOOKUP_TRIE[node] >> LOOKUP_TRIE_FIRST_CHILD_SHIFT;
+	if(child == 0) {
+		// No child. The root is never a child so 0 can be used for that.
+		return LOOKUP_TRIE_DEAD_END;
+	}
+	// The children are sorted by key_id
+	while(1) {
+		uint16_t child_node = LOOKUP_TRIE[child];
+		if((child_node & LOOKUP_TRIE_KEY_ID_MASK) == key_id) {
+			return child;
+		}
+		if((child_node & LOOKUP_TRIE_LAST_SIBLING) || (child_node & LOOKUP_TRIE_KEY_ID_MASK) > key_id) {
+			return LOOKUP_TRIE_DEAD_END;
+		}
+		child++;
+	}
+}
+
+// Returns 1 if lookup_search() would find the input sequence that leads to this node
+uint8_t lookup_trie_is_terminal(uint16_t node) {
+	return node != LOOKUP_TRIE_DEAD_END && (LOOKUP_TRIE[node] & LOOKUP_TRIE_TERMINAL);
+}
+
+// Returns 1 if the input sequence that leads to this node is complete, and no longer input sequence starts with it.
+// i.e. the glyph can be sent out right away without waiting for ALA/PANA
+uint8_t lookup_trie_is_unambiguous(uint16_t node) {
+	return lookup_trie_is_terminal(node) && !(LOOKUP_TRIE[node] >> LOOKUP_TRIE_FIRST_CHILD_SHIFT);
+}
+
+// Points str to the beginning of the string. Read it with lookup_ascii_string_next().
+// Returns 0 if the codepage doesn't have ASCII strings.
+uint8_t lookup_get_ascii_string(struct lookup_ascii_string *str, uint8_t codepage, size_t index) {
+	const uint16_t *checkpoint = NULL;
+	const uint8_t *offset = NULL;
 	switch(codepage) {
 		case 0:
-			ret = LOOKUP_CODEPAGE_0;
+			str->data = LOOKUP_CODEPAGE_0;
+			checkpoint = LOOKUP_CODEPAGE_0_CHECKPOINT;
+			offset = LOOKUP_CODEPAGE_0_OFFSET;
 		break;
 		case 1:
-			ret = LOOKUP_CODEPAGE_1;
+			str->data = LOOKUP_CODEPAGE_1;
+			checkpoint = LOOKUP_CODEPAGE_1_CHECKPOINT;
+			offset = LOOKUP_CODEPAGE_1_OFFSET;
 		break;
 		default:
-			return NULL;
+			return 0;
 	}
 
-	// Scroll past #index amount of NULL terminators, then return the string
-	while(index--) {
-		while(*ret++);
-	}
+	// Instead of scrolling past #index amount of strings, jump to the checkpoint of the string, then to the string itself.
+	str->position = (checkpoint[index/LOOKUP_STRING_CHECKPOINT_INTERVAL] + offset[index]) * LOOKUP_ASCII_STRING_SYMBOL_BITS;
+	return 1;
+}
+
+static uint8_t lookup_ascii_string_read_symbol(struct lookup_ascii_string *str) {
+	// A symbol spans at most 2 bytes. The generator pads the data with an extra byte for reading the last symbol.
+	const uint8_t *ptr = &str->data[str->position/8];
+	uint8_t ret = ((ptr[0] | (ptr[1]<<8)) >> (str->position%8)) & ((1U<<LOOKUP_ASCII_STRING_SYMBOL_BITS)-1);
+	str->position += LOOKUP_ASCII_STRING_SYMBOL_BITS;
 	return ret;
 }
 
+// Decodes the next character of the string. Returns '\0' at the end of the string, and keeps doing so if called again.
+// Symbols: 0 is the end, 1~26 are 'a'~'z', 27~30 are LOOKUP_ASCII_STRING_EXTRA_SYMBOLS,
+// and 31 is followed by 2 symbols carrying the upper 2 bits and the lower 5 bits of any other ASCII character.
+char lookup_ascii_string_next(struct lookup_ascii_string *str) {
+	uint8_t symbol = lookup_ascii_string_read_symbol(str);
+	if(symbol == 0) {
+		str->position -= LOOKUP_ASCII_STRING_SYMBOL_BITS;
+		return '\0';
+	} else if(symbol < LOOKUP_ASCII_STRING_SYMBOL_EXTRA) {
+		return 'a'+symbol-1;
+	} else if(symbol < LOOKUP_ASCII_STRING_SYMBOL_ESCAPE) {
+		return LOOKUP_ASCII_STRING_EXTRA_SYMBOLS[symbol-LOOKUP_ASCII_STRING_SYMBOL_EXTRA];
+	}
+	char ret = lookup_ascii_string_read_symbol(str) << LOOKUP_ASCII_STRING_SYMBOL_BITS;
+	return ret | lookup_ascii_string_read_symbol(str);
+}
+
 const uint32_t* lookup_get_unicode_string(uint8_t codepage, size_t index) {
 	if(codepage == 2) {
 		return LOOKUP_CODEPAGE_2[index];
@@ -166,20 +281,20 @@ const uint32_t* lookup_get_unicode_string(uint8_t codepage, size_t index) {
 	return NULL;
 }
 
-static uint8_t lookup_get_nibble(const uint8_t *array, size_t index) {
-	if(index%2 == 1) {
-		return (array[index/2] >>4 ) & 0x0F;
-	}
-	return array[index/2] & 0x0F;
-}
+// The payload of the compressed images is read with aligned 32-bit loads: up to 3 bytes in front of the payload, and up
+// to the word after the one with the last bit. The FONT_CODEPAGE_* arrays are word-aligned, and padded with a word more
+// than needed for a multiple of 4 bytes, so that these loads stay inside of the array without checking for the end.
+// may_alias: the data is defined as an array of uint8_t.
+typedef uint32_t __attribute__((__may_alias__)) lookup_word_t;
 
-static void lookup_decompress_image(uint16_t image[LOOKUP_IMAGE_WIDTH], const uint8_t *compressed_data) {
-	size_t payload_length = (compressed_data[0] & 0x1F)*2; // Unit: nibbles
+// See font_compress() in generate_lookup_table.py for the format
+void lookup_decompress_image(uint16_t image[LOOKUP_IMAGE_WIDTH], const uint8_t *compressed_data) {
+	size_t payload_size = (compressed_data[0] & 0x1F)*8; // Unit: bits
 	size_t start_col = (compressed_data[0] & 0xE0) >> 5;
 	size_t current_col = start_col;
 	size_t end_col = LOOKUP_IMAGE_WIDTH-start_col; // Exclusive!
 
-	if(payload_length == 0) {
+	if(payload_size == 0) {
 		memset(image, 0, sizeof(*image)*LOOKUP_IMAGE_WIDTH);
 		return;
 	}
@@ -190,25 +305,49 @@ static void lookup_decompress_image(uint16_t image[LOOKUP_IMAGE_WIDTH], const ui
 		image[LOOKUP_IMAGE_WIDTH-1-i] = 0x00;
 	}
 
-	static uint16_t dictionary[8];
-	size_t dictionary_index = 0;
-	size_t i=0;
-	while(i < payload_length && current_col < end_col) {
-		if(lookup_get_nibble(&compressed_data[1], i) & 0x01) {
-			// Dictionary-mapped column
-			image[current_col++] = dictionary[lookup_get_nibble(&compressed_data[1], i++) >> 1];
-		} else if(i+1 < payload_length) {
-			// Non-dictionary mapped column
-			image[current_col] = lookup_get_nibble(&compressed_data[1], i++);
-			image[current_col] |= lookup_get_nibble(&compressed_data[1], i++) << 4;
-			image[current_col] |= lookup_get_nibble(&compressed_data[1], i++) << 8;
-			image[current_col] |= lookup_get_nibble(&compressed_data[1], i++) << 12;
-			image[current_col] >>= 1;
-			dictionary[dictionary_index++%8] = image[current_col++];
+	// The bits are counted from the word-aligned address in front of the payload. Bit #i is bit i%32 of word #i/32
+	// because both the bitstream and the words are little-endian.
+	size_t misalignment = (uintptr_t)&compressed_data[1] & 0x03;
+	const lookup_word_t *words = (const lookup_word_t*)(&compressed_data[1] - misalignment);
+	size_t i = misalignment*8;
+	size_t end = i+payload_size;
+	uint32_t dictionary_index_mask = (1U << FONT_DICTIONARY_INDEX_BITS) - 1;
+
+	static uint16_t rolling_dictionary[8];
+	size_t rolling_dictionary_index = 0;
+	while(current_col < end_col) {
+		// The next 17 bits from bit #i, the longest code. The ones past the end of the payload are garbage.
+		size_t shift = i%32;
+		uint32_t bits = words[i/32] >> shift;
+		if(shift > 32-17) {
+			bits |= words[i/32+1] << (32-shift);
+		}
+
+		if(bits & 0x01) {
+			// Rolling dictionary
+			if(i+1+3 > end) {
+				break;
+			}
+			image[current_col++] = rolling_dictionary[(bits >> 1) & 0x07];
+			i += 1+3;
+			continue;
+		} else if(bits & 0x02) {
+			// Global dictionary
+			if(i+2+FONT_DICTIONARY_INDEX_BITS > end) {
+				break;
+			}
+			image[current_col] = FONT_DICTIONARY[(bits >> 2) & dictionary_index_mask];
+			i += 2+FONT_DICTIONARY_INDEX_BITS;
 		} else {
-			// Final padding nibble for aligning to 8 bytes. Ignore!
-			break;
+			// Column stored as-is
+			if(i+2+15 > end) {
+				// Padding of the final byte. Ignore!
+				break;
+			}
+			image[current_col] = (bits >> 2) & 0x7FFF;
+			i += 2+15;
 		}
+		rolling_dictionary[rolling_dictionary_index++%8] = image[current_col++];
 	}
 
 	if(current_col == 8) {
@@ -220,8 +359,10 @@ static void lookup_decompress_image(uint16_t image[LOOKUP_IMAGE_WIDTH], const ui
 	}
 }
 
-static const uint8_t* lookup_get_image_ptr_by_index(const uint8_t *data_array, size_t index) {
-	const uint8_t *ret = data_array;
+// The images are variable-length. Jump to the checkpoint, then walk through the remaining images.
+static const uint8_t* lookup_get_image_ptr_by_index(const uint8_t *data_array, const uint16_t *checkpoint, size_t index) {
+	const uint8_t *ret = data_array + checkpoint[index/LOOKUP_FONT_CHECKPOINT_INTERVAL];
+	index %= LOOKUP_FONT_CHECKPOINT_INTERVAL;
 	while(index--) {
 		ret += (ret[0] & 0x1F) + 1;
 	}
@@ -231,13 +372,13 @@ static const uint8_t* lookup_get_image_ptr_by_index(const uint8_t *data_array, s
 void lookup_get_image(uint16_t image[LOOKUP_IMAGE_WIDTH], uint32_t codepoint) {
 	const uint8_t *font_data_ptr;
 	if(codepoint >= LOOKUP_CODEPAGE_0_START && codepoint < LOOKUP_CODEPAGE_0_START+LOOKUP_CODEPAGE_0_LENGTH) {
-		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_0, codepoint-LOOKUP_CODEPAGE_0_START);
+		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_0, FONT_CODEPAGE_0_CHECKPOINT, codepoint-LOOKUP_CODEPAGE_0_START);
 	} else if(codepoint >= LOOKUP_CODEPAGE_1_START && codepoint < LOOKUP_CODEPAGE_1_START+LOOKUP_CODEPAGE_1_LENGTH) {
-		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_1, codepoint-LOOKUP_CODEPAGE_1_START);
+		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_1, FONT_CODEPAGE_1_CHECKPOINT, codepoint-LOOKUP_CODEPAGE_1_START);
 	} else if(codepoint >= LOOKUP_CODEPAGE_2_START && codepoint < LOOKUP_CODEPAGE_2_START+LOOKUP_CODEPAGE_2_LENGTH) {
-		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_2, codepoint-LOOKUP_CODEPAGE_2_START);
+		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_2, FONT_CODEPAGE_2_CHECKPOINT, codepoint-LOOKUP_CODEPAGE_2_START);
 	} else if(codepoint >= LOOKUP_CODEPAGE_3_START && codepoint < LOOKUP_CODEPAGE_3_START+LOOKUP_CODEPAGE_3_LENGTH) {
-		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_3, codepoint-LOOKUP_CODEPAGE_3_START);
+		font_data_ptr = lookup_get_image_ptr_by_index(FONT_CODEPAGE_3, FONT_CODEPAGE_3_CHECKPOINT, codepoint-LOOKUP_CODEPAGE_3_START);
 	} else {
 		memset(image, 0, 15*2);
 		return;
@@ -32,6 +32,20 @@
 
 #define LOOKUP_INPUT_LENGTH_MAX (12)
 
+// 0: The input sequence is looked up with lookup_search() each time it changes.
+// 1: ilonena.c also walks LOOKUP_TRIE with each key typed. It shows the dead ends of the input sequence, and offers the
+// eager commit (the E key of the config scene). It takes about 1KB more flash, which doesn't fit along with the rest.
+#ifndef LOOKUP_INCREMENTAL
+#define LOOKUP_INCREMENTAL (0)
+#endif
+
+// 0: lookup_search() scans the lookup tables. It takes about 5000 cycles per key typed, i.e. 0.1ms.
+// 1: lookup_search() finds the only slot of the tables that could match with the perfect hash, about 30 times faster.
+// It takes about 300 bytes more flash, which doesn't fit along with the rest.
+#ifndef LOOKUP_PERFECT_HASH
+#define LOOKUP_PERFECT_HASH (0)
+#endif
+
 enum ilonena_key_id {
 	ILONENA_KEY_NONE,
 	ILONENA_KEY_1,
@@ -87,6 +101,12 @@ enum internal_image {
 	INTERNAL_IMAGE_PUNCTUATION_SITELEN_PONA_PART2,
 	INTERNAL_IMAGE_PUNCTUATION_LATIN_TRAILING_SPACE_PART1,
 	INTERNAL_IMAGE_PUNCTUATION_LATIN_TRAILING_SPACE_PART2,
+	INTERNAL_IMAGE_COMPOSE,
+	INTERNAL_IMAGE_LAYOUT_QWERTY,
+	INTERNAL_IMAGE_LAYOUT_AZERTY,
+	INTERNAL_IMAGE_LAYOUT_QWERTZ,
+	INTERNAL_IMAGE_LAYOUT_CZECH,
+	INTERNAL_IMAGE_LAYOUT_DVORAK,
 	INTERNAL_IMAGE_NUM,
 };
 
@@ -107,10 +127,48 @@ struct __attribute__((__packed__)) lookup_full_entry {
 	uint8_t code_id;
 };
 
+// Minimal perfect hash of a lookup table. The entries of the table are stored in their slot order. See lookup_hash_slot()
+struct lookup_perfect_hash {
+	uint32_t seed;
+	uint32_t slot_mask; // (Smallest power of 2 that's >= table length)-1
+	const uint8_t *displacement; // Indexed by bucket. Added to the slot of each key in the bucket.
+	uint32_t displacement_mask; // (Length of displacement)-1. The length is a power of 2.
+};
+
+// Incremental lookup: each key typed is a transition in LOOKUP_TRIE. Start from LOOKUP_TRIE_ROOT.
+// The trie tells whether the keys typed are a complete input sequence, a prefix of one, or a dead end. It doesn't
+// store the codepoints, that would take 2 more bytes of flash per node. lookup_search() finds them.
+#define LOOKUP_TRIE_ROOT (0U)
+#define LOOKUP_TRIE_DEAD_END (0xFFFFU) // No input sequence could be completed from here
+#define LOOKUP_TRIE_KEY_ID_MASK (0x1FU)
+#define LOOKUP_TRIE_LAST_SIBLING (1U<<5)
+#define LOOKUP_TRIE_TERMINAL (1U<<6) // The keys typed so far is a complete input sequence
+#define LOOKUP_TRIE_FIRST_CHILD_SHIFT (7U)
+
+// Offset index of the strings of codepage 0 and 1: a checkpoint every LOOKUP_STRING_CHECKPOINT_INTERVAL strings. Unit: symbols
+#define LOOKUP_STRING_CHECKPOINT_INTERVAL (16U)
+// The strings of codepage 0 and 1 are packed into 5-bit symbols. See lookup_ascii_string_next()
+#define LOOKUP_ASCII_STRING_SYMBOL_BITS (5U)
+#define LOOKUP_ASCII_STRING_SYMBOL_EXTRA (27U)
+#define LOOKUP_ASCII_STRING_SYMBOL_ESCAPE (31U)
+// Offset index of the compressed images of each codepage: a checkpoint every LOOKUP_FONT_CHECKPOINT_INTERVAL images
+#define LOOKUP_FONT_CHECKPOINT_INTERVAL (8U)
+
+// Read position of a packed string of codepage 0 and 1
+struct lookup_ascii_string {
+	const uint8_t *data;
+	size_t position; // Unit: bits
+};
+
 uint32_t lookup_search(uint8_t input_buffer[LOOKUP_INPUT_LENGTH_MAX], size_t input_buffer_length);
-const char* lookup_get_ascii_string(uint8_t codepage, size_t index);
+uint16_t lookup_trie_next(uint16_t node, uint8_t key_id);
+uint8_t lookup_trie_is_terminal(uint16_t node);
+uint8_t lookup_trie_is_unambiguous(uint16_t node);
+uint8_t lookup_get_ascii_string(struct lookup_ascii_string *str, uint8_t codepage, size_t index);
+char lookup_ascii_string_next(struct lookup_ascii_string *str);
 const uint32_t* lookup_get_unicode_string(uint8_t codepage, size_t index);
  void lookup_get_image(uint16_t image[LOOKUP_IMAGE_WIDTH], uint32_t codepoint);
+void lookup_decompress_image(uint16_t image[LOOKUP_IMAGE_WIDTH], const uint8_t *compressed_data);
 
 // All of the variables below this point are defined in generated.c
 extern const uint32_t LOOKUP_CODEPAGE_0_START;
@@ -121,18 +179,36 @@ extern const uint32_t LOOKUP_CODEPAGE_2_START;
 extern const size_t LOOKUP_CODEPAGE_2_LENGTH;
 extern const uint32_t LOOKUP_CODEPAGE_3_START;
 extern const size_t LOOKUP_CODEPAGE_3_LENGTH;
-extern const char *LOOKUP_CODEPAGE_0;
-extern const char *LOOKUP_CODEPAGE_1;
+extern const char LOOKUP_ASCII_STRING_EXTRA_SYMBOLS[];
+extern const uint8_t LOOKUP_CODEPAGE_0[];
+extern const uint8_t LOOKUP_CODEPAGE_1[];
+extern const uint16_t LOOKUP_CODEPAGE_0_CHECKPOINT[];
+extern const uint8_t LOOKUP_CODEPAGE_0_OFFSET[];
+extern const uint16_t LOOKUP_CODEPAGE_1_CHECKPOINT[];
+extern const uint8_t LOOKUP_CODEPAGE_1_OFFSET[];
 extern const uint32_t *LOOKUP_CODEPAGE_2[];
 
 extern const struct lookup_compact_entry LOOKUP_COMPACT_TABLE[];
 extern const size_t LOOKUP_COMPACT_TABLE_LENGTH;
 extern const struct lookup_full_entry LOOKUP_FULL_TABLE[];
 extern const size_t LOOKUP_FULL_TABLE_LENGTH;
+extern const struct lookup_perfect_hash LOOKUP_COMPACT_TABLE_HASH;
+extern const struct lookup_perfect_hash LOOKUP_FULL_TABLE_HASH;
+extern const uint16_t LOOKUP_TRIE[];
+
+extern const char LOOKUP_LAYOUT_CHARS[];
+extern const size_t LOOKUP_LAYOUT_CHARS_LENGTH;
+extern const uint8_t LOOKUP_LAYOUT_KEYS[]; // LOOKUP_LAYOUT_CHARS_LENGTH keys for each layout after KEYBOARD_LAYOUT_QWERTY
 
+extern const uint8_t FONT_DICTIONARY_INDEX_BITS;
+extern const uint16_t FONT_DICTIONARY[];
 extern const uint8_t FONT_CODEPAGE_0[];
 extern const uint8_t FONT_CODEPAGE_1[];
 extern const uint8_t FONT_CODEPAGE_2[];
 extern const uint8_t FONT_CODEPAGE_3[];
+extern const uint16_t FONT_CODEPAGE_0_CHECKPOINT[];
+extern const uint16_t FONT_CODEPAGE_1_CHECKPOINT[];
+extern const uint16_t FONT_CODEPAGE_2_CHECKPOINT[];
+extern const uint16_t FONT_CODEPAGE_3_CHECKPOINT[];
 
 #endif
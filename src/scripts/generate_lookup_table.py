@@ -32,7 +32,7 @@ import yaml
 import PIL.Image, PIL.ImageDraw, PIL.ImageFont
 
 if len(sys.argv) < 4:
-	print("{sys.argv[0]} <kreativekorp_ucsur_charts_sitelen.html> <wakalito-7-3-2.yml> <lekolili15x15.ttf>")
+	print("{sys.argv[0]} <kreativekorp_ucsur_charts_sitelen.html> <wakalito-7-3-2.yml> <lekolili15x15.ttf> [compose_output_dir]")
 	exit(1)
 
 #####################
@@ -59,6 +59,7 @@ codepage_2 = []
 UNICODE_PATH = sys.argv[1]
 WAKALITO_PATH = sys.argv[2]
 FONT_PATH = sys.argv[3]
+COMPOSE_OUTPUT_DIR = sys.argv[4] if len(sys.argv) > 4 else None
 word_to_codepoint = {}
 
 SYMBOL_MAP = {
@@ -226,6 +227,232 @@ for word in wakalito_mapping['matches']:
 			raise Exception(f"Error: Duplicate trigger word detected: {i}")
 		wakalito_reversed_mapping[encoded_trigger_u52] = {"trigger": i, "trigger_u24": encoded_trigger_u24, "trigger_u52": encoded_trigger_u52, "word": c_style_escape(word['replace']), "codepage": codepage, "codepoint": codepoint}
 
+# Minimal perfect hash of the lookup tables. The C counterpart is lookup_hash_slot() in lookup.c. Both must match.
+# Hash-and-displace: the key is hashed into a bucket. Each bucket has a displacement value that's added to the
+# hash of the key, such that every key of the table lands on a distinct slot. The table entries are then stored
+# in the slot order, so that lookup_search() only needs to compare a single entry.
+LOOKUP_HASH_SEED_MAX = 5000
+
+def lookup_hash(key, seed):
+	# Shift-and-add only. RV32EC doesn't have hardware multiplication.
+	a = (key ^ seed) & 0xFFFFFFFF
+	a = ((a + 0x7ED55D16) + (a << 12)) & 0xFFFFFFFF
+	a = ((a ^ 0xC761C23C) ^ (a >> 19)) & 0xFFFFFFFF
+	a = ((a + 0x165667B1) + (a << 5)) & 0xFFFFFFFF
+	a = ((a + 0xD3A2646C) ^ (a << 9)) & 0xFFFFFFFF
+	a = ((a + 0xFD7046C5) + (a << 3)) & 0xFFFFFFFF
+	a = ((a ^ 0xB55A4F09) ^ (a >> 16)) & 0xFFFFFFFF
+	return a
+
+def lookup_hash_fold_u52(key):
+	return (key ^ (key >> 24)) & 0xFFFFFFFF
+
+def lookup_hash_slot(key, seed, slot_mask, displacement, table_length):
+	h = lookup_hash(key, seed)
+	slot = ((h >> 16) & slot_mask) + displacement[h & (len(displacement)-1)]
+	# slot < 3*table_length. Equivalent to slot %= table_length
+	if slot >= table_length:
+		slot -= table_length
+	if slot >= table_length:
+		slot -= table_length
+	return slot
+
+# Returns (seed, slot_mask, displacement). Picks the smallest displacement table that works.
+# names: the triggers of the keys, for the error messages
+def build_perfect_hash(keys, names):
+	# Keys with the same value can't be told apart by any seed
+	if len(set(keys)) != len(keys):
+		first = {}
+		for k, name in zip(keys, names):
+			if k in first:
+				raise Exception(f"Unable to build the perfect hash: the triggers {first[k]} and {name} have the same key 0x{k:X}")
+			first[k] = name
+	table_length = len(keys)
+	slot_mask = 1
+	while slot_mask < table_length:
+		slot_mask <<= 1
+	slot_mask -= 1
+	displacement_length = 1
+	while displacement_length*8 < table_length:
+		displacement_length <<= 1
+	# With a bucket per key or more, another doubling won't help
+	while displacement_length < 2*table_length:
+		for seed in range(LOOKUP_HASH_SEED_MAX):
+			buckets = {}
+			for k in keys:
+				h = lookup_hash(k, seed)
+				buckets.setdefault(h & (displacement_length-1), []).append((h >> 16) & slot_mask)
+			taken = [False]*table_length
+			displacement = [0]*displacement_length
+			# Place the largest buckets first
+			for b in sorted(buckets, key=lambda b: (-len(buckets[b]), b)):
+				for d in range(min(table_length, 256)):
+					slots = [(base+d)%table_length for base in buckets[b]]
+					if len(set(slots)) == len(slots) and not any(taken[i] for i in slots):
+						break
+				else:
+					break # Unable to place the bucket. Try the next seed.
+				for i in slots:
+					taken[i] = True
+				displacement[b] = d
+			else:
+				return (seed, slot_mask, displacement)
+		displacement_length <<= 1
+	raise Exception(f"Unable to build the perfect hash of {table_length} keys with up to {LOOKUP_HASH_SEED_MAX} seeds")
+
+wakalito_reversed_mapping_keys = sorted(wakalito_reversed_mapping)
+compact_table_keys = [k for k in wakalito_reversed_mapping_keys if wakalito_reversed_mapping[k]['trigger_u24']]
+full_table_keys = [k for k in wakalito_reversed_mapping_keys if wakalito_reversed_mapping[k]['trigger_u24'] == 0 and wakalito_reversed_mapping[k]['trigger_u52']]
+
+def sort_keys_by_slot(keys, hash_key, perfect_hash):
+	seed, slot_mask, displacement = perfect_hash
+	ret = [None]*len(keys)
+	for k in keys:
+		ret[lookup_hash_slot(hash_key(k), seed, slot_mask, displacement, len(keys))] = k
+	assert(None not in ret)
+	return ret
+
+compact_table_hash = build_perfect_hash([wakalito_reversed_mapping[k]['trigger_u24'] for k in compact_table_keys],
+	[wakalito_reversed_mapping[k]['trigger'] for k in compact_table_keys])
+compact_table_keys = sort_keys_by_slot(compact_table_keys, lambda k: wakalito_reversed_mapping[k]['trigger_u24'], compact_table_hash)
+full_table_hash = build_perfect_hash([lookup_hash_fold_u52(k) for k in full_table_keys],
+	[wakalito_reversed_mapping[k]['trigger'] for k in full_table_keys])
+full_table_keys = sort_keys_by_slot(full_table_keys, lookup_hash_fold_u52, full_table_hash)
+
+# Trie of all of the triggers, for the incremental lookup in the main loop. See lookup_trie_next() in lookup.c
+# The nodes are in breadth-first order such that the children of each node are contiguous. The root is node 0.
+# Format of each node (16-bit): first_child:9 (0 if there's no child), terminal:1, last_sibling:1, key_id:5
+LOOKUP_TRIE_LAST_SIBLING = 1 << 5
+LOOKUP_TRIE_TERMINAL = 1 << 6
+LOOKUP_TRIE_FIRST_CHILD_SHIFT = 7
+
+def build_trie(triggers):
+	# Each node: [prefix, key_id, {key_id: child}]
+	root = ['', 0, {}]
+	terminals = set(triggers)
+	for trigger in triggers:
+		node = root
+		for c in trigger:
+			key_id = WAKALITO_KEY_VALUES_FULL.find(c)
+			assert(key_id > 0)
+			node = node[2].setdefault(key_id, [node[0]+c, key_id, {}])
+	nodes = [root]
+	first_child = {}
+	i = 0
+	while i < len(nodes):
+		children = [nodes[i][2][k] for k in sorted(nodes[i][2])]
+		if children:
+			first_child[i] = len(nodes)
+		nodes.extend(children)
+		i += 1
+	assert(len(nodes) < (1 << (16-LOOKUP_TRIE_FIRST_CHILD_SHIFT)))
+	ret = []
+	parent_of = {}
+	for i in first_child:
+		for j in range(first_child[i], first_child[i]+len(nodes[i][2])):
+			parent_of[j] = i
+	for i, (prefix, key_id, children) in enumerate(nodes):
+		value = key_id | (first_child.get(i, 0) << LOOKUP_TRIE_FIRST_CHILD_SHIFT)
+		if prefix in terminals:
+			value |= LOOKUP_TRIE_TERMINAL
+		if i == 0 or i+1 == len(nodes) or parent_of.get(i+1) != parent_of.get(i):
+			value |= LOOKUP_TRIE_LAST_SIBLING
+		ret.append((value, prefix))
+	return ret
+
+lookup_trie = build_trie([wakalito_reversed_mapping[k]['trigger'] for k in wakalito_reversed_mapping_keys])
+
+# Packed strings of codepage 0 and 1. See lookup_ascii_string_next() in lookup.c
+# Each character is a 5-bit symbol. The symbols are read from the LSB of each byte:
+#   0 - end of the string
+#   1~26 - 'a'~'z'
+#   27~30 - LOOKUP_ASCII_STRING_EXTRA_SYMBOLS, the most frequent characters other than 'a'~'z'
+#   31 - escape. The next 2 symbols are the upper 2 bits and the lower 5 bits of an ASCII character.
+# There's a 16-bit checkpoint every LOOKUP_STRING_CHECKPOINT_INTERVAL strings, and an 8-bit offset from the checkpoint for each string.
+# Unit: symbols
+LOOKUP_STRING_CHECKPOINT_INTERVAL = 16 # Must match the one in lookup.h
+ASCII_STRING_SYMBOL_EXTRA = 27 # Must match LOOKUP_ASCII_STRING_SYMBOL_EXTRA in lookup.h
+ASCII_STRING_SYMBOL_ESCAPE = 31 # Must match LOOKUP_ASCII_STRING_SYMBOL_ESCAPE in lookup.h
+
+def build_ascii_string_extra_symbols(strings):
+	count = {}
+	for string in strings:
+		for c in string:
+			if not ('a' <= c <= 'z'):
+				count[c] = count.get(c, 0) + 1
+	ret = sorted(count, key=lambda c: (-count[c], c))[:ASCII_STRING_SYMBOL_ESCAPE-ASCII_STRING_SYMBOL_EXTRA]
+	return ''.join(ret).ljust(ASCII_STRING_SYMBOL_ESCAPE-ASCII_STRING_SYMBOL_EXTRA, ' ')
+
+def pack_ascii_string(string, extra_symbols):
+	ret = []
+	for c in string:
+		if 'a' <= c <= 'z':
+			ret.append(ord(c)-ord('a')+1)
+		elif c in extra_symbols:
+			ret.append(ASCII_STRING_SYMBOL_EXTRA+extra_symbols.index(c))
+		else:
+			assert(0 < ord(c) < 128)
+			ret += [ASCII_STRING_SYMBOL_ESCAPE, ord(c) >> 5, ord(c) & 0x1F]
+	return ret + [0]
+
+def unpack_ascii_string(symbols, position, extra_symbols):
+	ret = ''
+	while symbols[position] != 0:
+		symbol = symbols[position]
+		if symbol < ASCII_STRING_SYMBOL_EXTRA:
+			ret += chr(ord('a')+symbol-1)
+		elif symbol < ASCII_STRING_SYMBOL_ESCAPE:
+			ret += extra_symbols[symbol-ASCII_STRING_SYMBOL_EXTRA]
+		else:
+			ret += chr((symbols[position+1] << 5) | symbols[position+2])
+			position += 2
+		position += 1
+	return ret
+
+def build_ascii_strings(strings, extra_symbols):
+	symbols = []
+	checkpoints = []
+	offsets = []
+	for i, string in enumerate(strings):
+		if i % LOOKUP_STRING_CHECKPOINT_INTERVAL == 0:
+			checkpoints.append(len(symbols))
+		offsets.append(len(symbols) - checkpoints[-1])
+		assert(offsets[-1] < 256)
+		symbols += pack_ascii_string(string, extra_symbols)
+		assert(unpack_ascii_string(symbols, checkpoints[-1]+offsets[-1], extra_symbols) == string)
+	assert(len(symbols) < 65536)
+	stream = 0
+	for i, symbol in enumerate(symbols):
+		stream |= symbol << (i*5)
+	# +1 byte: lookup_ascii_string_next() always reads 2 bytes
+	data = stream.to_bytes((len(symbols)*5+7)//8 + 1, 'little')
+	return data, checkpoints, offsets
+
+def print_ascii_strings(name, strings, extra_symbols):
+	data, checkpoints, offsets = build_ascii_strings(strings, extra_symbols)
+	unpacked_size = sum([len(string.encode())+1 for string in strings])
+	print(f"// Packed strings of {name}: {len(data)} bytes, {unpacked_size} bytes unpacked. See lookup_ascii_string_next() in lookup.c")
+	print(f"Packed strings of {name}: {len(data)} bytes, {unpacked_size} bytes unpacked", file=sys.stderr)
+	print(f"const uint8_t {name}[] = {{")
+	for i in range(0, len(data), 16):
+		print('\t' + ' '.join([f"0x{b:02X}," for b in data[i:i+16]]))
+	print("};")
+	print(f"const uint16_t {name}_CHECKPOINT[] = {{" + ', '.join([f"0x{c:04X}U" for c in checkpoints]) + "};")
+	print(f"const uint8_t {name}_OFFSET[] = {{")
+	for i in range(0, len(offsets), 16):
+		print('\t' + ' '.join([f"0x{o:02X}," for o in offsets[i:i+16]]))
+	print("};")
+	print()
+
+def print_perfect_hash(name, perfect_hash):
+	seed, slot_mask, displacement = perfect_hash
+	print(f"// Minimal perfect hash of {name.removesuffix('_HASH')}. See lookup_hash_slot() in lookup.c")
+	print(f"static const uint8_t {name}_DISPLACEMENT[] = {{")
+	for i in range(0, len(displacement), 16):
+		print('\t' + ' '.join([f"0x{d:02X}," for d in displacement[i:i+16]]))
+	print("};")
+	print(f"const struct lookup_perfect_hash {name} = {{.seed=0x{seed:08X}U, .slot_mask=0x{slot_mask:X}U, .displacement={name}_DISPLACEMENT, .displacement_mask=0x{len(displacement)-1:X}U}};")
+
 print("// This file was generated with generate_lookup_table.py. Do not manually modify.")
 print("// This project's constrained by the flash size. Sorry for the unintuitive design!")
 print()
@@ -258,24 +485,12 @@ print(f"const uint32_t LOOKUP_CODEPAGE_2_START = 0x{KEYBOARD_CODEPAGE_2_START:08
 print(f"const size_t LOOKUP_CODEPAGE_2_LENGTH = {len(codepage_2)};")
 print()
 
-print("// Intentionally not using array of string to save FLASH space. Can save 4 bytes for each entry this way.")
-print("const char *LOOKUP_CODEPAGE_0 = ")
-for i in range(codepage_0_size):
-	null_terminator = "\\0" if i < codepage_0_size-1 else ""
-	if i in codepage_0_map:
-		print(f'\t"{codepage_0_map[i]}{null_terminator}"')
-	else:
-		print(f'\t"{null_terminator}"')
-print(";")
-print()
-
-print("// Intentionally not using array of string to save FLASH space. Can save 4 bytes for each entry this way.")
-print("const char *LOOKUP_CODEPAGE_1 = ")
-for i, w in enumerate(codepage_1):
-	null_terminator = "\\0" if i < len(codepage_1)-1 else ""
-	print(f'\t"{c_style_escape(w)}{null_terminator}"')
-print(";")
-print()
+codepage_0_strings = [codepage_0_map.get(i, "") for i in range(codepage_0_size)]
+ascii_string_extra_symbols = build_ascii_string_extra_symbols(codepage_0_strings + codepage_1)
+print("// Intentionally not using array of string to save FLASH space. The strings are packed and indexed by offset instead.")
+print(f"const char LOOKUP_ASCII_STRING_EXTRA_SYMBOLS[] = \"{c_style_escape(ascii_string_extra_symbols)}\";")
+print_ascii_strings("LOOKUP_CODEPAGE_0", codepage_0_strings, ascii_string_extra_symbols)
+print_ascii_strings("LOOKUP_CODEPAGE_1", codepage_1, ascii_string_extra_symbols)
 
 print("const uint32_t *LOOKUP_CODEPAGE_2[] = {")
 for i in codepage_2:
@@ -288,32 +503,171 @@ print("};")
 print()
 
 print("// Covers the vast majority of the characters. Each entry fits in 32bit.")
+print("// The entries are stored in the slot order of LOOKUP_COMPACT_TABLE_HASH.")
 print("const struct lookup_compact_entry LOOKUP_COMPACT_TABLE[] = {")
 
-wakalito_reversed_mapping_keys = sorted(wakalito_reversed_mapping)
-for k in wakalito_reversed_mapping_keys:
-	if wakalito_reversed_mapping[k]['trigger_u24']:
-		print(f"\t{{.input = 0x{wakalito_reversed_mapping[k]['trigger_u24']:06X}U, .sitelen_pona_id=0x{wakalito_reversed_mapping[k]['codepoint']:02X}U}}, // {wakalito_reversed_mapping[k]['trigger']} -> {wakalito_reversed_mapping[k]['word']}")
+for k in compact_table_keys:
+	print(f"\t{{.input = 0x{wakalito_reversed_mapping[k]['trigger_u24']:06X}U, .sitelen_pona_id=0x{wakalito_reversed_mapping[k]['codepoint']:02X}U}}, // {wakalito_reversed_mapping[k]['trigger']} -> {wakalito_reversed_mapping[k]['word']}")
 
 print("};")
 print()
 print(f"const size_t LOOKUP_COMPACT_TABLE_LENGTH = sizeof(LOOKUP_COMPACT_TABLE)/sizeof(*LOOKUP_COMPACT_TABLE);")
 print()
+print_perfect_hash("LOOKUP_COMPACT_TABLE_HASH", compact_table_hash)
+print()
 
 print("// Covers the other characters/strings that requires up to 12 input letters. Can encode Each entry is 64bit.")
+print("// The entries are stored in the slot order of LOOKUP_FULL_TABLE_HASH.")
 print("const struct lookup_full_entry LOOKUP_FULL_TABLE[] = {")
-for k in wakalito_reversed_mapping_keys:
-	if wakalito_reversed_mapping[k]['trigger_u24'] == 0 and wakalito_reversed_mapping[k]['trigger_u52']:
-		print(f"\t{{.input_u52 = 0x{wakalito_reversed_mapping[k]['trigger_u52']:013X}ULL, .codepage={wakalito_reversed_mapping[k]['codepage']}, .code_id=0x{wakalito_reversed_mapping[k]['codepoint']:02X}U}}, // {wakalito_reversed_mapping[k]['trigger']} -> {wakalito_reversed_mapping[k]['word']}")
+for k in full_table_keys:
+	print(f"\t{{.input_u52 = 0x{wakalito_reversed_mapping[k]['trigger_u52']:013X}ULL, .codepage={wakalito_reversed_mapping[k]['codepage']}, .code_id=0x{wakalito_reversed_mapping[k]['codepoint']:02X}U}}, // {wakalito_reversed_mapping[k]['trigger']} -> {wakalito_reversed_mapping[k]['word']}")
 
 print("};")
 print()
 
 print(f"const size_t LOOKUP_FULL_TABLE_LENGTH = sizeof(LOOKUP_FULL_TABLE)/sizeof(*LOOKUP_FULL_TABLE);")
 print()
+print_perfect_hash("LOOKUP_FULL_TABLE_HASH", full_table_hash)
+print()
+
+print("// Trie of the input sequences of LOOKUP_COMPACT_TABLE and LOOKUP_FULL_TABLE, in breadth-first order. The root is the first node.")
+print("// Format of each node: first_child:9 (0 if none), terminal:1, last_sibling:1, key_id:5. See lookup_trie_next() in lookup.c")
+print("const uint16_t LOOKUP_TRIE[] = {")
+for value, prefix in lookup_trie:
+	print(f"\t0x{value:04X}U, // {prefix if prefix else '(root)'}")
+print("};")
+print()
 
 
+# Compose sequences of KEYBOARD_OUTPUT_MODE_COMPOSE. See keyboard_out_expansion_start() in keyboard.c
+# Each glyph of codepage 0 and each string of codepage 2 has a sequence of <Multi_key> <q> followed by 2 letters:
+# the upper and the lower 4 bits of its index, as 'a'~'p'. The index of a glyph of codepage 0 is its offset in the
+# codepage. The strings of codepage 2 come after COMPOSE_CODEPAGE_2_INDEX.
+# No sequence of the default Compose file of Xorg starts with 'q', so that the default sequences keep working.
+COMPOSE_PREFIX = 'q' # Must match KEYBOARD_COMPOSE_PREFIX in keyboard.c
+COMPOSE_CODEPAGE_2_INDEX = 0xF0 # Must match KEYBOARD_COMPOSE_CODEPAGE_2_INDEX in keyboard.c
 
+def compose_sequence(index):
+	assert(index < 0x100)
+	return COMPOSE_PREFIX + chr(ord('a')+(index >> 4)) + chr(ord('a')+(index & 0xF))
+
+def compose_escape(s):
+	return s.replace('\\', '\\\\').replace('"', '\\"')
+
+def build_compose_entries(codepage_0_map, codepage_2_words):
+	assert(codepage_0_size <= COMPOSE_CODEPAGE_2_INDEX)
+	assert(len(codepage_2_words) <= 0x100-COMPOSE_CODEPAGE_2_INDEX)
+	ret = []
+	# Every codepoint of codepage 0 gets a sequence, including the ones without a word. They can be typed as well.
+	for i in range(codepage_0_size):
+		ret.append((compose_sequence(i), chr(KEYBOARD_CODEPAGE_0_START+i), codepage_0_map.get(i, "")))
+	for i, (word, string) in enumerate(codepage_2_words):
+		ret.append((compose_sequence(COMPOSE_CODEPAGE_2_INDEX+i), string, word))
+	return ret
+
+# The format is the same for both. WinCompose doesn't take the include of the locale's Compose file.
+def write_compose_file(path, entries, include_default):
+	with open(path, 'w', encoding='utf-8') as f:
+		f.write("# This file was generated with generate_lookup_table.py. Do not manually modify.\n")
+		f.write("# Compose sequences typed by ilo nena in the compose output mode. The compose key is Right Alt.\n")
+		if include_default:
+			f.write('include "%L"\n')
+		f.write("\n")
+		for sequence, string, word in entries:
+			keys = ' '.join([f"<{c}>" for c in sequence])
+			codepoints = ' '.join([f"U{ord(c):X}" for c in string])
+			f.write(f'<Multi_key> {keys} : "{compose_escape(string)}" # {codepoints} {word}'.rstrip()+'\n')
+
+if COMPOSE_OUTPUT_DIR is not None:
+	codepage_2_words = [(w, codepage_2[i]) for w, i in sorted(word_to_codepoint_codepage_2.items(), key=lambda x: x[1])]
+	compose_entries = build_compose_entries(codepage_0_map, codepage_2_words)
+	write_compose_file(f"{COMPOSE_OUTPUT_DIR}/ilonena.XCompose", compose_entries, True)
+	write_compose_file(f"{COMPOSE_OUTPUT_DIR}/ilonena_WinCompose.XCompose", compose_entries, False)
+	print(f"Compose sequences: {len(compose_entries)}", file=sys.stderr)
+
+
+# Keyboard layouts of the host, in the order of enum keyboard_layout in keyboard.h. The first one is the US layout, which
+# is keyboard_ascii_to_keycode in keyboard.c. Each row has the characters typed by the keys of LAYOUT_KEYS without any
+# modifier, with shift and with AltGr. ' ' if it isn't an ASCII character, including the dead keys. The extra key of ISO
+# keyboards isn't used for the US layouts: it types '<' on Linux but '\\' on Windows.
+LAYOUT_KEYS = [
+	[0x35, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x2D, 0x2E], # `1234567890-= of the US layout
+	[0x14, 0x1A, 0x08, 0x15, 0x17, 0x1C, 0x18, 0x0C, 0x12, 0x13, 0x2F, 0x30], # qwertyuiop[]
+	[0x04, 0x16, 0x07, 0x09, 0x0A, 0x0B, 0x0D, 0x0E, 0x0F, 0x33, 0x34, 0x31], # asdfghjkl;'\
+	[0x64, 0x1D, 0x1B, 0x06, 0x19, 0x05, 0x11, 0x10, 0x36, 0x37, 0x38], # The extra key of ISO keyboards, zxcvbnm,./
+]
+LAYOUTS = [
+	("QWERTY", [
+		("`1234567890-=", "~!@#$%^&*()_+", "             "),
+		("qwertyuiop[]", "QWERTYUIOP{}", "            "),
+		("asdfghjkl;'\\", 'ASDFGHJKL:"|', "            "),
+		(" zxcvbnm,./", " ZXCVBNM<>?", "           "),
+	]),
+	("AZERTY", [ # French
+		(" & \"'(- _  )=", " 1234567890 +", "  ~#{[|`\\^@]}"),
+		("azertyuiop $", "AZERTYUIOP  ", "            "),
+		("qsdfghjklm *", "QSDFGHJKLM% ", "            "),
+		("<wxcvbn,;:!", ">WXCVBN?./ ", "           "),
+	]),
+	("QWERTZ", [ # German
+		(" 1234567890  ", " !\" $%&/()=? ", "       {[]}\\ "),
+		("qwertzuiop +", "QWERTZUIOP *", "@          ~"),
+		("asdfghjkl  #", "ASDFGHJKL  '", "            "),
+		("<yxcvbnm,.-", ">YXCVBNM;:_", "|          "),
+	]),
+	("CZECH", [ # Czech QWERTZ. The digits are typed with shift.
+		(";+         = ", " 1234567890% ", "             "),
+		("qwertzuiop )", "QWERTZUIOP/(", "\\|          "),
+		("asdfghjkl   ", "ASDFGHJKL\"!'", "   []       "),
+		("\\yxcvbnm,.-", "|YXCVBNM?:_", "           "),
+	]),
+	("DVORAK", [ # US Dvorak
+		("`1234567890[]", "~!@#$%^&*(){}", "             "),
+		("',.pyfgcrl/=", '"<>PYFGCRL?+', "            "),
+		("aoeuidhtns-\\", "AOEUIDHTNS_|", "            "),
+		(" ;qjkxbmwvz", " :QJKXBMWVZ", "           "),
+	]),
+]
+# Encoding of the keys. Must match the ones in keyboard.c
+LAYOUT_KEY_SHIFT = 0x80 # KEYHID_SFT
+LAYOUT_KEY_ALTGR = 0x40 # KEYHID_ALTGR
+LAYOUT_KEY_ISO = 0x03 # KEYHID_ISO. The extra key of ISO keyboards (0x64) doesn't fit into 6 bits.
+
+# Returns {character: key}. The key without modifier is preferred, then the one with shift. Then the upper row.
+def build_layout(rows):
+	ret = {}
+	for level, flag in reversed(list(enumerate([0, LAYOUT_KEY_SHIFT, LAYOUT_KEY_ALTGR]))):
+		for keys, row in reversed(list(zip(LAYOUT_KEYS, rows))):
+			assert(len(row[level]) == len(keys))
+			for key, c in zip(keys, row[level]):
+				if c != ' ':
+					ret[c] = (LAYOUT_KEY_ISO if key == 0x64 else key) | flag
+	return ret
+
+# The ASCII characters typed by the firmware: sitelen Lasin, '?' for the unsupported codepoints, the hex digits
+# and the 'u' of the unicode input, the compose sequences. The ones on the same key in every layout aren't stored.
+def build_layout_tables(strings):
+	typed = set(''.join(strings)) | set("?0123456789abcdefu") | set(COMPOSE_PREFIX) | set(chr(ord('a')+i) for i in range(16))
+	layouts = [build_layout(rows) for name, rows in LAYOUTS]
+	for (name, rows), layout in zip(LAYOUTS, layouts):
+		missing = [c for c in typed if c not in layout and c not in " \n\b"]
+		assert not missing, f"{name} can't type {missing}"
+	chars = ''.join(sorted(c for c in typed if c in layouts[0] and any(layout[c] != layouts[0][c] for layout in layouts[1:])))
+	return chars, [[layout[c] for c in chars] for layout in layouts[1:]]
+
+layout_chars, layout_keys = build_layout_tables(codepage_0_strings + codepage_1)
+print("// Keys of the ASCII characters typed by the firmware that aren't on the same key in every layout, for each layout of")
+print("// enum keyboard_layout after KEYBOARD_LAYOUT_QWERTY. See keyboard_get_key() in keyboard.c")
+print(f"const char LOOKUP_LAYOUT_CHARS[] = \"{c_style_escape(layout_chars)}\";")
+print(f"const size_t LOOKUP_LAYOUT_CHARS_LENGTH = {len(layout_chars)};")
+print("const uint8_t LOOKUP_LAYOUT_KEYS[] = {")
+for (name, rows), keys in zip(LAYOUTS[1:], layout_keys):
+	print(f"\t// {name}")
+	for i in range(0, len(keys), 16):
+		print('\t' + ' '.join([f"0x{k:02X}," for k in keys[i:i+16]]))
+print("};")
+print()
+print(f"Keyboard layouts: {len(layout_chars)} characters, {len(layout_chars)*len(layout_keys)} bytes", file=sys.stderr)
 
 #####################
 ## FONT GENERATION ##
@@ -364,7 +718,17 @@ def font_data_to_u8_array(data):
 	return ret
 
 
-def font_compress(data):
+# Font compression format v2. Each image is a header byte followed by a bitstream that's read from the LSB of each byte.
+# Header: start_column:3 (the amount of empty columns cropped on each side), payload_size:5 (Unit: bytes. 0 for empty image)
+# Each column of the bitstream is one of these:
+#   1, index:3 - Column of the rolling dictionary, which stores the most recent 8 columns decoded from the two codes below
+#   01, index:FONT_DICTIONARY_INDEX_BITS - Column of FONT_DICTIONARY, the global dictionary shared by all of the images
+#   00, column:15 - Column stored as-is
+# The bitstream is padded to a byte with zeros. That's a truncated 00 code, which tells the decoder to stop.
+# Symmetric images only have the columns up to the middle one. The decoder mirrors them if it stops at column 8.
+# font_dictionary is (FONT_DICTIONARY_INDEX_BITS, FONT_DICTIONARY). See build_font_dictionary().
+
+def font_image_columns(data):
 	image_data = [data[i*2] | (data[i*2+1] << 8) for i in range(len(data)//2)]
 
 	# Detect if the image is symmetric
@@ -382,83 +746,84 @@ def font_compress(data):
 			break
 
 	if start_column == 8:
-		return (0).to_bytes() # empty image. just return zero
+		return start_column, []
+	return start_column, image_data[start_column:(15-start_column if not mirrored else 8)]
 
-	data_nibbles = [] # each array element has a 4-bit data
+def font_compress(data, font_dictionary):
+	dictionary_index_bits, dictionary = font_dictionary
+	start_column, columns = font_image_columns(data)
 
-	# dictionary-based compression. The dictionary stores most recent 8 recorded columns
-	# Since each column is 15 pixels and each column is 16bit, we use the bit0 to tell
-	# if the column is using dictionary or a direct definition
-	dictionary = [None for i in range(8)]
-	dictionary_index = 0
-	for u16 in image_data[start_column:(15-start_column if not mirrored else 8)]:
+	if start_column == 8:
+		return (0).to_bytes() # empty image. just return zero
+
+	stream = 0
+	stream_length = 0
+	def write_bits(value, length):
+		nonlocal stream, stream_length
+		stream |= value << stream_length
+		stream_length += length
+
+	rolling_dictionary = [None for i in range(8)]
+	rolling_dictionary_index = 0
+	for u16 in columns:
+		if u16 in rolling_dictionary:
+			write_bits(0b1 | (rolling_dictionary.index(u16) << 1), 1+3)
+			continue
 		if u16 in dictionary:
-			# Use dictionary
-			data_nibbles.append((dictionary.index(u16) << 1) | 0x01)
+			write_bits(0b10 | (dictionary.index(u16) << 2), 2+dictionary_index_bits)
 		else:
-			# Direct definition of the column content
-			dictionary[dictionary_index%8] = u16
-			dictionary_index += 1
-			u16 <<= 1 # the first bit is zero, indicating that the column isn't compressed
-			data_nibbles.append(u16 & 0xF)
-			data_nibbles.append((u16 >> 4) & 0xF)
-			data_nibbles.append((u16 >> 8) & 0xF)
-			data_nibbles.append((u16 >> 12) & 0xF)
-
-	# Pad it to a byte
-	if len(data_nibbles)%2 != 0:
-		data_nibbles.append(0x0)
+			write_bits(0b00 | (u16 << 2), 2+15)
+		rolling_dictionary[rolling_dictionary_index%8] = u16
+		rolling_dictionary_index += 1
 
 	# Validation
-	payload_size = len(data_nibbles)//2
+	payload_size = (stream_length+7)//8
 	if payload_size > 0b11111:
 		raise Exception("payload too large!")
 
-	for nibble in data_nibbles:
-		if nibble < 0x0 or nibble > 0xF:
-			raise Exception("data_nibbles in unexpected range")
-
 	ret = ((start_column<<5)|payload_size).to_bytes() # first byte is metadata
-	# the subsequent bytes are compressed data
-	for i in range(payload_size):
-		ret += (data_nibbles[i*2] | (data_nibbles[i*2+1] << 4)).to_bytes()
+	ret += stream.to_bytes(payload_size, 'little') # the subsequent bytes are compressed data
 	return ret
 
-def font_decompress(data):
+def font_decompress(data, font_dictionary):
+	dictionary_index_bits, dictionary = font_dictionary
 	start_col = (data[0] & 0xE0) >> 5
-	payload_length = data[0] & 0x1F
+	payload_size = data[0] & 0x1F
 
 	image = [0x0000 for i in range(15)]
-	if payload_length > 0:
-		data_nibbles = []
-		for b in data[1:]:
-			data_nibbles.append(b & 0xF)
-			data_nibbles.append((b >> 4) & 0xF)
+	if payload_size > 0:
+		stream = int.from_bytes(data[1:1+payload_size], 'little')
+		stream_length = payload_size*8
 		col = start_col
 		end_col = 14-start_col # inclusive!
 
-		dictionary = [None for i in range(8)]
-		dictionary_index = 0
-		i = 0
-		while i < len(data_nibbles) and col <= end_col:
-			if data_nibbles[i] & 0x1:
-				# dictionary-mapped column
-				image[col] = dictionary[data_nibbles[i]>>1]
-				col += 1
-				i += 1
-			elif i+1 < len(data_nibbles):
-				# non-compressed column. Just read it directly.
-				image[col] |= data_nibbles[i]
-				image[col] |= data_nibbles[i+1] << 4
-				image[col] |= data_nibbles[i+2] << 8
-				image[col] |= data_nibbles[i+3] << 12
-				image[col] >>= 1
-				dictionary[dictionary_index%8] = image[col]
-				dictionary_index += 1
-				col += 1
-				i += 4
+		rolling_dictionary = [None for i in range(8)]
+		rolling_dictionary_index = 0
+		position = 0
+		while col <= end_col:
+			bits = stream >> position
+			if bits & 0b1:
+				# rolling dictionary
+				if position+1+3 > stream_length:
+					break
+				image[col] = rolling_dictionary[(bits >> 1) & 0x7]
+				position += 1+3
 			else:
-				break # Padding nibble!
+				if bits & 0b10:
+					# global dictionary
+					if position+2+dictionary_index_bits > stream_length:
+						break
+					image[col] = dictionary[(bits >> 2) & ((1 << dictionary_index_bits)-1)]
+					position += 2+dictionary_index_bits
+				else:
+					# column stored as-is
+					if position+2+15 > stream_length:
+						break # Padding!
+					image[col] = (bits >> 2) & 0x7FFF
+					position += 2+15
+				rolling_dictionary[rolling_dictionary_index%8] = image[col]
+				rolling_dictionary_index += 1
+			col += 1
 
 		# Symmetric image! Let's draw the second half that's mirrored with the first half.
 		if col == 8:
@@ -471,6 +836,32 @@ def font_decompress(data):
 		ret += ((u16 & 0xFF00)>>8).to_bytes()
 	return ret
 
+# The global dictionary has the columns that are stored as-is in the most images, without it.
+# Every size from 2 to 256 columns is tried. The one with the smallest font data (including the dictionary) is picked.
+def build_font_dictionary(images):
+	column_count = {}
+	for data in images:
+		start_column, columns = font_image_columns(data)
+		rolling_dictionary = []
+		for u16 in columns:
+			if u16 not in rolling_dictionary:
+				column_count[u16] = column_count.get(u16, 0) + 1
+				rolling_dictionary = (rolling_dictionary + [u16])[-8:]
+	columns_by_count = sorted(column_count, key=lambda u16: (-column_count[u16], u16))
+
+	ret = None
+	ret_size = None
+	for dictionary_index_bits in range(1, 8+1):
+		font_dictionary = (dictionary_index_bits, columns_by_count[:1 << dictionary_index_bits])
+		try:
+			size = sum([len(font_compress(data, font_dictionary)) for data in images]) + len(font_dictionary[1])*2
+		except Exception:
+			continue # Some payloads are too large
+		if ret_size is None or size < ret_size:
+			ret = font_dictionary
+			ret_size = size
+	return ret
+
 font_data = {}
 
 for i in range(0xF1900, 0xF1988+1):
@@ -1583,36 +1974,152 @@ _______________-
 ----------------
 ''')
 
+font_data[KEYBOARD_CODEPAGE_3_START+27] = build_font_data('''
+_______________-
+__XXXXXXXXXXX__-
+_XX_________XX_-
+_X_____X_____X_-
+_X___XXXXX___X_-
+_X__XX_X_XX__X_-
+_X__X__X__X__X_-
+_X__XXXXXXX__X_-
+_X__X__X__X__X_-
+_X__XX_X_XX__X_-
+_X___XXXXX___X_-
+_X_____X_____X_-
+_XX_________XX_-
+__XXXXXXXXXXX__-
+_______________-
+----------------
+''')
+
+font_data[KEYBOARD_CODEPAGE_3_START+28] = build_font_data('''
+_______________-
+_______________-
+_______________-
+__XXX____X___X_-
+_X___X___X___X_-
+_X___X___X___X_-
+_X___X___X___X_-
+_X___X___X___X_-
+_X___X___X_X_X_-
+_X_X_X___X_X_X_-
+_X__X____XX_XX_-
+__XX_X___X___X_-
+_______________-
+_______________-
+_______________-
+----------------
+''')
+
+font_data[KEYBOARD_CODEPAGE_3_START+29] = build_font_data('''
+_______________-
+_______________-
+_______________-
+__XXX____XXXXX_-
+_X___X_______X_-
+_X___X______X__-
+_X___X______X__-
+_XXXXX_____X___-
+_X___X____X____-
+_X___X____X____-
+_X___X___X_____-
+_X___X___XXXXX_-
+_______________-
+_______________-
+_______________-
+----------------
+''')
+
+font_data[KEYBOARD_CODEPAGE_3_START+30] = build_font_data('''
+_______________-
+_______________-
+_______________-
+__XXX____XXXXX_-
+_X___X_______X_-
+_X___X______X__-
+_X___X______X__-
+_X___X_____X___-
+_X___X____X____-
+_X_X_X____X____-
+_X__X____X_____-
+__XX_X___XXXXX_-
+_______________-
+_______________-
+_______________-
+----------------
+''')
+
+font_data[KEYBOARD_CODEPAGE_3_START+31] = build_font_data('''
+_______________-
+_______________-
+_______________-
+__XXX____XXXXX_-
+_X___X_______X_-
+_X__________X__-
+_X__________X__-
+_X_________X___-
+_X________X____-
+_X________X____-
+_X___X___X_____-
+__XXX____XXXXX_-
+_______________-
+_______________-
+_______________-
+----------------
+''')
+
+font_data[KEYBOARD_CODEPAGE_3_START+32] = build_font_data('''
+_______________-
+_______________-
+_______________-
+_XXXX____X___X_-
+_X___X___X___X_-
+_X___X___X___X_-
+_X___X___X___X_-
+_X___X___X___X_-
+_X___X____X_X__-
+_X___X____X_X__-
+_X___X____X_X__-
+_XXXX______X___-
+_______________-
+_______________-
+_______________-
+----------------
+''')
+
+font_codepoints = []
+for i in range(codepage_0_size):
+	font_codepoints.append(KEYBOARD_CODEPAGE_0_START+i)
+for i in range(len(codepage_1)):
+	font_codepoints.append(KEYBOARD_CODEPAGE_1_START+i)
+for i in range(len(codepage_2)):
+	font_codepoints.append(KEYBOARD_CODEPAGE_2_START+i)
+codepoint = KEYBOARD_CODEPAGE_3_START
+while font_data.get(codepoint) is not None:
+	font_codepoints.append(codepoint)
+	codepoint += 1
+
+font_dictionary = build_font_dictionary([font_data_to_u8_array(font_data.get(i, font_data[0])) for i in font_codepoints])
+
 def print_codepoint_font_image(codepoint):
 	print('\t', end='')
-	for b in font_compress(font_data_to_u8_array(font_data.get(codepoint, font_data[0]))):
+	for b in font_compress(font_data_to_u8_array(font_data.get(codepoint, font_data[0])), font_dictionary):
 		print(f"0x{b:02X}, ", end='')
 	print(f"// U+{codepoint:X}")
 
 
 # font compression-decompression validation. Make sure that the compression function actually works for all codepoints
 validate_compression_algorithm = True
-if validate_compression_algorithm:
-	original_length = 0
-	compressed_length = 0
-	codepoints = []
-	for i in range(codepage_0_size):
-		codepoints.append(KEYBOARD_CODEPAGE_0_START+i)
-	for i in range(len(codepage_1)):
-		codepoints.append(KEYBOARD_CODEPAGE_1_START+i)
-	for i in range(len(codepage_2)):
-		codepoints.append(KEYBOARD_CODEPAGE_2_START+i)
-	codepoint = KEYBOARD_CODEPAGE_3_START
-	while font_data.get(codepoint) is not None:
-		codepoints.append(codepoint)
-		codepoint += 1
-	payload = b''
-	for i in codepoints:
-		original = font_data_to_u8_array(font_data.get(i, font_data[0]))
-		compressed = font_compress(original)
-		decompressed = font_decompress(compressed)
-		original_length += len(original)
-		compressed_length += len(compressed)
+original_length = 0
+compressed_length = 0
+for i in font_codepoints:
+	original = font_data_to_u8_array(font_data.get(i, font_data[0]))
+	compressed = font_compress(original, font_dictionary)
+	original_length += len(original)
+	compressed_length += len(compressed)
+	if validate_compression_algorithm:
+		decompressed = font_decompress(compressed, font_dictionary)
 		if original != decompressed:
 			print('Compression error! Codepoint: '+ hex(i))
 			print(' '.join([f'{b:02X}' for b in original]))
@@ -1621,26 +2128,44 @@ if validate_compression_algorithm:
 
 
 print("// The content below is the compressed font data. The font size is 15x15.")
+print(f"// Size of the font data: {original_length} bytes uncompressed, {compressed_length} bytes compressed + {len(font_dictionary[1])*2} bytes of FONT_DICTIONARY")
+print(f"Size of the font data: {original_length} bytes uncompressed, {compressed_length} bytes compressed + {len(font_dictionary[1])*2} bytes of FONT_DICTIONARY", file=sys.stderr)
 print()
 
-print("const uint8_t FONT_CODEPAGE_0[] = {")
-for i in range(codepage_0_size):
-	print_codepoint_font_image(KEYBOARD_CODEPAGE_0_START+i)
-print("};")
-
-print("const uint8_t FONT_CODEPAGE_1[] = {")
-for i in range(len(codepage_1)):
-	print_codepoint_font_image(KEYBOARD_CODEPAGE_1_START+i)
-print("};")
-
-print("const uint8_t FONT_CODEPAGE_2[] = {")
-for i in range(len(codepage_2)):
-	print_codepoint_font_image(KEYBOARD_CODEPAGE_2_START+i)
+print("// Global column dictionary of the compressed images. See lookup_decompress_image() in lookup.c")
+print(f"const uint8_t FONT_DICTIONARY_INDEX_BITS = {font_dictionary[0]};")
+print("const uint16_t FONT_DICTIONARY[] = {")
+for i in range(0, len(font_dictionary[1]), 8):
+	print('\t' + ' '.join([f"0x{u16:04X}U," for u16 in font_dictionary[1][i:i+8]]))
 print("};")
+print()
 
-print("const uint8_t FONT_CODEPAGE_3[] = {")
-codepoint = KEYBOARD_CODEPAGE_3_START
-while font_data.get(codepoint) is not None:
-	print_codepoint_font_image(codepoint)
-	codepoint += 1
-print("};")
+# Offset of every LOOKUP_FONT_CHECKPOINT_INTERVAL-th image of each codepage, so that lookup_get_image_ptr_by_index() in lookup.c
+# only has to walk through a few variable-length images.
+LOOKUP_FONT_CHECKPOINT_INTERVAL = 8 # Must match the one in lookup.h
+font_checkpoint_flash_size = 0
+
+def print_font_codepage(name, codepoints):
+	global font_checkpoint_flash_size
+	# Word-aligned and padded: lookup_decompress_image() reads the payload with aligned 32-bit loads, up to the word after
+	# the one with the last byte of the image
+	print(f"const uint8_t {name}[] __attribute__((aligned(4))) = {{")
+	checkpoints = []
+	offset = 0
+	for i, codepoint in enumerate(codepoints):
+		if i % LOOKUP_FONT_CHECKPOINT_INTERVAL == 0:
+			checkpoints.append(offset)
+		print_codepoint_font_image(codepoint)
+		offset += len(font_compress(font_data_to_u8_array(font_data.get(codepoint, font_data[0])), font_dictionary))
+	print("\t" + " ".join(["0x00,"]*(-offset % 4 + 4)) + " // Padding. See lookup_decompress_image()")
+	print("};")
+	assert(offset < 65536)
+	print(f"const uint16_t {name}_CHECKPOINT[] = {{" + ', '.join([f"0x{c:04X}U" for c in checkpoints]) + "};")
+	font_checkpoint_flash_size += len(checkpoints)*2
+
+print_font_codepage("FONT_CODEPAGE_0", [KEYBOARD_CODEPAGE_0_START+i for i in range(codepage_0_size)])
+print_font_codepage("FONT_CODEPAGE_1", [KEYBOARD_CODEPAGE_1_START+i for i in range(len(codepage_1))])
+print_font_codepage("FONT_CODEPAGE_2", [KEYBOARD_CODEPAGE_2_START+i for i in range(len(codepage_2))])
+print_font_codepage("FONT_CODEPAGE_3", [i for i in font_codepoints if i >= KEYBOARD_CODEPAGE_3_START])
+print(f"// Flash cost of the FONT_CODEPAGE_*_CHECKPOINT: {font_checkpoint_flash_size} bytes")
+print(f"Flash cost of the font checkpoints: {font_checkpoint_flash_size} bytes", file=sys.stderr)
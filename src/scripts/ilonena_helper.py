@@ -0,0 +1,119 @@
+#!/usr/bin/python3
+
+# Copyright 2025 Wong Cho Ching <https://sadale.net>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# Helper of the vendor interface of ilo nena (Linux). It announces itself to ilo nena, which then sends the sitelen pona
+# glyphs as UTF-8 text instead of typing them out with the unicode input of the OS. The text is typed with
+# wtype (Wayland) or xdotool (X11), or with the command given by --command.
+#
+# ilo nena goes back to typing by itself within 300ms after this script stops.
+# The user needs the permission of the hidraw device. Example udev rule, in /etc/udev/rules.d/70-ilonena.rules:
+# SUBSYSTEM=="hidraw", ATTRS{idVendor}=="1209", ATTRS{idProduct}=="6362", MODE="0660", TAG+="uaccess"
+
+import argparse
+import codecs
+import glob
+import os
+import select
+import shlex
+import subprocess
+import sys
+import time
+
+USB_VID = 0x1209
+USB_PID = 0x6362
+HELLO = 0x01 # Same as KEYBOARD_VENDOR_HELPER_HELLO of keyboard.c
+HELLO_INTERVAL = 1.0 # Unit: seconds. ilo nena forgets about the helper if the vendor endpoint stops being polled
+REPORT_LENGTH = 8
+
+# Returns the path of the hidraw device of the vendor interface of ilo nena, or None
+def find_hidraw():
+	for path in sorted(glob.glob('/sys/class/hidraw/hidraw*')):
+		try:
+			with open(f'{path}/device/uevent') as f:
+				uevent = f.read()
+			with open(f'{path}/device/report_descriptor', 'rb') as f:
+				report_descriptor = f.read()
+		except OSError:
+			continue
+		if f'HID_ID=0003:{USB_VID:08X}:{USB_PID:08X}' not in uevent:
+			continue
+		# The keyboard interface is on the same device. The vendor one starts with USAGE_PAGE (Vendor Defined 0xFF00)
+		if report_descriptor.startswith(b'\x06\x00\xFF'):
+			return '/dev/' + os.path.basename(path)
+	return None
+
+def default_command():
+	if os.environ.get('WAYLAND_DISPLAY'):
+		return ['wtype', '--']
+	return ['xdotool', 'type', '--']
+
+def run(device, command):
+	fd = os.open(device, os.O_RDWR)
+	decoder = codecs.getincrementaldecoder('utf-8')(errors='replace')
+	last_hello = 0
+	try:
+		while True:
+			if time.monotonic()-last_hello >= HELLO_INTERVAL:
+				# Report ID 0 (the interface doesn't have any), then the output report
+				os.write(fd, bytes([0, HELLO] + [0]*(REPORT_LENGTH-1)))
+				last_hello = time.monotonic()
+			text = ''
+			# Gather the reports that are already there, so that they're typed with one command
+			timeout = HELLO_INTERVAL
+			while select.select([fd], [], [], timeout)[0]:
+				report = os.read(fd, REPORT_LENGTH)
+				if not report:
+					raise OSError('Disconnected')
+				text += decoder.decode(report[1:1+min(report[0], REPORT_LENGTH-1)])
+				timeout = 0.01
+			if text:
+				subprocess.run(command + [text])
+	finally:
+		os.close(fd)
+
+def main():
+	parser = argparse.ArgumentParser(description='Types the text sent by the vendor interface of ilo nena.')
+	parser.add_argument('--device', help='hidraw device of the vendor interface. Default: found by the VID and PID')
+	parser.add_argument('--command', help='Command for typing the text, which is appended as the last argument. Default: wtype on Wayland, xdotool otherwise')
+	args = parser.parse_args()
+	command = shlex.split(args.command) if args.command else default_command()
+	while True:
+		device = args.device or find_hidraw()
+		if device is None:
+			time.sleep(1) # Waiting for ilo nena to be plugged in
+			continue
+		print(f'Using {device}', file=sys.stderr)
+		try:
+			run(device, command)
+		except OSError as e:
+			# Unplugged. Wait for it to come back.
+			print(f'{device}: {e}', file=sys.stderr)
+			time.sleep(1)
+
+if __name__ == '__main__':
+	main()
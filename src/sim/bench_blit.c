@@ -0,0 +1,256 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Benchmark of display_draw_16() over every image of the 4 FONT_CODEPAGE_* arrays, with every combination of the flags
+// and a few positions: aligned to the pages, not aligned, and clipped by the edges of the display. The cycles are the
+// ones of the virtual clock. The OR rows are also measured with the previous implementation, which had a bit loop for
+// DISPLAY_DRAW_FLAG_SCALE_2x and checked the flags and the clipping for each column.
+// Each drawing is checked against a pixel by pixel reference.
+
+// display.c is a part of this program instead of fw_display.o, for its display_data_buffer. See the Makefile.
+#include "display.c"
+#include "sim.h"
+#include "lookup.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_HEIGHT (DISPLAY_PAGES*8)
+
+struct bench_result {
+	uint64_t count;
+	uint64_t cycles;
+	uint64_t cycles_max;
+};
+
+// display_draw_16() is in the same file, and the instrumentation is added after the optimizations. Without volatile,
+// the compiler knows that the drawing doesn't change sim_cycles.
+static uint64_t bench_cycles(void) {
+	return *(volatile uint64_t *)&sim_cycles;
+}
+
+static void bench_result_add(struct bench_result *result, uint64_t cycles) {
+	result->count++;
+	result->cycles += cycles;
+	if(cycles > result->cycles_max) {
+		result->cycles_max = cycles;
+	}
+}
+
+// display_draw_16() before the blitter, on a copy of the buffers. There was only the OR raster operation.
+static uint32_t bench_previous_data_buffer[DISPLAY_WIDTH];
+static uint32_t bench_previous_drawn_pages[DISPLAY_WIDTH/8];
+static uint32_t bench_previous_changed_columns[DISPLAY_WIDTH/32];
+// It tracked the drawn pages rather than the drawn halves
+static const uint32_t bench_previous_page_masks[16] = {
+	0x00000000U, 0x000000FFU, 0x0000FF00U, 0x0000FFFFU, 0x00FF0000U, 0x00FF00FFU, 0x00FFFF00U, 0x00FFFFFFU,
+	0xFF000000U, 0xFF0000FFU, 0xFF00FF00U, 0xFF00FFFFU, 0xFFFF0000U, 0xFFFF00FFU, 0xFFFFFF00U, 0xFFFFFFFFU,
+};
+
+static uint32_t bench_previous_image_column(const uint16_t *image, int32_t i, int32_t y, uint8_t flags) {
+	size_t image_index = (flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? i/2 : i;
+	uint32_t image_to_be_shown = (flags & DISPLAY_DRAW_FLAG_INVERT) ? (uint16_t)~image[image_index] : image[image_index];
+	if(flags & DISPLAY_DRAW_FLAG_SCALE_2x) {
+		uint32_t image_original = image_to_be_shown;
+		image_to_be_shown = 0;
+		for(size_t j=0; j<16; j++) {
+			if(image_original & (1 << j)) {
+				image_to_be_shown |= 0x03U << (j*2);
+			}
+		}
+	}
+
+	if(y > 0) {
+		image_to_be_shown <<= y;
+	} else {
+		image_to_be_shown >>= -y;
+	}
+	return image_to_be_shown;
+}
+
+static void bench_previous_draw_16(const uint16_t *image, uint8_t w, int32_t x, int32_t y, uint8_t flags) {
+	if(flags & DISPLAY_DRAW_FLAG_SCALE_2x) {
+		w *= 2;
+	}
+	int32_t top = (y > 0) ? y : 0;
+	int32_t bottom = y + ((flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? 32 : 16);
+	if(bottom > DISPLAY_PAGES*8) {
+		bottom = DISPLAY_PAGES*8;
+	}
+	if(top >= bottom) {
+		return;
+	}
+	uint8_t pages = ((1U << ((bottom+7)/8)) - 1) & ~((1U << (top/8)) - 1);
+	for(int32_t i=0; i<w; i++) {
+		if(x+i >= DISPLAY_WIDTH) {
+			break;
+		} else if(x+i < 0) {
+			continue;
+		}
+		uint32_t image_to_be_shown = bench_previous_image_column(image, i, y, flags);
+
+		size_t column = x+i;
+		uint32_t *drawn_pages = &bench_previous_drawn_pages[column/8];
+		uint8_t stale_pages = pages & ~(*drawn_pages >> (column%8*4));
+		uint32_t previous = bench_previous_data_buffer[column];
+		uint32_t current = (previous & ~bench_previous_page_masks[stale_pages]) | image_to_be_shown;
+		*drawn_pages |= (uint32_t)pages << (column%8*4);
+		if(current != previous) {
+			bench_previous_data_buffer[column] = current;
+			bench_previous_changed_columns[column/32] |= 1U << (column%32);
+		}
+	}
+}
+
+// Pixel by pixel. Not instrumented: it's only called by the checks.
+__attribute__((no_sanitize_coverage))
+static void bench_reference_draw_16(uint32_t frame[DISPLAY_WIDTH], const uint16_t *image, uint8_t w, int32_t x, int32_t y, uint8_t flags) {
+	int32_t scale = (flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? 2 : 1;
+	for(int32_t i=0; i<w*scale; i++) {
+		for(int32_t j=0; j<16*scale; j++) {
+			if(x+i < 0 || x+i >= DISPLAY_WIDTH || y+j < 0 || y+j >= BENCH_HEIGHT) {
+				continue;
+			}
+			uint32_t pixel = ((image[i/scale] >> (j/scale)) & 1) ^ ((flags & DISPLAY_DRAW_FLAG_INVERT) ? 1 : 0);
+			uint32_t bit = 1U << (y+j);
+			switch(flags & DISPLAY_DRAW_FLAG_RENDER_MASK) {
+				case DISPLAY_DRAW_FLAG_OR_RENDER:
+					frame[x+i] |= pixel ? bit : 0;
+				break;
+				case DISPLAY_DRAW_FLAG_XOR_RENDER:
+					frame[x+i] ^= pixel ? bit : 0;
+				break;
+				case DISPLAY_DRAW_FLAG_OVERWRITE_RENDER:
+					frame[x+i] = (frame[x+i] & ~bit) | (pixel ? bit : 0);
+				break;
+			}
+		}
+	}
+}
+
+// What's on the display before drawing the image. All of the pages have been drawn since display_clear(), so that
+// the raster operations have something to work with.
+__attribute__((no_sanitize_coverage))
+static void bench_fill_background(void) {
+	for(size_t i=0; i<DISPLAY_WIDTH; i++) {
+		display_data_buffer[i] = 0x5A3CC3A5U ^ (i * 0x01010101U);
+	}
+	memset(display_drawn_halves, 0xFF, sizeof(display_drawn_halves));
+	memset(display_changed_columns, 0, sizeof(display_changed_columns));
+	memcpy(bench_previous_data_buffer, display_data_buffer, sizeof(bench_previous_data_buffer));
+	memset(bench_previous_drawn_pages, 0xFF, sizeof(bench_previous_drawn_pages));
+	memcpy(bench_previous_changed_columns, display_changed_columns, sizeof(bench_previous_changed_columns));
+}
+
+static const struct {
+	int8_t x;
+	int8_t y;
+} bench_positions[] = {
+	{8, 0}, // Page-aligned
+	{8, 8},
+	{8, 3},
+	{-5, -3}, // Clipped at the top left
+	{120, 21}, // Clipped at the bottom right
+};
+#define BENCH_POSITION_COUNT (sizeof(bench_positions)/sizeof(*bench_positions))
+
+static const char *const bench_render_names[] = {"or", "xor", "overwrite"};
+
+static size_t bench_errors;
+
+static void bench_flags(uint8_t flags, const uint16_t (*images)[LOOKUP_IMAGE_WIDTH+1], size_t image_count) {
+	struct bench_result result = {0};
+	struct bench_result result_previous = {0};
+	for(size_t i=0; i<image_count; i++) {
+		for(size_t j=0; j<BENCH_POSITION_COUNT; j++) {
+			int32_t x = bench_positions[j].x;
+			int32_t y = bench_positions[j].y;
+			uint32_t reference[DISPLAY_WIDTH];
+			bench_fill_background();
+			memcpy(reference, display_data_buffer, sizeof(reference));
+			bench_reference_draw_16(reference, images[i], LOOKUP_IMAGE_WIDTH+1, x, y, flags);
+
+			uint64_t start = bench_cycles();
+			display_draw_16(images[i], LOOKUP_IMAGE_WIDTH+1, x, y, flags);
+			bench_result_add(&result, bench_cycles()-start);
+			if(memcmp(reference, display_data_buffer, sizeof(reference))) {
+				if(bench_errors++ < 10) {
+					printf("Mismatch: image %zu at (%d, %d), flags 0x%02X\n", i, (int)x, (int)y, flags);
+				}
+			}
+
+			if((flags & DISPLAY_DRAW_FLAG_RENDER_MASK) == DISPLAY_DRAW_FLAG_OR_RENDER) {
+				start = bench_cycles();
+				bench_previous_draw_16(images[i], LOOKUP_IMAGE_WIDTH+1, x, y, flags);
+				bench_result_add(&result_previous, bench_cycles()-start);
+				if(memcmp(reference, bench_previous_data_buffer, sizeof(reference))) {
+					if(bench_errors++ < 10) {
+						printf("Mismatch of the previous implementation: image %zu at (%d, %d), flags 0x%02X\n", i, (int)x, (int)y, flags);
+					}
+				}
+			}
+		}
+	}
+
+	char name[32];
+	snprintf(name, sizeof(name), "%s%s%s", (flags & DISPLAY_DRAW_FLAG_SCALE_2x) ? "2x " : "",
+		(flags & DISPLAY_DRAW_FLAG_INVERT) ? "invert " : "", bench_render_names[(flags & DISPLAY_DRAW_FLAG_RENDER_MASK) >> 2]);
+	printf("%-20s %5llu draws | display_draw_16(): mean %6.1f, max %5llu", name,
+		(unsigned long long)result.count, (double)result.cycles/result.count, (unsigned long long)result.cycles_max);
+	if(result_previous.count) {
+		printf(" | previous: mean %6.1f, max %5llu", (double)result_previous.cycles/result_previous.count,
+			(unsigned long long)result_previous.cycles_max);
+	}
+	printf("\n");
+}
+
+// Decompresses the images of a codepage. The extra column is blank, like the one of display_draw_glyph().
+static size_t bench_load_codepage(uint16_t (*images)[LOOKUP_IMAGE_WIDTH+1], const uint8_t *data, size_t length) {
+	for(size_t i=0; i<length; i++) {
+		memset(images[i], 0, sizeof(*images));
+		lookup_decompress_image(images[i], data);
+		data += (data[0] & 0x1F) + 1;
+	}
+	return length;
+}
+
+int main(void) {
+	static uint16_t images[256][LOOKUP_IMAGE_WIDTH+1];
+	size_t image_count = 0;
+	image_count += bench_load_codepage(&images[image_count], FONT_CODEPAGE_0, LOOKUP_CODEPAGE_0_LENGTH);
+	image_count += bench_load_codepage(&images[image_count], FONT_CODEPAGE_1, LOOKUP_CODEPAGE_1_LENGTH);
+	image_count += bench_load_codepage(&images[image_count], FONT_CODEPAGE_2, LOOKUP_CODEPAGE_2_LENGTH);
+	image_count += bench_load_codepage(&images[image_count], FONT_CODEPAGE_3, LOOKUP_CODEPAGE_3_LENGTH);
+
+	printf("Virtual clock: %u cycles per basic block\n", (unsigned)sim_config.cycles_per_block);
+	printf("%zu images, %zu positions, %d columns each\n", image_count, BENCH_POSITION_COUNT, LOOKUP_IMAGE_WIDTH+1);
+	for(uint8_t render=DISPLAY_DRAW_FLAG_OR_RENDER; render<=DISPLAY_DRAW_FLAG_OVERWRITE_RENDER; render+=DISPLAY_DRAW_FLAG_XOR_RENDER) {
+		for(uint8_t flags=0; flags<=(DISPLAY_DRAW_FLAG_INVERT|DISPLAY_DRAW_FLAG_SCALE_2x); flags++) {
+			bench_flags(flags|render, images, image_count);
+		}
+	}
+	printf("%zu mismatches\n", bench_errors);
+	return bench_errors ? 1 : 0;
+}
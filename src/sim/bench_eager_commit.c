@@ -0,0 +1,150 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Measures the keystrokes saved by the eager commit option over a corpus of text.
+// Every word of the corpus is typed with its shortest input sequence. Without eager commit, it's followed by ALA.
+// With eager commit, ALA isn't needed if the input sequence is unambiguous. See lookup_trie_is_unambiguous().
+// Usage: bench_eager_commit [corpus.txt]
+
+#include "sim.h"
+#include "lookup.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_WORDS_MAX (1024)
+#define BENCH_WORD_LENGTH_MAX (64)
+
+struct bench_word {
+	char str[BENCH_WORD_LENGTH_MAX];
+	uint32_t keystrokes; // Without eager commit
+	uint32_t keystrokes_eager; // With eager commit
+};
+
+static struct bench_word bench_words[BENCH_WORDS_MAX];
+static size_t bench_words_length = 0;
+
+static struct bench_word *bench_find_word(const char *str) {
+	for(size_t i=0; i<bench_words_length; i++) {
+		if(!strcmp(bench_words[i].str, str)) {
+			return &bench_words[i];
+		}
+	}
+	return NULL;
+}
+
+static void bench_add_trigger(uint8_t keys[LOOKUP_INPUT_LENGTH_MAX], size_t length, uint16_t node) {
+	uint32_t codepoint = lookup_search(keys, length);
+	struct lookup_ascii_string packed;
+	if(codepoint >= LOOKUP_CODEPAGE_0_START && codepoint < LOOKUP_CODEPAGE_0_START+LOOKUP_CODEPAGE_0_LENGTH) {
+		lookup_get_ascii_string(&packed, 0, codepoint-LOOKUP_CODEPAGE_0_START);
+	} else if(codepoint >= LOOKUP_CODEPAGE_1_START && codepoint < LOOKUP_CODEPAGE_1_START+LOOKUP_CODEPAGE_1_LENGTH) {
+		lookup_get_ascii_string(&packed, 1, codepoint-LOOKUP_CODEPAGE_1_START);
+	} else {
+		return; // Unicode strings aren't in the corpus
+	}
+	char str[BENCH_WORD_LENGTH_MAX];
+	size_t str_length = 0;
+	while(str_length < BENCH_WORD_LENGTH_MAX-1 && (str[str_length] = lookup_ascii_string_next(&packed)) != '\0') {
+		str_length++;
+	}
+	str[str_length] = '\0';
+	uint32_t keystrokes = length+1; // The +1 is ALA
+	uint32_t keystrokes_eager = lookup_trie_is_unambiguous(node) ? length : length+1;
+	struct bench_word *word = bench_find_word(str);
+	if(!word) {
+		if(bench_words_length >= BENCH_WORDS_MAX) {
+			return;
+		}
+		word = &bench_words[bench_words_length++];
+		*word = (struct bench_word){.keystrokes=UINT32_MAX, .keystrokes_eager=UINT32_MAX};
+		strcpy(word->str, str);
+	}
+	// The typist knows the shortest input sequence of each mode
+	if(keystrokes < word->keystrokes) {
+		word->keystrokes = keystrokes;
+	}
+	if(keystrokes_eager < word->keystrokes_eager) {
+		word->keystrokes_eager = keystrokes_eager;
+	}
+}
+
+// Visit every input sequence of LOOKUP_TRIE
+static void bench_walk_trie(uint8_t keys[LOOKUP_INPUT_LENGTH_MAX], size_t length, uint16_t node) {
+	if(lookup_trie_is_terminal(node)) {
+		bench_add_trigger(keys, length, node);
+	}
+	if(length >= LOOKUP_INPUT_LENGTH_MAX) {
+		return;
+	}
+	for(uint8_t key_id=ILONENA_KEY_1; key_id<=ILONENA_KEY_G; key_id++) {
+		uint16_t next = lookup_trie_next(node, key_id);
+		if(next != LOOKUP_TRIE_DEAD_END) {
+			keys[length] = key_id;
+			bench_walk_trie(keys, length+1, next);
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	const char *path = argc > 1 ? argv[1] : "corpus_toki_pona.txt";
+	FILE *f = fopen(path, "r");
+	if(!f) {
+		perror(path);
+		return 1;
+	}
+
+	uint8_t keys[LOOKUP_INPUT_LENGTH_MAX] = {0};
+	bench_walk_trie(keys, 0, LOOKUP_TRIE_ROOT);
+
+	uint64_t glyphs = 0, glyphs_eager = 0, keystrokes = 0, keystrokes_eager = 0, unknown = 0;
+	char token[256];
+	while(fscanf(f, "%255s", token) == 1) {
+		struct bench_word *word = bench_find_word(token);
+		if(!word) {
+			unknown++;
+			continue;
+		}
+		glyphs++;
+		keystrokes += word->keystrokes;
+		keystrokes_eager += word->keystrokes_eager;
+		if(word->keystrokes_eager < word->keystrokes) {
+			glyphs_eager++;
+		}
+	}
+	fclose(f);
+
+	if(!glyphs) {
+		printf("No known word in %s\n", path);
+		return 1;
+	}
+	printf("Corpus: %s, %llu glyphs (%llu unknown words skipped)\n", path, (unsigned long long)glyphs, (unsigned long long)unknown);
+	printf("Glyphs committed eagerly:  %llu (%.1f%%)\n", (unsigned long long)glyphs_eager, 100.0*glyphs_eager/glyphs);
+	printf("Keystrokes without eager:  %llu (%.3f per glyph)\n", (unsigned long long)keystrokes, (double)keystrokes/glyphs);
+	printf("Keystrokes with eager:     %llu (%.3f per glyph)\n", (unsigned long long)keystrokes_eager, (double)keystrokes_eager/glyphs);
+	printf("Keystrokes saved:          %llu (%.1f%%)\n", (unsigned long long)(keystrokes-keystrokes_eager), 100.0*(keystrokes-keystrokes_eager)/keystrokes);
+	return 0;
+}
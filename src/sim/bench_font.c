@@ -0,0 +1,98 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Benchmark of lookup_decompress_image() over every image of the 4 FONT_CODEPAGE_* arrays. The cycles are the ones of
+// the virtual clock.
+// With -d, prints the decompressed images instead. test_font_decompress.py compares them with font_decompress() of
+// generate_lookup_table.py.
+
+#include "sim.h"
+#include "lookup.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+struct bench_result {
+	uint64_t count;
+	uint64_t cycles;
+	uint64_t cycles_max;
+};
+
+static void bench_result_add(struct bench_result *result, uint64_t cycles) {
+	result->count++;
+	result->cycles += cycles;
+	if(cycles > result->cycles_max) {
+		result->cycles_max = cycles;
+	}
+}
+
+static void bench_codepage(const char *name, const uint8_t *data, size_t length, uint32_t codepoint_start, int dump) {
+	struct bench_result result = {0};
+	for(size_t i=0; i<length; i++) {
+		// Garbage in the image. The decoder must overwrite all of the columns.
+		uint16_t image[LOOKUP_IMAGE_WIDTH];
+		memset(image, 0x5A, sizeof(image));
+
+		uint64_t start = sim_cycles;
+		lookup_decompress_image(image, data);
+		bench_result_add(&result, sim_cycles-start);
+
+		if(dump) {
+			printf("%08X", (unsigned)(codepoint_start+i));
+			for(size_t j=0; j<LOOKUP_IMAGE_WIDTH; j++) {
+				printf(" %04X", image[j]);
+			}
+			printf("\n");
+		}
+		data += (data[0] & 0x1F) + 1;
+	}
+	if(!dump) {
+		printf("%-16s %4llu images | lookup_decompress_image(): mean %6.1f, max %5llu\n", name,
+			(unsigned long long)result.count, (double)result.cycles/result.count, (unsigned long long)result.cycles_max);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	int dump = 0;
+	int opt;
+	while((opt = getopt(argc, argv, "d")) != -1) {
+		if(opt == 'd') {
+			dump = 1;
+		} else {
+			fprintf(stderr, "Usage: %s [-d]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if(!dump) {
+		printf("Virtual clock: %u cycles per basic block\n", (unsigned)sim_config.cycles_per_block);
+	}
+	bench_codepage("FONT_CODEPAGE_0", FONT_CODEPAGE_0, LOOKUP_CODEPAGE_0_LENGTH, LOOKUP_CODEPAGE_0_START, dump);
+	bench_codepage("FONT_CODEPAGE_1", FONT_CODEPAGE_1, LOOKUP_CODEPAGE_1_LENGTH, LOOKUP_CODEPAGE_1_START, dump);
+	bench_codepage("FONT_CODEPAGE_2", FONT_CODEPAGE_2, LOOKUP_CODEPAGE_2_LENGTH, LOOKUP_CODEPAGE_2_START, dump);
+	bench_codepage("FONT_CODEPAGE_3", FONT_CODEPAGE_3, LOOKUP_CODEPAGE_3_LENGTH, LOOKUP_CODEPAGE_3_START, dump);
+	return 0;
+}
@@ -0,0 +1,261 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Benchmark of lookup_search() against the linear scan it replaced. Every trigger of the lookup tables and every
+// prefix of them that doesn't match anything is looked up with both. The cycles are the ones of the virtual clock.
+// Also benchmarks the incremental lookup with LOOKUP_TRIE, done for each key typed in the main loop. It costs a
+// transition on top of lookup_search() for the complete input sequences, and saves lookup_search() for the others.
+
+#include "sim.h"
+#include "lookup.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The linear scan of LOOKUP_COMPACT_TABLE and LOOKUP_FULL_TABLE, as it was before the perfect hash.
+// It doesn't depend on the order of the entries.
+uint64_t encode_input_buffer_as_u52(uint8_t input_buffer[12], size_t input_buffer_length);
+
+static uint32_t bench_encode_input_buffer_as_u24(uint8_t input_buffer[6], size_t input_buffer_length) {
+	if(input_buffer_length > 6) {
+		return 0;
+	}
+	uint32_t ret = 0;
+	uint64_t shift = 24-4;
+	for(size_t i=0; i<input_buffer_length; i++) {
+		uint32_t key_id = input_buffer[i];
+		if(key_id == ILONENA_KEY_A || key_id >= ILONENA_KEY_G) {
+			return 0;
+		} else if(key_id > ILONENA_KEY_A) {
+			key_id--;
+		}
+		ret |= key_id << shift;
+		shift -= 4;
+	}
+	return ret;
+}
+
+static uint32_t bench_lookup_search_scan(uint8_t input_buffer[12], size_t input_buffer_length) {
+	if(input_buffer_length <= 0 || input_buffer_length > 12) {
+		return 0;
+	}
+	uint32_t ret = 0;
+	uint32_t target = bench_encode_input_buffer_as_u24(input_buffer, input_buffer_length);
+	if(target != 0) {
+		for(size_t i=0; i<LOOKUP_COMPACT_TABLE_LENGTH; i++) {
+			if(target == LOOKUP_COMPACT_TABLE[i].input) {
+				ret = LOOKUP_CODEPAGE_0_START + LOOKUP_COMPACT_TABLE[i].sitelen_pona_id;
+			}
+		}
+	}
+	if(!ret) {
+		uint64_t target = encode_input_buffer_as_u52(input_buffer, input_buffer_length);
+		for(size_t i=0; i<LOOKUP_FULL_TABLE_LENGTH; i++) {
+			if(target == LOOKUP_FULL_TABLE[i].input_u52) {
+				switch(LOOKUP_FULL_TABLE[i].codepage) {
+					case 0:
+						ret = LOOKUP_CODEPAGE_0_START + LOOKUP_FULL_TABLE[i].code_id;
+					break;
+					case 1:
+						ret = LOOKUP_CODEPAGE_1_START + LOOKUP_FULL_TABLE[i].code_id;
+					break;
+					case 2:
+						ret = LOOKUP_CODEPAGE_2_START + LOOKUP_FULL_TABLE[i].code_id;
+					break;
+				}
+			}
+		}
+	}
+	return ret;
+}
+
+struct bench_input {
+	uint8_t keys[LOOKUP_INPUT_LENGTH_MAX];
+	size_t length;
+};
+
+// 4-bit key values skip ILONENA_KEY_A. See encode_input_buffer_as_u24()
+static uint8_t bench_decode_simple_key(uint32_t value) {
+	return value >= ILONENA_KEY_A ? value+1 : value;
+}
+
+static struct bench_input bench_decode_u52(uint64_t input_u52) {
+	struct bench_input ret = {.length=0};
+	if(input_u52 & LOOKUP_FULL_ENTRY_COMPLEX_MODE) {
+		for(int shift=50-5; shift>=0 && ((input_u52 >> shift) & 0x1F); shift-=5) {
+			ret.keys[ret.length++] = (input_u52 >> shift) & 0x1F;
+		}
+	} else {
+		for(int shift=48-4; shift>=0 && ((input_u52 >> shift) & 0x0F); shift-=4) {
+			ret.keys[ret.length++] = bench_decode_simple_key((input_u52 >> shift) & 0x0F);
+		}
+	}
+	return ret;
+}
+
+struct bench_result {
+	uint64_t count;
+	uint64_t cycles;
+	uint64_t cycles_max;
+};
+
+static void bench_result_add(struct bench_result *result, uint64_t cycles) {
+	result->count++;
+	result->cycles += cycles;
+	if(cycles > result->cycles_max) {
+		result->cycles_max = cycles;
+	}
+}
+
+static void bench_result_print(const char *name, const struct bench_result *scan, const struct bench_result *hash) {
+	printf("%-24s %6llu inputs | scan: mean %8.1f, max %6llu | lookup_search(): mean %8.1f, max %6llu\n", name,
+		(unsigned long long)scan->count,
+		(double)scan->cycles/scan->count, (unsigned long long)scan->cycles_max,
+		(double)hash->cycles/hash->count, (unsigned long long)hash->cycles_max);
+}
+
+// Returns nonzero if both functions disagree
+static int bench_run(const struct bench_input *input, struct bench_result *scan, struct bench_result *hash, uint32_t *codepoint) {
+	uint8_t keys[LOOKUP_INPUT_LENGTH_MAX];
+	memcpy(keys, input->keys, sizeof(keys));
+
+	uint64_t start = sim_cycles;
+	uint32_t expected = bench_lookup_search_scan(keys, input->length);
+	bench_result_add(scan, sim_cycles-start);
+
+	start = sim_cycles;
+	uint32_t actual = lookup_search(keys, input->length);
+	bench_result_add(hash, sim_cycles-start);
+
+	*codepoint = expected;
+	if(expected != actual) {
+		fprintf(stderr, "Mismatch for input of length %zu: expected 0x%X, got 0x%X\n", input->length, expected, actual);
+		return 1;
+	}
+	return 0;
+}
+
+// Returns 1 if any of the triggers starts with the input
+static uint8_t bench_is_prefix(const struct bench_input *triggers, size_t trigger_count, const struct bench_input *input) {
+	for(size_t i=0; i<trigger_count; i++) {
+		if(triggers[i].length >= input->length && !memcmp(triggers[i].keys, input->keys, input->length)) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Type every trigger key by key like the main loop does: a transition in the trie, then lookup_search() only if
+// the trie says that the input is complete. That's compared with lookup_search() of the whole input for every key.
+// Returns nonzero if the trie disagrees with lookup_search() or with the triggers.
+static int bench_trie(const struct bench_input *triggers, size_t trigger_count) {
+	struct bench_result full = {0}, incremental = {0};
+	int error = 0;
+	for(size_t i=0; i<trigger_count; i++) {
+		uint16_t node = LOOKUP_TRIE_ROOT;
+		for(size_t length=1; length<=triggers[i].length; length++) {
+			struct bench_input input = triggers[i];
+			input.length = length;
+			memset(&input.keys[length], 0, sizeof(input.keys)-length);
+
+			uint64_t start = sim_cycles;
+			uint32_t expected = lookup_search(input.keys, length);
+			bench_result_add(&full, sim_cycles-start);
+
+			start = sim_cycles;
+			node = lookup_trie_next(node, input.keys[length-1]);
+			uint32_t actual = lookup_trie_is_terminal(node) ? lookup_search(input.keys, length) : 0;
+			bench_result_add(&incremental, sim_cycles-start);
+
+			if(expected != actual || node == LOOKUP_TRIE_DEAD_END) {
+				fprintf(stderr, "Trie mismatch for trigger #%zu at length %zu\n", i, length);
+				error = 1;
+			}
+
+			// Every key that doesn't continue any trigger must be a dead end
+			for(uint8_t key_id=ILONENA_KEY_1; key_id<=ILONENA_KEY_G && length < LOOKUP_INPUT_LENGTH_MAX; key_id++) {
+				struct bench_input next = input;
+				next.keys[next.length++] = key_id;
+				if((lookup_trie_next(node, key_id) != LOOKUP_TRIE_DEAD_END) != bench_is_prefix(triggers, trigger_count, &next)) {
+					fprintf(stderr, "Trie dead end mismatch for trigger #%zu at length %zu, key %u\n", i, length, key_id);
+					error = 1;
+				}
+			}
+		}
+	}
+	printf("%-24s %6llu keys   | lookup_search(): mean %8.1f, max %6llu | trie: mean %8.1f, max %6llu\n", "keys typed",
+		(unsigned long long)full.count,
+		(double)full.cycles/full.count, (unsigned long long)full.cycles_max,
+		(double)incremental.cycles/incremental.count, (unsigned long long)incremental.cycles_max);
+	return error;
+}
+
+int main(void) {
+	size_t trigger_count = LOOKUP_COMPACT_TABLE_LENGTH + LOOKUP_FULL_TABLE_LENGTH;
+	struct bench_input *triggers = malloc(trigger_count*sizeof(*triggers));
+	for(size_t i=0; i<LOOKUP_COMPACT_TABLE_LENGTH; i++) {
+		triggers[i] = bench_decode_u52((uint64_t)LOOKUP_COMPACT_TABLE[i].input << 24);
+	}
+	for(size_t i=0; i<LOOKUP_FULL_TABLE_LENGTH; i++) {
+		triggers[LOOKUP_COMPACT_TABLE_LENGTH+i] = bench_decode_u52(LOOKUP_FULL_TABLE[i].input_u52);
+	}
+
+	struct bench_result trigger_scan = {0}, trigger_hash = {0};
+	struct bench_result prefix_scan = {0}, prefix_hash = {0};
+	int error = 0;
+	for(size_t i=0; i<trigger_count; i++) {
+		uint32_t codepoint;
+		error |= bench_run(&triggers[i], &trigger_scan, &trigger_hash, &codepoint);
+		if(!codepoint) {
+			fprintf(stderr, "Trigger #%zu isn't found\n", i);
+			error = 1;
+		}
+		// The prefixes that don't match anything. That's what lookup_search() sees while the user is typing.
+		for(size_t length=1; length<triggers[i].length; length++) {
+			struct bench_input prefix = triggers[i];
+			prefix.length = length;
+			memset(&prefix.keys[length], 0, sizeof(prefix.keys)-length);
+			struct bench_result scan = {0}, hash = {0};
+			bench_run(&prefix, &scan, &hash, &codepoint);
+			if(!codepoint) {
+				error |= bench_run(&prefix, &prefix_scan, &prefix_hash, &codepoint);
+			}
+		}
+	}
+
+	printf("Virtual clock: %u cycles per basic block\n", (unsigned)sim_config.cycles_per_block);
+	bench_result_print("triggers", &trigger_scan, &trigger_hash);
+	bench_result_print("non-matching prefixes", &prefix_scan, &prefix_hash);
+	if(error) {
+		printf("FAILED: lookup_search() disagrees with the linear scan\n");
+		return 1;
+	}
+	if(bench_trie(triggers, trigger_count)) {
+		printf("FAILED: LOOKUP_TRIE disagrees with lookup_search()\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,224 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Measures the throughput of the keyboard output in USB polls per glyph, for each enum keyboard_output_mode.
+// Every glyph of codepage 0 is written with keyboard_write_codepoint() as soon as keyboard_out_queue has room for it,
+// while the simulated host polls the keyboard and turns the HID reports into text. The text is checked as well.
+// The CPU cycles of usb_handle_user_in_request() are measured meanwhile. The "helper" row is the windows mode with the
+// helper of the vendor interface running on the host, which takes the text as UTF-8 instead.
+// The lock handshake rows write one glyph per packet in the linux mode, each one after the previous one has been typed,
+// so that every glyph gets its own lock handshake. The host echoes the lock state after various delays, or never.
+// The layout rows type in the latin and the linux modes with each enum keyboard_layout, on a host with that layout.
+// Usage: bench_output
+
+#include "sim.h"
+#include "lookup.h"
+#include "keyboard.h"
+#include "tinyusb_hid.h"
+#include <stdio.h>
+
+#define BENCH_SETTLE_POLLS (16) // Polls for the last glyph to get through the lock restoration, not counted
+#define BENCH_PACKET_GAP_POLLS (8) // Polls between the packets of the lock handshake rows, not counted
+
+extern size_t keyboard_report_queue_write_index;
+extern size_t keyboard_report_queue_read_index;
+
+static enum keyboard_output_mode bench_mode;
+static enum keyboard_layout bench_layout;
+static uint8_t bench_packet_per_glyph;
+static uint64_t bench_polls;
+static uint64_t bench_lock_wait_polls;
+// CPU cycles of usb_handle_user_in_request() while typing
+static uint64_t bench_handler_cycles;
+static uint64_t bench_handler_cycles_max;
+
+static void bench_wait_polls(uint64_t count) {
+	uint64_t end = sim_stats.usb_polls+count;
+	while(sim_stats.usb_polls < end) {
+		keyboard_loop();
+	}
+}
+
+static void bench_wait_idle(void) {
+	while(keyboard_get_pending_count() || keyboard_report_queue_read_index != keyboard_report_queue_write_index) {
+		keyboard_loop();
+	}
+}
+
+// Run by sim_run() in place of the firmware main loop
+static int bench_output_main(void) {
+	keyboard_init();
+	keyboard_set_layout(bench_layout);
+	bench_wait_polls(2); // Enumeration and the LED output report of the host
+
+	uint64_t polls_start = sim_stats.usb_polls;
+	uint64_t gap_polls = 0;
+	uint64_t handler_cycles_start = sim_stats.usb_handler_cycles;
+	uint32_t lock_wait_polls_start = keyboard_usb_stats.lock_wait_polls;
+	sim_stats.usb_handler_cycles_max = 0;
+	for(size_t i=0; i<LOOKUP_CODEPAGE_0_LENGTH; i++) {
+		while(!keyboard_write_codepoint(bench_mode, LOOKUP_CODEPAGE_0_START+i)) {
+			keyboard_loop(); // Wait for room in the queue
+		}
+		if(bench_packet_per_glyph) {
+			bench_wait_idle();
+			bench_wait_polls(BENCH_PACKET_GAP_POLLS);
+			gap_polls += BENCH_PACKET_GAP_POLLS;
+		}
+	}
+	bench_wait_idle();
+	bench_polls = sim_stats.usb_polls-polls_start-gap_polls;
+	bench_lock_wait_polls = keyboard_usb_stats.lock_wait_polls-lock_wait_polls_start;
+	bench_handler_cycles = sim_stats.usb_handler_cycles-handler_cycles_start;
+	bench_handler_cycles_max = sim_stats.usb_handler_cycles_max;
+
+	bench_wait_polls(BENCH_SETTLE_POLLS);
+	return 0;
+}
+
+// Returns nonzero if the text typed on the host isn't the one of the glyphs
+static int bench_check_text(void) {
+	uint32_t expected[8192];
+	size_t expected_length = 0;
+	for(size_t i=0; i<LOOKUP_CODEPAGE_0_LENGTH; i++) {
+		if(bench_mode != KEYBOARD_OUTPUT_MODE_LATIN) {
+			expected[expected_length++] = LOOKUP_CODEPAGE_0_START+i;
+			continue;
+		}
+		// See keyboard_write_ascii_string() for the trailing space
+		struct lookup_ascii_string str;
+		lookup_get_ascii_string(&str, 0, i);
+		char c, first = '\0', last = '\0';
+		size_t length = 0;
+		while((c = lookup_ascii_string_next(&str)) != '\0') {
+			first = length ? first : c;
+			last = c;
+			expected[expected_length++] = c;
+			length++;
+		}
+		if((first == ':' && length > 1) || (last >= 'a' && last <= 'z')) {
+			expected[expected_length++] = ' ';
+		}
+	}
+
+	const uint32_t *text;
+	size_t text_length = sim_host_get_text(&text);
+	if(text_length != expected_length) {
+		fprintf(stderr, "Typed %zu characters, expected %zu\n", text_length, expected_length);
+		return 1;
+	}
+	for(size_t i=0; i<text_length; i++) {
+		if(text[i] != expected[i]) {
+			fprintf(stderr, "Mismatch at character #%zu: U+%04X, expected U+%04X\n", i, (unsigned)text[i], (unsigned)expected[i]);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main(void) {
+	static const struct {
+		const char *name;
+		enum keyboard_output_mode mode;
+		enum sim_host_input_method host_input_method;
+		uint8_t host_helper;
+	} modes[] = {
+		{"latin", KEYBOARD_OUTPUT_MODE_LATIN, SIM_HOST_INPUT_METHOD_LATIN, 0},
+		{"windows", KEYBOARD_OUTPUT_MODE_WINDOWS, SIM_HOST_INPUT_METHOD_WINDOWS, 0},
+		{"linux", KEYBOARD_OUTPUT_MODE_LINUX, SIM_HOST_INPUT_METHOD_LINUX, 0},
+		{"macos", KEYBOARD_OUTPUT_MODE_MACOS, SIM_HOST_INPUT_METHOD_MACOS, 0},
+		{"compose", KEYBOARD_OUTPUT_MODE_COMPOSE, SIM_HOST_INPUT_METHOD_COMPOSE, 0},
+		{"helper", KEYBOARD_OUTPUT_MODE_WINDOWS, SIM_HOST_INPUT_METHOD_WINDOWS, 1},
+	};
+	int error = 0;
+	printf("USB polling interval: %uus, %zu glyphs of codepage 0 per mode\n", (unsigned)sim_config.usb_poll_interval_us, (size_t)LOOKUP_CODEPAGE_0_LENGTH);
+	for(size_t i=0; i<sizeof(modes)/sizeof(*modes); i++) {
+		bench_mode = modes[i].mode;
+		sim_config.host_input_method = modes[i].host_input_method;
+		sim_config.host_helper = modes[i].host_helper;
+		sim_run(bench_output_main, UINT64_MAX);
+		int mode_error = bench_check_text();
+		printf("%-8s %6llu polls | %5.2f polls per glyph | %7.1f glyphs per second | ISR cycles mean %5.1f, max %4llu%s\n", modes[i].name,
+			(unsigned long long)bench_polls, (double)bench_polls/LOOKUP_CODEPAGE_0_LENGTH,
+			LOOKUP_CODEPAGE_0_LENGTH*1e6/((double)bench_polls*sim_config.usb_poll_interval_us),
+			(double)bench_handler_cycles/bench_polls, (unsigned long long)bench_handler_cycles_max,
+			mode_error ? " | FAILED: wrong text typed" : "");
+		error |= mode_error;
+	}
+
+	static const struct {
+		const char *name;
+		int32_t host_led_echo_delay_us;
+	} echoes[] = {
+		{"2ms", 2000},
+		{"20ms", 20000},
+		{"never", -1},
+	};
+	printf("Lock handshake, one packet per glyph in the linux mode with Caps Lock on, by the delay of the LED output report of the host\n");
+	bench_mode = KEYBOARD_OUTPUT_MODE_LINUX;
+	bench_packet_per_glyph = 1;
+	// Caps Lock gets turned off for typing the hex digits and back on after each glyph, so the handshake has some work
+	sim_config.host_leds = KEYBOARD_LED_CAPSLOCK;
+	sim_config.host_input_method = SIM_HOST_INPUT_METHOD_LINUX;
+	sim_config.host_helper = 0;
+	for(size_t i=0; i<sizeof(echoes)/sizeof(*echoes); i++) {
+		sim_config.host_led_echo_delay_us = echoes[i].host_led_echo_delay_us;
+		sim_run(bench_output_main, UINT64_MAX);
+		int echo_error = bench_check_text();
+		printf("%-8s %6llu polls | %5.2f polls per glyph | %5.2f of them waiting for the locks%s\n", echoes[i].name,
+			(unsigned long long)bench_polls, (double)bench_polls/LOOKUP_CODEPAGE_0_LENGTH,
+			(double)bench_lock_wait_polls/LOOKUP_CODEPAGE_0_LENGTH,
+			echo_error ? " | FAILED: wrong text typed" : "");
+		error |= echo_error;
+	}
+
+	static const char *layout_names[] = {"qwerty", "azerty", "qwertz", "czech", "dvorak"};
+	printf("Keyboard layouts of the host, polls per glyph in the latin and the linux modes\n");
+	bench_packet_per_glyph = 0;
+	sim_config.host_leds = 0;
+	sim_config.host_led_echo_delay_us = 2000;
+	for(size_t i=0; i<KEYBOARD_LAYOUT_END; i++) {
+		bench_layout = i;
+		sim_config.host_layout = i;
+		double polls_per_glyph[2];
+		int layout_error = 0;
+		for(size_t j=0; j<2; j++) {
+			bench_mode = j ? KEYBOARD_OUTPUT_MODE_LINUX : KEYBOARD_OUTPUT_MODE_LATIN;
+			sim_config.host_input_method = j ? SIM_HOST_INPUT_METHOD_LINUX : SIM_HOST_INPUT_METHOD_LATIN;
+			sim_run(bench_output_main, UINT64_MAX);
+			layout_error |= bench_check_text();
+			polls_per_glyph[j] = (double)bench_polls/LOOKUP_CODEPAGE_0_LENGTH;
+		}
+		printf("%-8s %5.2f latin | %5.2f linux%s\n", layout_names[i], polls_per_glyph[0], polls_per_glyph[1],
+			layout_error ? " | FAILED: wrong text typed" : "");
+		error |= layout_error;
+	}
+	if(sim_stats.usb_unanswered_polls) {
+		printf("FAILED: %llu polls without any response\n", (unsigned long long)sim_stats.usb_unanswered_polls);
+		error = 1;
+	}
+	return error;
+}
@@ -0,0 +1,95 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Benchmark of the packed strings of codepage 0 and 1: lookup_get_ascii_string() followed by
+// lookup_ascii_string_next() until the end of the string, for every string. The cycles are the ones of the virtual clock.
+// Usage: ./bench_strings [-d]
+// -d: Dump each string as "<codepage> <index> <string>" for test_ascii_strings.py instead of benchmarking
+
+#include "sim.h"
+#include "lookup.h"
+#include <stdio.h>
+#include <string.h>
+
+struct bench_result {
+	uint64_t count;
+	uint64_t cycles;
+	uint64_t cycles_max;
+};
+
+static void bench_result_add(struct bench_result *result, uint64_t cycles) {
+	result->count++;
+	result->cycles += cycles;
+	if(cycles > result->cycles_max) {
+		result->cycles_max = cycles;
+	}
+}
+
+static void bench_codepage(uint8_t codepage, size_t length, int dump) {
+	struct bench_result fetch = {0}, decode = {0};
+	uint64_t characters = 0;
+	for(size_t i=0; i<length; i++) {
+		struct lookup_ascii_string str;
+		uint64_t start = sim_cycles;
+		lookup_get_ascii_string(&str, codepage, i);
+		bench_result_add(&fetch, sim_cycles-start);
+
+		if(dump) {
+			printf("%u %zu ", codepage, i);
+		}
+		start = sim_cycles;
+		char c;
+		while((c = lookup_ascii_string_next(&str)) != '\0') {
+			characters++;
+			if(dump) {
+				// Escaped so that the whitespaces survive the dump
+				printf("%02X", (unsigned)c);
+			}
+		}
+		bench_result_add(&decode, sim_cycles-start);
+		if(dump) {
+			printf("\n");
+		}
+	}
+	if(!dump) {
+		printf("codepage %u %4llu strings, %5llu chars | lookup_get_ascii_string(): mean %5.1f, max %3llu | "
+			"lookup_ascii_string_next() until the end: mean %6.1f, max %4llu, %4.1f per char\n",
+			codepage, (unsigned long long)fetch.count, (unsigned long long)characters,
+			(double)fetch.cycles/fetch.count, (unsigned long long)fetch.cycles_max,
+			(double)decode.cycles/decode.count, (unsigned long long)decode.cycles_max,
+			(double)decode.cycles/(characters+decode.count)); // +1 call per string for the end
+	}
+}
+
+int main(int argc, char *argv[]) {
+	int dump = (argc > 1 && !strcmp(argv[1], "-d"));
+	if(!dump) {
+		printf("Virtual clock: %u cycles per basic block\n", (unsigned)sim_config.cycles_per_block);
+	}
+	bench_codepage(0, LOOKUP_CODEPAGE_0_LENGTH, dump);
+	bench_codepage(1, LOOKUP_CODEPAGE_1_LENGTH, dump);
+	return 0;
+}
@@ -0,0 +1,289 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Stand-in for ch32fun.h used by the host simulator. Only the registers and bit definitions that the firmware
+// touches are provided. The registers are plain memory. sim.c watches them between basic blocks of the
+// firmware and reacts like the peripherals of CH32V003 would.
+// The bit values are the same as the ones of the real chip so that register dumps can be compared with the datasheet.
+
+#ifndef ILONENA_SIM_CH32FUN_H
+#define ILONENA_SIM_CH32FUN_H
+
+#include "funconfig.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifndef FUNCONF_SYSTEM_CORE_CLOCK
+#define FUNCONF_SYSTEM_CORE_CLOCK (48000000) // Same default as ch32fun
+#endif
+
+// The firmware uses RISC-V fences as memory barriers. The simulator is single-threaded so they're no-op.
+// Defining it as an assembler macro keeps the firmware source untouched.
+__asm__(".macro fence args:vararg\n.endm");
+
+#define INTERRUPT_DECORATOR
+
+typedef struct {
+	volatile uint32_t CFGLR;
+	volatile uint32_t INDR;
+	volatile uint32_t OUTDR;
+	volatile uint32_t BSHR;
+	volatile uint32_t BCR;
+	volatile uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef struct {
+	volatile uint16_t CTLR1;
+	volatile uint16_t CTLR2;
+	volatile uint16_t OADDR1;
+	volatile uint16_t OADDR2;
+	volatile uint16_t DATAR;
+	volatile uint16_t STAR1;
+	volatile uint16_t STAR2;
+	volatile uint16_t CKCFGR;
+} I2C_TypeDef;
+
+typedef struct {
+	volatile uint32_t INTFR;
+	volatile uint32_t INTFCR;
+} DMA_TypeDef;
+
+typedef struct {
+	volatile uint32_t CFGR;
+	volatile uint32_t CNTR;
+	volatile uint32_t PADDR;
+	volatile uint32_t MADDR;
+} DMA_Channel_TypeDef;
+
+typedef struct {
+	volatile uint32_t CTLR;
+	volatile uint32_t SR;
+	volatile uint32_t CNT;
+	volatile uint32_t CMP;
+} SysTick_Type;
+
+typedef struct {
+	volatile uint16_t CTLR1;
+	volatile uint16_t DMAINTENR;
+	volatile uint16_t INTFR;
+	volatile uint16_t CNT;
+	volatile uint16_t PSC;
+	volatile uint16_t ATRLR;
+} TIM_TypeDef;
+
+typedef struct {
+	volatile uint32_t IENR[2];
+	volatile uint32_t IRER[2];
+	volatile uint8_t IPRIOR[256];
+} PFIC_Type;
+
+typedef struct {
+	volatile uint32_t CTLR;
+	volatile uint32_t PSCR;
+	volatile uint32_t RLDR;
+	volatile uint32_t STATR;
+} IWDG_TypeDef;
+
+typedef struct {
+	volatile uint32_t AHBPCENR;
+	volatile uint32_t APB2PCENR;
+	volatile uint32_t APB1PCENR;
+} RCC_TypeDef;
+
+typedef struct {
+	volatile uint32_t KEYR;
+	volatile uint32_t OBKEYR;
+	volatile uint32_t STATR;
+	volatile uint32_t CTLR;
+} FLASH_TypeDef;
+
+typedef struct {
+	volatile uint16_t RDPR;
+	volatile uint16_t USER;
+	volatile uint16_t Data0;
+	volatile uint16_t Data1;
+	volatile uint16_t WRPR0;
+	volatile uint16_t WRPR1;
+	volatile uint16_t RESERVED[2];
+} OB_TypeDef;
+
+// Peripheral instances, defined in sim.c
+extern GPIO_TypeDef sim_gpioa, sim_gpioc, sim_gpiod;
+extern I2C_TypeDef sim_i2c1;
+extern DMA_TypeDef sim_dma1;
+extern DMA_Channel_TypeDef sim_dma1_channel6;
+extern SysTick_Type sim_systick;
+extern TIM_TypeDef sim_tim2;
+extern PFIC_Type sim_pfic;
+extern IWDG_TypeDef sim_iwdg;
+extern RCC_TypeDef sim_rcc;
+extern FLASH_TypeDef sim_flash;
+extern OB_TypeDef sim_ob;
+
+#define GPIOA (&sim_gpioa)
+#define GPIOC (&sim_gpioc)
+#define GPIOD (&sim_gpiod)
+#define I2C1 (&sim_i2c1)
+#define DMA1 (&sim_dma1)
+#define DMA1_Channel6 (&sim_dma1_channel6)
+#define SysTick (&sim_systick)
+#define TIM2 (&sim_tim2)
+#define PFIC (&sim_pfic)
+#define IWDG (&sim_iwdg)
+#define RCC (&sim_rcc)
+#define FLASH (&sim_flash)
+#define OB_BASE ((uintptr_t)&sim_ob)
+#define OB (&sim_ob)
+
+#define TIM2_IRQn (38)
+
+// GPIO
+#define GPIO_CFGLR_MODE0 (0x3U<<0)
+#define GPIO_CFGLR_MODE1 (0x3U<<4)
+#define GPIO_CFGLR_MODE2 (0x3U<<8)
+#define GPIO_CFGLR_MODE3 (0x3U<<12)
+#define GPIO_CFGLR_MODE4 (0x3U<<16)
+#define GPIO_CFGLR_MODE5 (0x3U<<20)
+#define GPIO_CFGLR_MODE6 (0x3U<<24)
+#define GPIO_CFGLR_MODE7 (0x3U<<28)
+#define GPIO_CFGLR_MODE1_1 (0x2U<<4)
+#define GPIO_CFGLR_MODE2_1 (0x2U<<8)
+#define GPIO_CFGLR_MODE5_1 (0x2U<<20)
+#define GPIO_CFGLR_MODE6_1 (0x2U<<24)
+#define GPIO_CFGLR_MODE7_1 (0x2U<<28)
+#define GPIO_CFGLR_CNF0 (0x3U<<2)
+#define GPIO_CFGLR_CNF1 (0x3U<<6)
+#define GPIO_CFGLR_CNF2 (0x3U<<10)
+#define GPIO_CFGLR_CNF3 (0x3U<<14)
+#define GPIO_CFGLR_CNF4 (0x3U<<18)
+#define GPIO_CFGLR_CNF5 (0x3U<<22)
+#define GPIO_CFGLR_CNF6 (0x3U<<26)
+#define GPIO_CFGLR_CNF7 (0x3U<<30)
+#define GPIO_CFGLR_CNF0_1 (0x2U<<2)
+#define GPIO_CFGLR_CNF1_0 (0x1U<<6)
+#define GPIO_CFGLR_CNF1_1 (0x2U<<6)
+#define GPIO_CFGLR_CNF2_0 (0x1U<<10)
+#define GPIO_CFGLR_CNF2_1 (0x2U<<10)
+#define GPIO_CFGLR_CNF3_1 (0x2U<<14)
+#define GPIO_CFGLR_CNF4_1 (0x2U<<18)
+#define GPIO_CFGLR_CNF5_0 (0x1U<<22)
+#define GPIO_CFGLR_CNF5_1 (0x2U<<22)
+#define GPIO_CFGLR_CNF6_0 (0x1U<<26)
+#define GPIO_CFGLR_CNF6_1 (0x2U<<26)
+#define GPIO_CFGLR_CNF7_0 (0x1U<<30)
+#define GPIO_INDR_IDR0 (1U<<0)
+#define GPIO_INDR_IDR1 (1U<<1)
+#define GPIO_INDR_IDR2 (1U<<2)
+#define GPIO_INDR_IDR3 (1U<<3)
+#define GPIO_INDR_IDR4 (1U<<4)
+#define GPIO_INDR_IDR5 (1U<<5)
+#define GPIO_INDR_IDR6 (1U<<6)
+#define GPIO_INDR_IDR7 (1U<<7)
+#define GPIO_BSHR_BS0 (1U<<0)
+#define GPIO_BSHR_BS1 (1U<<1)
+#define GPIO_BSHR_BS2 (1U<<2)
+#define GPIO_BSHR_BS3 (1U<<3)
+#define GPIO_BSHR_BS4 (1U<<4)
+#define GPIO_BSHR_BS5 (1U<<5)
+#define GPIO_BSHR_BS6 (1U<<6)
+#define GPIO_BSHR_BS7 (1U<<7)
+#define GPIO_BSHR_BR0 (1U<<16)
+#define GPIO_BSHR_BR1 (1U<<17)
+#define GPIO_BSHR_BR2 (1U<<18)
+#define GPIO_BSHR_BR3 (1U<<19)
+#define GPIO_BSHR_BR4 (1U<<20)
+#define GPIO_BSHR_BR5 (1U<<21)
+#define GPIO_BSHR_BR6 (1U<<22)
+#define GPIO_BSHR_BR7 (1U<<23)
+
+// I2C
+#define I2C_CTLR1_PE (0x0001U)
+#define I2C_CTLR1_START (0x0100U)
+#define I2C_CTLR1_STOP (0x0200U)
+#define I2C_CTLR1_ACK (0x0400U)
+#define I2C_CTLR1_SWRST (0x8000U)
+#define I2C_CTLR2_FREQ (0x003FU)
+#define I2C_CTLR2_DMAEN (0x0800U)
+#define I2C_STAR1_SB (0x0001U)
+#define I2C_STAR1_ADDR (0x0002U)
+#define I2C_STAR1_BTF (0x0004U)
+#define I2C_STAR1_TXE (0x0080U)
+#define I2C_STAR1_BERR (0x0100U)
+#define I2C_STAR1_ARLO (0x0200U)
+#define I2C_STAR1_AF (0x0400U)
+#define I2C_STAR1_OVR (0x0800U)
+#define I2C_STAR1_PECERR (0x1000U)
+#define I2C_STAR2_MSL (0x0001U)
+#define I2C_STAR2_BUSY (0x0002U)
+#define I2C_STAR2_TRA (0x0004U)
+#define I2C_CKCFGR_CCR (0x0FFFU)
+#define I2C_CKCFGR_FS (0x8000U)
+
+// DMA
+#define DMA_CFGR6_EN (1U<<0)
+#define DMA_CFGR6_DIR (1U<<4)
+#define DMA_CFGR6_MINC (1U<<7)
+#define DMA_TCIF6 (1U<<21)
+#define DMA_TEIF6 (1U<<23)
+#define DMA_CTCIF6 (1U<<21)
+#define DMA_CTEIF6 (1U<<23)
+
+// RCC
+#define RCC_DMA1EN (1U<<0)
+#define RCC_APB2Periph_AFIO (1U<<0)
+#define RCC_IOPAEN (1U<<2)
+#define RCC_IOPCEN (1U<<4)
+#define RCC_IOPDEN (1U<<5)
+#define RCC_APB2Periph_GPIOC RCC_IOPCEN
+#define RCC_TIM2EN (1U<<0)
+#define RCC_APB1Periph_I2C1 (1U<<21)
+
+// TIM
+#define TIM_CEN (0x0001U)
+#define TIM_URS (0x0004U)
+#define TIM_OPM (0x0008U)
+#define TIM_UIE (0x0001U)
+#define TIM_UIF (0x0001U)
+
+// FLASH
+#define FLASH_KEY1 (0x45670123U)
+#define FLASH_KEY2 (0xCDEF89ABU)
+#define FLASH_BUSY (1U<<0)
+#define FLASH_STATR_EOP (1U<<5)
+#define FLASH_CTLR_OPTPG (1U<<4)
+#define FLASH_CTLR_OPTER (1U<<5)
+#define FLASH_CTLR_STRT (1U<<6)
+#define FLASH_CTLR_LOCK (1U<<7)
+#define FLASH_CTLR_OPTWRE (1U<<9)
+
+void SystemInit(void);
+void Delay_Ms(uint32_t ms);
+void Delay_Us(uint32_t us);
+uint32_t __get_INTSYSCR(void);
+void __set_INTSYSCR(uint32_t value);
+
+#endif
@@ -0,0 +1,870 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "sim.h"
+#include "ch32fun.h"
+#include "rv003usb.h"
+#include "lookup.h"
+#include "keyboard.h"
+#include "display.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void TIM2_IRQHandler(void);
+
+#define SIM_SERVICE_INTERVAL (10*SIM_CYCLES_PER_US) // Peripherals are updated at least this often
+#define SIM_MAIN_LOOP_STALL (1*SIM_CYCLES_PER_MS) // Main loop iterations longer than this are counted as stalls
+#define SIM_WATCHDOG_TIMEOUT ((uint64_t)FUNCONF_SYSTEM_CORE_CLOCK/1000 * 8190) // 128kHz / 256 / 0xFFF. See watchdog.c
+#define SIM_USB_ENUMERATION_DELAY (50*SIM_CYCLES_PER_MS) // First poll of the host after usb_setup()
+// Cost of a transaction on the bit-banged low speed USB bus (1.5Mbit/s, 32 CPU cycles per bit).
+// The CPU is busy in the USB interrupt during the whole transaction.
+#define SIM_USB_CYCLES_PER_BIT (FUNCONF_SYSTEM_CORE_CLOCK/1500000)
+#define SIM_USB_TOKEN_BITS (35) // SYNC, PID, ADDR, ENDP, CRC5, EOP
+#define SIM_USB_HANDSHAKE_BITS (19) // SYNC, PID, EOP
+#define SIM_USB_DATA_OVERHEAD_BITS (35) // SYNC, PID, CRC16, EOP
+#define SIM_USB_PID_NAK (0x5A) // Token passed to usb_send_data() for sending a NAK handshake
+#define SIM_SSD1306_I2C_ADDR (0x3C)
+#define SIM_DISPLAY_PAGES (4) // Only the top 4 pages are visible on the 128x32 OLED
+
+GPIO_TypeDef sim_gpioa, sim_gpioc, sim_gpiod;
+I2C_TypeDef sim_i2c1;
+DMA_TypeDef sim_dma1;
+DMA_Channel_TypeDef sim_dma1_channel6;
+SysTick_Type sim_systick;
+TIM_TypeDef sim_tim2;
+PFIC_Type sim_pfic;
+IWDG_TypeDef sim_iwdg;
+RCC_TypeDef sim_rcc;
+FLASH_TypeDef sim_flash;
+OB_TypeDef sim_ob = {.RDPR=0x5AA5, .USER=0x08F7, .Data0=0xFFFF, .Data1=0xFFFF, .WRPR0=0xFFFF, .WRPR1=0xFFFF};
+
+struct sim_config sim_config = {
+	.cycles_per_block = 6,
+	.usb_poll_interval_us = 3000, // bInterval of the keyboard endpoint in usb_config.h
+	.host_leds = 0,
+	.host_led_echo_delay_us = 2000,
+	.host_input_method = SIM_HOST_INPUT_METHOD_LATIN,
+	.host_layout = KEYBOARD_LAYOUT_QWERTY,
+	.compose_path = "../compose/ilonena.XCompose",
+	.host_helper = 0,
+	.output_dir = NULL,
+	.i2c_clockrate_max = 0,
+};
+struct sim_stats sim_stats;
+uint64_t sim_cycles = 0;
+
+static uint64_t sim_next_service = 0;
+static uint64_t sim_end_cycle = UINT64_MAX;
+static jmp_buf sim_end_jmp;
+static uint8_t sim_watchdog_reset = 0;
+
+// Interrupt state
+static uint8_t sim_in_tim2 = 0;
+static uint8_t sim_in_usb = 0;
+static uint8_t sim_tim2_irq_enabled = 0;
+static uint8_t sim_tim2_running = 0;
+static uint64_t sim_tim2_expiry;
+static uint64_t sim_interrupt_cycles = 0; // Time spent in the interrupt handlers, including the time on the USB bus
+
+// Key timeline
+struct sim_key_event {
+	uint64_t cycle;
+	uint8_t key_id;
+	uint8_t pressed;
+};
+static struct sim_key_event *sim_key_events = NULL;
+static size_t sim_key_events_length = 0;
+static size_t sim_key_events_capacity = 0;
+static size_t sim_key_events_index = 0;
+static uint32_t sim_keys_held = 0; // Bit (key_id-1) is set if the key is held
+
+// USB
+static uint8_t sim_usb_connected = 0;
+static uint64_t sim_usb_next_poll;
+static uint8_t sim_usb_sent;
+static uint8_t sim_usb_naked; // The firmware answered the poll with a NAK
+static uint64_t sim_usb_bus_cycles; // Bus time spent in usb_send_data() and usb_send_empty()
+static uint8_t sim_usb_report[8];
+static uint8_t sim_usb_report_prev[8];
+static uint64_t sim_usb_led_echo_cycle = UINT64_MAX;
+static uint8_t sim_usb_led_echo_value;
+static uint64_t sim_usb_vendor_next_poll; // Only used with sim_config.host_helper
+static uint64_t sim_usb_vendor_next_hello;
+static FILE *sim_hid_log = NULL;
+
+// Latency bookkeeping. Each key press waits for the first report change and the first frame that follow it
+struct sim_latency {
+	uint64_t press_cycle;
+	uint64_t report_cycle; // 0 if there's none before the next key press
+	uint64_t frame_cycle;
+};
+static struct sim_latency *sim_latencies = NULL;
+static size_t sim_latencies_length = 0;
+
+// I2C, DMA and the SSD1306
+static enum {
+	SIM_I2C_IDLE,
+	SIM_I2C_START,
+	SIM_I2C_WAIT_ADDRESS,
+	SIM_I2C_ADDRESS,
+	SIM_I2C_WAIT_DATA,
+	SIM_I2C_DMA,
+	SIM_I2C_STOP,
+} sim_i2c_state = SIM_I2C_IDLE;
+#define SIM_I2C_DATAR_EMPTY (0xFFFF) // DATAR is set to this value to detect a write of the firmware
+static uint64_t sim_i2c_done_cycle;
+static uint64_t sim_i2c_dma_start_cycle;
+static uint32_t sim_i2c_dma_total;
+static uint32_t sim_i2c_dma_sent;
+static uint64_t sim_i2c_transaction_start_cycle;
+
+static struct {
+	uint8_t gddram[8][128];
+	uint8_t addressing_mode; // 0: horizontal, 1: vertical, 2: page
+	uint8_t col_start, col_end, col;
+	uint8_t page_start, page_end, page;
+	uint8_t display_on;
+	// Parser state of the current transaction
+	enum { SIM_SSD1306_CONTROL, SIM_SSD1306_SINGLE, SIM_SSD1306_STREAM } byte_kind;
+	uint8_t is_data;
+	uint8_t command[8];
+	uint8_t command_length;
+	uint32_t data_bytes; // Graphic data bytes received in the current transaction
+} sim_ssd1306;
+
+static uint8_t sim_watchdog_enabled = 0;
+static uint64_t sim_watchdog_last_feed = 0;
+
+void sim_schedule_key(uint64_t cycle, uint8_t key_id, uint8_t pressed) {
+	if(sim_key_events_length >= sim_key_events_capacity) {
+		sim_key_events_capacity = sim_key_events_capacity ? sim_key_events_capacity*2 : 64;
+		sim_key_events = realloc(sim_key_events, sim_key_events_capacity*sizeof(*sim_key_events));
+	}
+	// Keep the timeline sorted. Events are normally scheduled in order so it's cheap.
+	size_t i = sim_key_events_length++;
+	while(i > 0 && sim_key_events[i-1].cycle > cycle) {
+		sim_key_events[i] = sim_key_events[i-1];
+		i--;
+	}
+	sim_key_events[i] = (struct sim_key_event){.cycle=cycle, .key_id=key_id, .pressed=pressed};
+}
+
+static void sim_key_process(void) {
+	while(sim_key_events_index < sim_key_events_length && sim_key_events[sim_key_events_index].cycle <= sim_cycles) {
+		struct sim_key_event *event = &sim_key_events[sim_key_events_index++];
+		if(event->pressed) {
+			sim_keys_held |= 1U << (event->key_id-1);
+			sim_latencies = realloc(sim_latencies, (sim_latencies_length+1)*sizeof(*sim_latencies));
+			sim_latencies[sim_latencies_length++] = (struct sim_latency){.press_cycle=sim_cycles};
+		} else {
+			sim_keys_held &= ~(1U << (event->key_id-1));
+		}
+	}
+}
+
+static struct sim_latency *sim_latency_current(void) {
+	return sim_latencies_length ? &sim_latencies[sim_latencies_length-1] : NULL;
+}
+
+// BSHR is write-only on the real chip. Apply it to OUTDR and clear it.
+static void sim_gpio_apply_bshr(GPIO_TypeDef *gpio) {
+	uint32_t bshr = gpio->BSHR;
+	if(bshr) {
+		gpio->OUTDR = (gpio->OUTDR | (bshr & 0xFFFF)) & ~(bshr >> 16);
+		gpio->BSHR = 0;
+	}
+}
+
+// Key matrix: see button.c. 3 rows on PC7, PC6, PC5 (active low), 6 columns on PD0, PD2~PD6 with pull-up.
+// WEKA and PANA are dedicated buttons on PA1 and PA2.
+static void sim_gpio_update(void) {
+	static const uint8_t column_pins[] = {0, 2, 3, 4, 5, 6};
+	static const uint8_t row_pins[] = {7, 6, 5};
+
+	sim_gpio_apply_bshr(GPIOA);
+	sim_gpio_apply_bshr(GPIOC);
+	sim_gpio_apply_bshr(GPIOD);
+
+	uint32_t columns = 0;
+	for(size_t row=0; row<sizeof(row_pins); row++) {
+		if(GPIOC->OUTDR & (1U << row_pins[row])) {
+			continue; // Row not selected
+		}
+		for(size_t col=0; col<sizeof(column_pins); col++) {
+			if(sim_keys_held & (1U << (row*sizeof(column_pins)+col))) {
+				columns |= 1U << column_pins[col];
+			}
+		}
+	}
+	GPIOD->INDR = 0xFF & ~columns;
+	GPIOA->INDR = 0xFF & ~(((sim_keys_held >> (ILONENA_KEY_WEKA-1)) & 0x01) << 1 | ((sim_keys_held >> (ILONENA_KEY_PANA-1)) & 0x01) << 2);
+	// SDA (PC1) is always released by the SSD1306 in the simulation. That ends the bit-banged I2C reset right away.
+	GPIOC->INDR = GPIOC->OUTDR | GPIO_INDR_IDR1;
+}
+
+static void sim_watchdog_update(void) {
+	if(IWDG->CTLR == 0xAAAA) {
+		IWDG->CTLR = 0;
+		uint64_t interval = sim_cycles - sim_watchdog_last_feed;
+		if(interval > sim_stats.watchdog_feed_interval_max) {
+			sim_stats.watchdog_feed_interval_max = interval;
+		}
+		// The interval before the first feed is the boot, not an iteration of the main loop
+		if(sim_stats.watchdog_feeds) {
+			if(interval > sim_stats.main_loop_interval_max) {
+				sim_stats.main_loop_interval_max = interval;
+			}
+			if(interval > SIM_MAIN_LOOP_STALL) {
+				sim_stats.main_loop_stalls++;
+			}
+		}
+		sim_watchdog_last_feed = sim_cycles;
+		sim_stats.watchdog_feeds++;
+	} else if(IWDG->CTLR == 0xCCCC) {
+		IWDG->CTLR = 0;
+		sim_watchdog_enabled = 1;
+		sim_watchdog_last_feed = sim_cycles;
+	} else if(sim_watchdog_enabled && sim_cycles - sim_watchdog_last_feed >= SIM_WATCHDOG_TIMEOUT) {
+		fprintf(stderr, "sim: watchdog reset at %.3fms\n", (double)sim_cycles/SIM_CYCLES_PER_MS);
+		sim_watchdog_reset = 1;
+		longjmp(sim_end_jmp, 1);
+	}
+}
+
+static void sim_ssd1306_write_frame(void) {
+	if(!sim_config.output_dir) {
+		return;
+	}
+	char path[4096];
+	snprintf(path, sizeof(path), "%s/frame_%05llu.pbm", sim_config.output_dir, (unsigned long long)sim_stats.frames);
+	FILE *f = fopen(path, "wb");
+	if(!f) {
+		perror(path);
+		return;
+	}
+	// Lit pixels are white, like on the OLED. In PBM, bit 1 is black.
+	fprintf(f, "P4\n# t=%.3fms\n%d %d\n", (double)sim_cycles/SIM_CYCLES_PER_MS, 128, SIM_DISPLAY_PAGES*8);
+	for(size_t y=0; y<SIM_DISPLAY_PAGES*8; y++) {
+		for(size_t x=0; x<128; x+=8) {
+			uint8_t b = 0;
+			for(size_t i=0; i<8; i++) {
+				if(!sim_ssd1306.display_on || !(sim_ssd1306.gddram[y/8][x+i] & (1U << (y%8)))) {
+					b |= 0x80 >> i;
+				}
+			}
+			fputc(b, f);
+		}
+	}
+	fclose(f);
+}
+
+static void sim_ssd1306_execute_command(void) {
+	uint8_t *c = sim_ssd1306.command;
+	switch(c[0]) {
+		case 0x20:
+			sim_ssd1306.addressing_mode = c[1] & 0x03;
+		break;
+		case 0x21:
+			sim_ssd1306.col_start = sim_ssd1306.col = c[1] & 0x7F;
+			sim_ssd1306.col_end = c[2] & 0x7F;
+		break;
+		case 0x22:
+			sim_ssd1306.page_start = sim_ssd1306.page = c[1] & 0x07;
+			sim_ssd1306.page_end = c[2] & 0x07;
+		break;
+		case 0xAE:
+		case 0xAF:
+			sim_ssd1306.display_on = c[0] & 0x01;
+		break;
+		default:
+			if(c[0] >= 0xB0 && c[0] <= 0xB7) {
+				sim_ssd1306.page = c[0] & 0x07;
+			} else if(c[0] <= 0x0F) {
+				sim_ssd1306.col = (sim_ssd1306.col & 0xF0) | c[0];
+			} else if(c[0] <= 0x1F) {
+				sim_ssd1306.col = (sim_ssd1306.col & 0x0F) | ((c[0] & 0x07) << 4);
+			}
+			// The other commands don't affect the content of the display
+		break;
+	}
+}
+
+static size_t sim_ssd1306_command_length(uint8_t command) {
+	switch(command) {
+		case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+			return 2;
+		case 0x21: case 0x22: case 0xA3:
+			return 3;
+		case 0x29: case 0x2A:
+			return 6;
+		case 0x26: case 0x27:
+			return 7;
+		default:
+			return 1;
+	}
+}
+
+static void sim_ssd1306_write_data(uint8_t b) {
+	sim_ssd1306.gddram[sim_ssd1306.page][sim_ssd1306.col] = b;
+	sim_ssd1306.data_bytes++;
+	switch(sim_ssd1306.addressing_mode) {
+		case 0: // Horizontal
+			if(sim_ssd1306.col++ >= sim_ssd1306.col_end) {
+				sim_ssd1306.col = sim_ssd1306.col_start;
+				if(sim_ssd1306.page++ >= sim_ssd1306.page_end) {
+					sim_ssd1306.page = sim_ssd1306.page_start;
+				}
+			}
+		break;
+		case 1: // Vertical
+			if(sim_ssd1306.page++ >= sim_ssd1306.page_end) {
+				sim_ssd1306.page = sim_ssd1306.page_start;
+				if(sim_ssd1306.col++ >= sim_ssd1306.col_end) {
+					sim_ssd1306.col = sim_ssd1306.col_start;
+				}
+			}
+		break;
+		default: // Page
+			sim_ssd1306.col = (sim_ssd1306.col+1) & 0x7F;
+		break;
+	}
+}
+
+static void sim_ssd1306_receive(uint8_t b) {
+	switch(sim_ssd1306.byte_kind) {
+		case SIM_SSD1306_CONTROL:
+			sim_ssd1306.is_data = (b & 0x40) != 0;
+			sim_ssd1306.byte_kind = (b & 0x80) ? SIM_SSD1306_SINGLE : SIM_SSD1306_STREAM;
+		return;
+		case SIM_SSD1306_SINGLE:
+			sim_ssd1306.byte_kind = SIM_SSD1306_CONTROL;
+		break;
+		case SIM_SSD1306_STREAM:
+		break;
+	}
+	if(sim_ssd1306.is_data) {
+		sim_ssd1306_write_data(b);
+		return;
+	}
+	// Command bytes. Arguments of a multi-byte command may come with their own control bytes (0x80 prefix).
+	sim_ssd1306.command[sim_ssd1306.command_length++] = b;
+	if(sim_ssd1306.command_length >= sim_ssd1306_command_length(sim_ssd1306.command[0])) {
+		sim_ssd1306_execute_command();
+		sim_ssd1306.command_length = 0;
+	}
+}
+
+static void sim_ssd1306_end_transaction(void) {
+	if(sim_ssd1306.data_bytes) {
+		sim_stats.frames++;
+		sim_ssd1306_write_frame();
+		// Latency of the key press: first frame which got started after the key press
+		struct sim_latency *latency = sim_latency_current();
+		if(latency && !latency->frame_cycle && sim_i2c_transaction_start_cycle >= latency->press_cycle) {
+			latency->frame_cycle = sim_cycles;
+		}
+	}
+	sim_ssd1306.byte_kind = SIM_SSD1306_CONTROL;
+	sim_ssd1306.command_length = 0;
+	sim_ssd1306.data_bytes = 0;
+}
+
+static uint64_t sim_i2c_byte_cycles(void) {
+	uint32_t ccr = I2C1->CKCFGR & I2C_CKCFGR_CCR;
+	if(!ccr) {
+		ccr = 1;
+	}
+	// Same formula as the one in display_i2c_bus_init(). 9 clocks per byte including ACK.
+	uint32_t clocks_per_bit = (I2C1->CKCFGR & I2C_CKCFGR_FS) ? ccr*3 : ccr*2;
+	return (uint64_t)clocks_per_bit*9;
+}
+
+// Models a marginal bus, e.g. weak pull-ups: the transfers faster than sim_config.i2c_clockrate_max don't get through
+static int sim_i2c_is_too_fast(void) {
+	return sim_config.i2c_clockrate_max && sim_i2c_byte_cycles()/9 < FUNCONF_SYSTEM_CORE_CLOCK/sim_config.i2c_clockrate_max;
+}
+
+static void sim_i2c_update(void) {
+	if(I2C1->CTLR1 & I2C_CTLR1_SWRST) {
+		sim_i2c_state = SIM_I2C_IDLE;
+		I2C1->STAR1 = 0;
+		I2C1->STAR2 = 0;
+		I2C1->CTLR1 &= ~(I2C_CTLR1_START|I2C_CTLR1_STOP);
+		return;
+	}
+
+	// Stop condition can be requested at any moment, including as an error recovery
+	if((I2C1->CTLR1 & I2C_CTLR1_STOP) && sim_i2c_state != SIM_I2C_STOP) {
+		I2C1->CTLR1 &= ~I2C_CTLR1_STOP;
+		sim_i2c_state = SIM_I2C_STOP;
+		sim_i2c_done_cycle = sim_cycles + sim_i2c_byte_cycles()/9;
+	}
+
+	switch(sim_i2c_state) {
+		case SIM_I2C_IDLE:
+			if(I2C1->CTLR1 & I2C_CTLR1_START) {
+				I2C1->CTLR1 &= ~I2C_CTLR1_START;
+				I2C1->DATAR = SIM_I2C_DATAR_EMPTY;
+				sim_i2c_state = SIM_I2C_START;
+				sim_i2c_done_cycle = sim_cycles + sim_i2c_byte_cycles()/9;
+				sim_i2c_transaction_start_cycle = sim_cycles;
+			}
+		break;
+		case SIM_I2C_START:
+			if(sim_cycles >= sim_i2c_done_cycle) {
+				I2C1->STAR1 = I2C_STAR1_SB;
+				I2C1->STAR2 = I2C_STAR2_MSL|I2C_STAR2_BUSY;
+				sim_i2c_state = SIM_I2C_WAIT_ADDRESS;
+			}
+		break;
+		case SIM_I2C_WAIT_ADDRESS:
+			if(I2C1->DATAR != SIM_I2C_DATAR_EMPTY) {
+				I2C1->STAR1 = 0;
+				sim_i2c_state = SIM_I2C_ADDRESS;
+				sim_i2c_done_cycle = sim_cycles + sim_i2c_byte_cycles();
+			}
+		break;
+		case SIM_I2C_ADDRESS:
+			if(sim_cycles >= sim_i2c_done_cycle) {
+				sim_stats.i2c_bytes++;
+				sim_stats.i2c_transactions++;
+				if((I2C1->DATAR >> 1) != SIM_SSD1306_I2C_ADDR || sim_i2c_is_too_fast()) {
+					I2C1->STAR1 = I2C_STAR1_AF; // Nobody acknowledged the address
+					sim_i2c_state = SIM_I2C_WAIT_DATA;
+					break;
+				}
+				I2C1->STAR1 = I2C_STAR1_ADDR|I2C_STAR1_TXE;
+				I2C1->STAR2 = I2C_STAR2_MSL|I2C_STAR2_BUSY|I2C_STAR2_TRA;
+				sim_ssd1306.byte_kind = SIM_SSD1306_CONTROL;
+				sim_i2c_state = SIM_I2C_WAIT_DATA;
+			}
+		break;
+		case SIM_I2C_WAIT_DATA:
+			// A channel that's left enabled after completing the transfer has nothing more to send
+			if((DMA1_Channel6->CFGR & DMA_CFGR6_EN) && DMA1_Channel6->CNTR && (I2C1->CTLR2 & I2C_CTLR2_DMAEN)) {
+				I2C1->STAR1 &= ~I2C_STAR1_ADDR;
+				sim_i2c_dma_start_cycle = sim_cycles;
+				sim_i2c_dma_total = DMA1_Channel6->CNTR;
+				sim_i2c_dma_sent = 0;
+				sim_i2c_state = SIM_I2C_DMA;
+			}
+		break;
+		case SIM_I2C_DMA:
+		{
+			if(!(DMA1_Channel6->CFGR & DMA_CFGR6_EN)) {
+				// Aborted by the firmware
+				sim_i2c_state = SIM_I2C_WAIT_DATA;
+				break;
+			}
+			// The DMA only supports addresses in the lower 4GB. The simulator is linked with -no-pie so that it works.
+			const uint8_t *src = (const uint8_t*)(uintptr_t)DMA1_Channel6->MADDR;
+			uint64_t sent = (sim_cycles - sim_i2c_dma_start_cycle)/sim_i2c_byte_cycles();
+			if(sent > sim_i2c_dma_total) {
+				sent = sim_i2c_dma_total;
+			}
+			for(; sim_i2c_dma_sent<sent; sim_i2c_dma_sent++) {
+				sim_ssd1306_receive(src[sim_i2c_dma_sent]);
+				sim_stats.i2c_bytes++;
+			}
+			DMA1_Channel6->CNTR = sim_i2c_dma_total - sim_i2c_dma_sent;
+			if(sim_i2c_dma_sent == sim_i2c_dma_total) {
+				DMA1->INTFR |= DMA_TCIF6;
+				I2C1->STAR1 = I2C_STAR1_BTF|I2C_STAR1_TXE;
+				sim_i2c_state = SIM_I2C_WAIT_DATA;
+			}
+		}
+		break;
+		case SIM_I2C_STOP:
+			if(sim_cycles >= sim_i2c_done_cycle) {
+				I2C1->STAR1 = 0;
+				I2C1->STAR2 = 0;
+				sim_ssd1306_end_transaction();
+				sim_i2c_state = SIM_I2C_IDLE;
+			}
+		break;
+	}
+}
+
+static void sim_pfic_update(void) {
+	const uint32_t tim2_bit = 1U << (TIM2_IRQn%32);
+	if(PFIC->IRER[TIM2_IRQn/32] & tim2_bit) {
+		sim_tim2_irq_enabled = 0;
+	}
+	// If both are set since the last check, the interrupt got paused then resumed.
+	if(PFIC->IENR[TIM2_IRQn/32] & tim2_bit) {
+		sim_tim2_irq_enabled = 1;
+	}
+	PFIC->IRER[TIM2_IRQn/32] = 0;
+	PFIC->IENR[TIM2_IRQn/32] = 0;
+}
+
+static void sim_tim2_update(void) {
+	if(!sim_tim2_running && (TIM2->CTLR1 & TIM_CEN)) {
+		sim_tim2_running = 1;
+		sim_tim2_expiry = sim_cycles + (uint64_t)(TIM2->PSC+1)*(TIM2->ATRLR+1);
+	}
+	if(sim_tim2_running && sim_cycles >= sim_tim2_expiry) {
+		// One-pulse mode: the counter stops at the update event
+		sim_tim2_running = 0;
+		TIM2->CTLR1 &= ~TIM_CEN;
+		TIM2->INTFR |= TIM_UIF;
+	}
+	if((TIM2->INTFR & TIM_UIF) && (TIM2->DMAINTENR & TIM_UIE) && sim_tim2_irq_enabled && !sim_in_tim2 && !sim_in_usb) {
+		sim_in_tim2 = 1;
+		uint64_t interrupt_start = sim_cycles;
+		uint64_t nested_interrupt_start = sim_interrupt_cycles;
+		TIM2_IRQHandler();
+		uint64_t tim2_cycles = sim_cycles - interrupt_start - (sim_interrupt_cycles - nested_interrupt_start); // Without USB
+		sim_stats.tim2_runs++;
+		sim_stats.tim2_cycles += tim2_cycles;
+		if(tim2_cycles > sim_stats.tim2_cycles_max) {
+			sim_stats.tim2_cycles_max = tim2_cycles;
+		}
+		sim_interrupt_cycles += sim_cycles - interrupt_start;
+		sim_in_tim2 = 0;
+		sim_gpio_update();
+		sim_i2c_update();
+		if(!sim_tim2_running && (TIM2->CTLR1 & TIM_CEN)) {
+			sim_tim2_running = 1;
+			sim_tim2_expiry = sim_cycles + (uint64_t)(TIM2->PSC+1)*(TIM2->ATRLR+1);
+		}
+	}
+}
+
+static void sim_hid_log_line(const char *kind, const uint8_t *data, size_t length) {
+	if(!sim_hid_log) {
+		return;
+	}
+	fprintf(sim_hid_log, "%12.3f %s", (double)sim_cycles/SIM_CYCLES_PER_MS, kind);
+	for(size_t i=0; i<length; i++) {
+		fprintf(sim_hid_log, " %02X", data[i]);
+	}
+	fputc('\n', sim_hid_log);
+}
+
+void usb_setup(void) {
+	sim_usb_connected = 1;
+	sim_usb_next_poll = sim_cycles + SIM_USB_ENUMERATION_DELAY;
+	// The helper opens the vendor interface right after the enumeration. Its polls are in between the ones of the keyboard.
+	sim_usb_vendor_next_hello = sim_usb_next_poll;
+	sim_usb_vendor_next_poll = sim_usb_next_poll + (uint64_t)sim_config.usb_poll_interval_us*SIM_CYCLES_PER_US/2;
+}
+
+void usb_send_data(volatile void *data, int length, uint32_t poly_function, uint32_t token) {
+	if(poly_function == 2 && token == SIM_USB_PID_NAK) {
+		// A handshake packet alone, no data. The host doesn't answer it.
+		uint64_t bus_cycles = (uint64_t)SIM_USB_HANDSHAKE_BITS * SIM_USB_CYCLES_PER_BIT;
+		sim_cycles += bus_cycles;
+		sim_usb_bus_cycles += bus_cycles;
+		sim_usb_naked = 1;
+		return;
+	}
+	// The real library bit-bangs the packet out right away. Account for the time spent.
+	uint64_t bus_cycles = (uint64_t)(SIM_USB_DATA_OVERHEAD_BITS + length*8 + SIM_USB_HANDSHAKE_BITS) * SIM_USB_CYCLES_PER_BIT;
+	sim_cycles += bus_cycles;
+	sim_usb_bus_cycles += bus_cycles;
+	memcpy(sim_usb_report, (const void*)data, length > 8 ? 8 : length);
+	sim_usb_sent = 1;
+}
+
+void usb_send_empty(uint32_t token) {
+	uint64_t bus_cycles = (uint64_t)(SIM_USB_DATA_OVERHEAD_BITS + SIM_USB_HANDSHAKE_BITS) * SIM_USB_CYCLES_PER_BIT;
+	sim_cycles += bus_cycles;
+	sim_usb_bus_cycles += bus_cycles;
+}
+
+// Called by sim_host.c when the lock state of the host changes
+void sim_usb_schedule_led_report(uint8_t leds) {
+	if(sim_config.host_led_echo_delay_us < 0) {
+		return;
+	}
+	sim_usb_led_echo_value = leds;
+	sim_usb_led_echo_cycle = sim_cycles + (uint64_t)sim_config.host_led_echo_delay_us*SIM_CYCLES_PER_US;
+}
+
+static void sim_usb_update(void) {
+	if(!sim_usb_connected || sim_in_usb) {
+		return;
+	}
+	if(sim_cycles >= sim_usb_led_echo_cycle) {
+		// LED output report. It's a control transfer on the real bus, handled in the same interrupt.
+		sim_usb_led_echo_cycle = UINT64_MAX;
+		uint8_t data[8] = {sim_usb_led_echo_value};
+		sim_in_usb = 1;
+		uint64_t interrupt_start = sim_cycles;
+		sim_cycles += (uint64_t)(SIM_USB_TOKEN_BITS + SIM_USB_DATA_OVERHEAD_BITS + 8*8 + SIM_USB_HANDSHAKE_BITS) * SIM_USB_CYCLES_PER_BIT;
+		usb_handle_user_data(NULL, 0, data, 1, NULL);
+		sim_interrupt_cycles += sim_cycles - interrupt_start;
+		sim_in_usb = 0;
+		sim_stats.usb_led_reports++;
+		sim_hid_log_line("OUT", data, 1);
+	}
+	if(sim_cycles >= sim_usb_next_poll) {
+		sim_usb_next_poll += (uint64_t)sim_config.usb_poll_interval_us*SIM_CYCLES_PER_US;
+		sim_in_usb = 1;
+		sim_usb_sent = 0;
+		sim_usb_naked = 0;
+		uint64_t interrupt_start = sim_cycles;
+		sim_cycles += (uint64_t)SIM_USB_TOKEN_BITS * SIM_USB_CYCLES_PER_BIT;
+		uint64_t handler_start = sim_cycles;
+		sim_usb_bus_cycles = 0;
+		uint8_t scratchpad[8];
+		usb_handle_user_in_request(NULL, scratchpad, 1, 0, NULL);
+		uint64_t handler_cycles = sim_cycles - handler_start - sim_usb_bus_cycles; // CPU time of the firmware only
+		if(sim_usb_naked) {
+			sim_stats.usb_naks++;
+		} else if(!sim_usb_sent) {
+			// rv003usb doesn't answer the token on its own. The host times out: a transaction error, not a NAK.
+			sim_stats.usb_unanswered_polls++;
+		}
+		sim_interrupt_cycles += sim_cycles - interrupt_start;
+		sim_stats.usb_poll_cycles += sim_cycles - interrupt_start;
+		sim_in_usb = 0;
+		sim_stats.usb_polls++;
+		sim_stats.usb_handler_cycles += handler_cycles;
+		if(handler_cycles > sim_stats.usb_handler_cycles_max) {
+			sim_stats.usb_handler_cycles_max = handler_cycles;
+		}
+		if(sim_usb_sent) {
+			sim_stats.usb_reports_sent++;
+			if(memcmp(sim_usb_report, sim_usb_report_prev, 8)) {
+				sim_stats.usb_reports_changed++;
+				memcpy(sim_usb_report_prev, sim_usb_report, 8);
+				sim_hid_log_line("IN ", sim_usb_report, 8);
+				struct sim_latency *latency = sim_latency_current();
+				if(latency && !latency->report_cycle) {
+					latency->report_cycle = sim_cycles;
+				}
+			}
+			sim_host_receive_report(sim_usb_report);
+		}
+	}
+	if(!sim_config.host_helper) {
+		return;
+	}
+	if(sim_cycles >= sim_usb_vendor_next_hello) {
+		// The helper announces itself with an output report on the vendor endpoint, every second
+		sim_usb_vendor_next_hello += SIM_HOST_HELPER_HELLO_INTERVAL;
+		uint8_t data[8] = {SIM_HOST_HELPER_HELLO};
+		sim_in_usb = 1;
+		uint64_t interrupt_start = sim_cycles;
+		sim_cycles += (uint64_t)(SIM_USB_TOKEN_BITS + SIM_USB_DATA_OVERHEAD_BITS + 8*8 + SIM_USB_HANDSHAKE_BITS) * SIM_USB_CYCLES_PER_BIT;
+		usb_handle_user_data(NULL, 2, data, 8, NULL);
+		sim_interrupt_cycles += sim_cycles - interrupt_start;
+		sim_in_usb = 0;
+		sim_hid_log_line("VOUT", data, 8);
+	}
+	if(sim_cycles >= sim_usb_vendor_next_poll) {
+		sim_usb_vendor_next_poll += (uint64_t)sim_config.usb_poll_interval_us*SIM_CYCLES_PER_US;
+		sim_in_usb = 1;
+		sim_usb_sent = 0;
+		sim_usb_naked = 0;
+		uint64_t interrupt_start = sim_cycles;
+		sim_cycles += (uint64_t)SIM_USB_TOKEN_BITS * SIM_USB_CYCLES_PER_BIT;
+		uint8_t scratchpad[8];
+		usb_handle_user_in_request(NULL, scratchpad, 2, 0, NULL);
+		if(!sim_usb_sent && !sim_usb_naked) {
+			sim_stats.usb_unanswered_polls++;
+		}
+		sim_interrupt_cycles += sim_cycles - interrupt_start;
+		sim_in_usb = 0;
+		sim_stats.usb_vendor_polls++;
+		if(sim_usb_sent) {
+			sim_stats.usb_vendor_reports_sent++;
+			sim_hid_log_line("VIN", sim_usb_report, 8);
+			struct sim_latency *latency = sim_latency_current();
+			if(latency && !latency->report_cycle) {
+				latency->report_cycle = sim_cycles;
+			}
+			sim_host_receive_vendor_report(sim_usb_report);
+		}
+	}
+}
+
+static void sim_service(void) {
+	sim_next_service = sim_cycles + SIM_SERVICE_INTERVAL;
+	if(sim_cycles >= sim_end_cycle) {
+		longjmp(sim_end_jmp, 1);
+	}
+	sim_key_process();
+	sim_gpio_update();
+	sim_watchdog_update();
+	sim_i2c_update();
+	// The interrupt handlers run the instrumented firmware, which calls back into sim_service(). Keep them last.
+	sim_usb_update();
+	sim_tim2_update();
+}
+
+// Called by the firmware at every basic block. See sim.h
+void __sanitizer_cov_trace_pc(void) {
+	sim_cycles += sim_config.cycles_per_block;
+	SysTick->CNT = (uint32_t)sim_cycles;
+	if(PFIC->IRER[TIM2_IRQn/32] | PFIC->IENR[TIM2_IRQn/32]) {
+		sim_pfic_update();
+	}
+	// Flag clearing of DMA. It takes effect right away: display_loop() checks the flags right after clearing them.
+	if(DMA1->INTFCR) {
+		DMA1->INTFR &= ~DMA1->INTFCR;
+		DMA1->INTFCR = 0;
+	}
+	if(sim_cycles >= sim_next_service) {
+		sim_service();
+	}
+}
+
+void SystemInit(void) {
+}
+
+// Render time of each frame. ilonena.c draws a frame from display_clear() to display_set_refresh_flag().
+// Both are wrapped with the linker flag --wrap. See Makefile.
+void __real_display_clear(void);
+void __real_display_set_refresh_flag(void);
+static uint64_t sim_render_start_cycle = 0;
+static uint64_t sim_render_start_interrupt_cycles;
+
+void __wrap_display_clear(void) {
+	sim_render_start_cycle = sim_cycles;
+	sim_render_start_interrupt_cycles = sim_interrupt_cycles;
+	__real_display_clear();
+}
+
+void __wrap_display_set_refresh_flag(void) {
+	__real_display_set_refresh_flag(); // It clears what's left of the previous frame, so it's a part of the drawing
+	if(sim_render_start_cycle) {
+		uint64_t cycles = sim_cycles - sim_render_start_cycle - (sim_interrupt_cycles - sim_render_start_interrupt_cycles);
+		sim_stats.renders++;
+		sim_stats.render_cycles += cycles;
+		if(cycles > sim_stats.render_cycles_max) {
+			sim_stats.render_cycles_max = cycles;
+		}
+		sim_render_start_cycle = 0;
+	}
+}
+
+void Delay_Us(uint32_t us) {
+	uint64_t end = sim_cycles + us*SIM_CYCLES_PER_US;
+	while(sim_cycles < end) {
+		__sanitizer_cov_trace_pc();
+	}
+}
+
+void Delay_Ms(uint32_t ms) {
+	Delay_Us(ms*1000);
+}
+
+static uint32_t sim_intsyscr = 0;
+uint32_t __get_INTSYSCR(void) {
+	return sim_intsyscr;
+}
+
+void __set_INTSYSCR(uint32_t value) {
+	sim_intsyscr = value;
+}
+
+int sim_run(int (*firmware_main)(void), uint64_t end_cycle) {
+	// See the comment of SIM_I2C_DMA.
+	if((uintptr_t)&sim_ssd1306 > UINT32_MAX) {
+		fprintf(stderr, "sim: static data isn't in the lower 4GB. Please link with -no-pie.\n");
+		return 1;
+	}
+	if(sim_config.output_dir) {
+		char path[4096];
+		snprintf(path, sizeof(path), "%s/hid.log", sim_config.output_dir);
+		sim_hid_log = fopen(path, "w");
+		if(!sim_hid_log) {
+			perror(path);
+		}
+	}
+	sim_host_init();
+	sim_end_cycle = end_cycle;
+	GPIOA->INDR = GPIOC->INDR = GPIOD->INDR = 0xFF;
+	if(!setjmp(sim_end_jmp)) {
+		firmware_main();
+	}
+	if(sim_hid_log) {
+		fclose(sim_hid_log);
+		sim_hid_log = NULL;
+	}
+	if(sim_config.output_dir) {
+		char path[4096];
+		snprintf(path, sizeof(path), "%s/typed.txt", sim_config.output_dir);
+		sim_host_write_text(path);
+	}
+	return sim_watchdog_reset;
+}
+
+static void sim_print_latency(const char *name, size_t offset) {
+	uint64_t sum = 0;
+	uint64_t max = 0;
+	size_t count = 0;
+	for(size_t i=0; i<sim_latencies_length; i++) {
+		uint64_t cycle = *(uint64_t*)((uint8_t*)&sim_latencies[i] + offset);
+		// Only count the response that came before the next key press
+		if(!cycle || (i+1 < sim_latencies_length && cycle >= sim_latencies[i+1].press_cycle)) {
+			continue;
+		}
+		uint64_t latency = cycle - sim_latencies[i].press_cycle;
+		sum += latency;
+		max = latency > max ? latency : max;
+		count++;
+	}
+	if(count) {
+		printf("%-28s %zu presses, mean %.3fms, max %.3fms\n", name, count, (double)sum/count/SIM_CYCLES_PER_MS, (double)max/SIM_CYCLES_PER_MS);
+	} else {
+		printf("%-28s none\n", name);
+	}
+}
+
+void sim_write_report(void) {
+	printf("virtual time                 %.3fms\n", (double)sim_cycles/SIM_CYCLES_PER_MS);
+	printf("usb polls                    %llu\n", (unsigned long long)sim_stats.usb_polls);
+	printf("usb reports sent             %llu (%llu changed), %llu polls NAKed\n", (unsigned long long)sim_stats.usb_reports_sent, (unsigned long long)sim_stats.usb_reports_changed,
+		(unsigned long long)sim_stats.usb_naks);
+	printf("usb unanswered polls         %llu%s\n", (unsigned long long)sim_stats.usb_unanswered_polls,
+		sim_stats.usb_unanswered_polls ? " | PROTOCOL ERROR: the host times out" : "");
+	printf("keyboard endpoint counters   %u reports sent, %u polls NAKed\n", (unsigned)keyboard_usb_stats.reports_sent, (unsigned)keyboard_usb_stats.naks);
+	printf("usb led reports from host    %llu\n", (unsigned long long)sim_stats.usb_led_reports);
+	printf("lock handshake wait polls    %u\n", (unsigned)keyboard_usb_stats.lock_wait_polls);
+	if(sim_config.host_helper) {
+		printf("vendor endpoint              %llu polls, %llu reports sent (firmware counter: %u)\n", (unsigned long long)sim_stats.usb_vendor_polls,
+			(unsigned long long)sim_stats.usb_vendor_reports_sent, (unsigned)keyboard_usb_stats.vendor_reports_sent);
+	}
+	printf("usb handler cycles           mean %.1f, max %llu\n", sim_stats.usb_polls ? (double)sim_stats.usb_handler_cycles/sim_stats.usb_polls : 0.0, (unsigned long long)sim_stats.usb_handler_cycles_max);
+	printf("usb poll interrupt cycles    mean %.1f (including the bus)\n", sim_stats.usb_polls ? (double)sim_stats.usb_poll_cycles/sim_stats.usb_polls : 0.0);
+	printf("i2c transactions             %llu (%llu bytes, %.1f per key press)\n", (unsigned long long)sim_stats.i2c_transactions, (unsigned long long)sim_stats.i2c_bytes,
+		sim_latencies_length ? (double)sim_stats.i2c_bytes/sim_latencies_length : 0.0);
+	printf("display windows sent         %llu\n", (unsigned long long)sim_stats.frames);
+	printf("display i2c clock rate       %uHz, %u errors, %u bus resets\n", (unsigned)display_i2c_stats.clockrate, (unsigned)display_i2c_stats.errors, (unsigned)display_i2c_stats.bus_resets);
+	printf("render cycles                mean %.1f, max %llu (%llu frames drawn)\n", sim_stats.renders ? (double)sim_stats.render_cycles/sim_stats.renders : 0.0, (unsigned long long)sim_stats.render_cycles_max, (unsigned long long)sim_stats.renders);
+	printf("tim2 interrupt cycles        mean %.1f, max %llu (button_loop() and display_loop())\n", sim_stats.tim2_runs ? (double)sim_stats.tim2_cycles/sim_stats.tim2_runs : 0.0, (unsigned long long)sim_stats.tim2_cycles_max);
+	printf("watchdog feeds               %llu (longest interval %.3fms)\n", (unsigned long long)sim_stats.watchdog_feeds, (double)sim_stats.watchdog_feed_interval_max/SIM_CYCLES_PER_MS);
+	printf("main loop stalls             %llu over %.3fms, longest iteration %.3fms\n", (unsigned long long)sim_stats.main_loop_stalls,
+		(double)SIM_MAIN_LOOP_STALL/SIM_CYCLES_PER_MS, (double)sim_stats.main_loop_interval_max/SIM_CYCLES_PER_MS);
+	sim_print_latency("keypress to report latency", offsetof(struct sim_latency, report_cycle));
+	sim_print_latency("keypress to frame latency", offsetof(struct sim_latency, frame_cycle));
+}
@@ -0,0 +1,117 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Host simulator of ilo nena
+//
+// The firmware is compiled for the host with -fsanitize-coverage=trace-pc. The compiler then inserts a call to
+// __sanitizer_cov_trace_pc() at every basic block. sim.c implements that function as the virtual clock:
+// each basic block costs sim_config.cycles_per_block CPU cycles. It's also where the simulated interrupts
+// (TIM2, USB) preempt the firmware, which makes the simulation deterministic.
+
+#ifndef ILONENA_SIM_H
+#define ILONENA_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SIM_CYCLES_PER_MS ((uint64_t)FUNCONF_SYSTEM_CORE_CLOCK/1000)
+#define SIM_CYCLES_PER_US ((uint64_t)FUNCONF_SYSTEM_CORE_CLOCK/1000000)
+
+// The helper of the vendor interface. Same as the ones of scripts/ilonena_helper.py
+#define SIM_HOST_HELPER_HELLO (0x01U)
+#define SIM_HOST_HELPER_HELLO_INTERVAL (1000*SIM_CYCLES_PER_MS)
+
+// Input method of the simulated host. It decides how the HID reports are turned into text.
+enum sim_host_input_method {
+	SIM_HOST_INPUT_METHOD_LATIN, // No input method. Plain typing with sim_config.host_layout
+	SIM_HOST_INPUT_METHOD_WINDOWS, // WinCompose: R_ALT, 'u', hex digits, enter
+	SIM_HOST_INPUT_METHOD_LINUX, // ibus: CTRL+SHIFT+U, hex digits, space
+	SIM_HOST_INPUT_METHOD_MACOS, // Unicode Hex Input: hold option, type UTF-16 hex digits
+	SIM_HOST_INPUT_METHOD_COMPOSE, // XCompose/WinCompose with the file at sim_config.compose_path: R_ALT, then a sequence of the file
+};
+
+struct sim_config {
+	uint32_t cycles_per_block; // Virtual CPU cycles charged for each executed basic block of the firmware
+	uint32_t usb_poll_interval_us; // Interval between the interrupt IN polls of the host
+	uint8_t host_leds; // Initial lock LED state of the host (KEYBOARD_LED_*)
+	int32_t host_led_echo_delay_us; // Delay before the host sends back the LED output report. Negative: never sends it.
+	enum sim_host_input_method host_input_method;
+	uint8_t host_layout; // enum keyboard_layout of the host. Unicode Hex Input of macOS is always the US one.
+	const char *compose_path; // Compose file of SIM_HOST_INPUT_METHOD_COMPOSE, in the XCompose format
+	uint8_t host_helper; // The host runs the helper of the vendor interface (scripts/ilonena_helper.py)
+	const char *output_dir; // Where to write hid.log and the frame dumps. NULL: don't write any file.
+	uint32_t i2c_clockrate_max; // Above this I2C clock rate, the display doesn't acknowledge its address. 0: no limit. Unit: Hz
+};
+
+struct sim_stats {
+	uint64_t usb_polls;
+	uint64_t usb_reports_sent;
+	uint64_t usb_reports_changed; // Reports that differ from the previous one
+	uint64_t usb_naks; // Polls of the keyboard endpoint answered with a NAK
+	uint64_t usb_unanswered_polls; // Polls of the interrupt endpoints without any usb_send_*(). A protocol error.
+	uint64_t usb_led_reports; // LED output reports sent by the host
+	uint64_t usb_vendor_polls; // Polls of the vendor endpoint, with sim_config.host_helper
+	uint64_t usb_vendor_reports_sent;
+	uint64_t usb_handler_cycles; // Cycles spent in usb_handle_user_in_request(), excluding the time on the bus
+	uint64_t usb_handler_cycles_max;
+	uint64_t usb_poll_cycles; // Time in the interrupt for the polls, including the time on the bus
+	uint64_t i2c_bytes; // Bytes on the wire, including address bytes
+	uint64_t i2c_transactions;
+	uint64_t frames; // Transactions that carried graphic data to the display, i.e. the windows of changed columns
+	uint64_t watchdog_feeds;
+	uint64_t watchdog_feed_interval_max; // Longest stretch of time without feeding the watchdog. Unit: cycles
+	uint64_t main_loop_stalls; // Main loop iterations (i.e. watchdog feed intervals after the first feed) longer than SIM_MAIN_LOOP_STALL
+	uint64_t main_loop_interval_max; // Longest main loop iteration. Unit: cycles
+	uint64_t renders; // Frames drawn by the main loop, from display_clear() to display_set_refresh_flag()
+	uint64_t render_cycles; // Excluding the interrupts taken while drawing
+	uint64_t render_cycles_max;
+	uint64_t tim2_runs; // Runs of the TIM2 interrupt handler
+	uint64_t tim2_cycles; // Excluding the USB interrupts taken meanwhile
+	uint64_t tim2_cycles_max;
+};
+
+extern struct sim_config sim_config;
+extern struct sim_stats sim_stats;
+extern uint64_t sim_cycles; // The virtual clock. Unit: CPU cycles
+
+// Timeline of the key presses. key_id is enum ilonena_key_id
+void sim_schedule_key(uint64_t cycle, uint8_t key_id, uint8_t pressed);
+// Run the firmware until the virtual clock reaches end_cycle. Returns nonzero if the firmware got reset by the watchdog
+int sim_run(int (*firmware_main)(void), uint64_t end_cycle);
+void sim_write_report(void); // Print the summary and the latency figures to stdout
+// Make the host send the LED output report after sim_config.host_led_echo_delay_us
+void sim_usb_schedule_led_report(uint8_t leds);
+
+// Implemented in sim_host.c. Model of the USB host: lock keys and input methods
+void sim_host_init(void);
+void sim_host_receive_report(const uint8_t report[8]);
+void sim_host_receive_vendor_report(const uint8_t report[8]); // UTF-8 text for the helper
+uint8_t sim_host_get_leds(void);
+void sim_host_write_text(const char *path);
+void sim_host_print_text(void);
+size_t sim_host_get_text(const uint32_t **text); // Returns the length. Unit: codepoints
+
+#endif
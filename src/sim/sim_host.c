@@ -0,0 +1,480 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Model of the USB host: keeps track of the lock keys and turns the HID reports into text according to
+// the input method configured in sim_config.host_input_method. It's used for checking that the
+// output of the firmware is what the user expected.
+
+#include "sim.h"
+#include "ch32fun.h"
+#include "keyboard.h"
+#include "tinyusb_hid.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_HOST_TEXT_LENGTH_MAX (65536)
+#define SIM_HOST_HEX_LENGTH_MAX (16)
+#define SIM_HOST_COMPOSE_ENTRIES_MAX (1024)
+#define SIM_HOST_COMPOSE_SEQUENCE_LENGTH_MAX (8)
+#define SIM_HOST_COMPOSE_TEXT_LENGTH_MAX (16)
+
+static uint8_t sim_host_leds;
+static uint8_t sim_host_report_prev[8];
+static uint32_t sim_host_text[SIM_HOST_TEXT_LENGTH_MAX];
+static size_t sim_host_text_length;
+
+static enum {
+	SIM_HOST_STATE_NORMAL,
+	SIM_HOST_STATE_WINDOWS_COMPOSE, // R_ALT had been pressed and released. Waiting for 'u'
+	SIM_HOST_STATE_WINDOWS_HEX, // Got 'u'. Waiting for hex digits and enter
+	SIM_HOST_STATE_LINUX_HEX, // Got CTRL+SHIFT+U. Waiting for hex digits and space
+	SIM_HOST_STATE_COMPOSE_SEQUENCE, // R_ALT had been pressed and released. Waiting for the keys of a sequence of the compose file
+} sim_host_state;
+static char sim_host_hex[SIM_HOST_HEX_LENGTH_MAX+1];
+static size_t sim_host_hex_length;
+static uint8_t sim_host_ralt_alone; // R_ALT is held without any other key pressed
+static uint16_t sim_host_high_surrogate;
+static uint32_t sim_host_helper_codepoint; // UTF-8 sequence being decoded by the helper
+static uint8_t sim_host_helper_continuation; // Continuation bytes left
+
+// Sequences of the compose file, without the leading <Multi_key>. Only the single-character keysyms are supported.
+static struct {
+	char sequence[SIM_HOST_COMPOSE_SEQUENCE_LENGTH_MAX+1];
+	uint32_t text[SIM_HOST_COMPOSE_TEXT_LENGTH_MAX];
+	size_t text_length;
+} sim_host_compose_entries[SIM_HOST_COMPOSE_ENTRIES_MAX];
+static size_t sim_host_compose_entry_num;
+static char sim_host_compose_sequence[SIM_HOST_COMPOSE_SEQUENCE_LENGTH_MAX+1];
+static size_t sim_host_compose_sequence_length;
+
+// US layout. Index: HID_KEY_*. Value: {without shift, with shift}
+static const char sim_host_us_layout[][2] = {
+	[HID_KEY_A] = {'a', 'A'}, [HID_KEY_B] = {'b', 'B'}, [HID_KEY_C] = {'c', 'C'}, [HID_KEY_D] = {'d', 'D'},
+	[HID_KEY_E] = {'e', 'E'}, [HID_KEY_F] = {'f', 'F'}, [HID_KEY_G] = {'g', 'G'}, [HID_KEY_H] = {'h', 'H'},
+	[HID_KEY_I] = {'i', 'I'}, [HID_KEY_J] = {'j', 'J'}, [HID_KEY_K] = {'k', 'K'}, [HID_KEY_L] = {'l', 'L'},
+	[HID_KEY_M] = {'m', 'M'}, [HID_KEY_N] = {'n', 'N'}, [HID_KEY_O] = {'o', 'O'}, [HID_KEY_P] = {'p', 'P'},
+	[HID_KEY_Q] = {'q', 'Q'}, [HID_KEY_R] = {'r', 'R'}, [HID_KEY_S] = {'s', 'S'}, [HID_KEY_T] = {'t', 'T'},
+	[HID_KEY_U] = {'u', 'U'}, [HID_KEY_V] = {'v', 'V'}, [HID_KEY_W] = {'w', 'W'}, [HID_KEY_X] = {'x', 'X'},
+	[HID_KEY_Y] = {'y', 'Y'}, [HID_KEY_Z] = {'z', 'Z'},
+	[HID_KEY_1] = {'1', '!'}, [HID_KEY_2] = {'2', '@'}, [HID_KEY_3] = {'3', '#'}, [HID_KEY_4] = {'4', '$'},
+	[HID_KEY_5] = {'5', '%'}, [HID_KEY_6] = {'6', '^'}, [HID_KEY_7] = {'7', '&'}, [HID_KEY_8] = {'8', '*'},
+	[HID_KEY_9] = {'9', '('}, [HID_KEY_0] = {'0', ')'},
+	[HID_KEY_ENTER] = {'\n', '\n'}, [HID_KEY_TAB] = {'\t', '\t'}, [HID_KEY_SPACE] = {' ', ' '},
+	[HID_KEY_MINUS] = {'-', '_'}, [HID_KEY_EQUAL] = {'=', '+'}, [HID_KEY_BRACKET_LEFT] = {'[', '{'},
+	[HID_KEY_BRACKET_RIGHT] = {']', '}'}, [HID_KEY_BACKSLASH] = {'\\', '|'}, [HID_KEY_SEMICOLON] = {';', ':'},
+	[HID_KEY_APOSTROPHE] = {'\'', '"'}, [HID_KEY_GRAVE] = {'`', '~'}, [HID_KEY_COMMA] = {',', '<'},
+	[HID_KEY_PERIOD] = {'.', '>'}, [HID_KEY_SLASH] = {'/', '?'},
+	[HID_KEY_KEYPAD_ENTER] = {'\n', '\n'},
+};
+
+// Keys of the rows of sim_host_layouts, named after the US layout: `1234567890-=, qwertyuiop[], asdfghjkl;'\, then the
+// extra key of ISO keyboards and zxcvbnm,./
+static const uint8_t sim_host_layout_keys[4][13] = {
+	{HID_KEY_GRAVE, HID_KEY_1, HID_KEY_2, HID_KEY_3, HID_KEY_4, HID_KEY_5, HID_KEY_6, HID_KEY_7, HID_KEY_8, HID_KEY_9, HID_KEY_0, HID_KEY_MINUS, HID_KEY_EQUAL},
+	{HID_KEY_Q, HID_KEY_W, HID_KEY_E, HID_KEY_R, HID_KEY_T, HID_KEY_Y, HID_KEY_U, HID_KEY_I, HID_KEY_O, HID_KEY_P, HID_KEY_BRACKET_LEFT, HID_KEY_BRACKET_RIGHT},
+	{HID_KEY_A, HID_KEY_S, HID_KEY_D, HID_KEY_F, HID_KEY_G, HID_KEY_H, HID_KEY_J, HID_KEY_K, HID_KEY_L, HID_KEY_SEMICOLON, HID_KEY_APOSTROPHE, HID_KEY_BACKSLASH},
+	{HID_KEY_EUROPE_2, HID_KEY_Z, HID_KEY_X, HID_KEY_C, HID_KEY_V, HID_KEY_B, HID_KEY_N, HID_KEY_M, HID_KEY_COMMA, HID_KEY_PERIOD, HID_KEY_SLASH},
+};
+
+// The other layouts of enum keyboard_layout, as on Linux. Characters typed by the keys of each row of sim_host_layout_keys
+// without modifier, with shift and with AltGr. ' ' for the dead keys and the non-ASCII characters. The other keys are
+// the same as sim_host_us_layout. The US layout has no AltGr.
+static const char *const sim_host_layouts[KEYBOARD_LAYOUT_END][4][3] = {
+	[KEYBOARD_LAYOUT_AZERTY] = {
+		{" & \"'(- _  )=", " 1234567890 +", "  ~#{[|`\\^@]}"},
+		{"azertyuiop $", "AZERTYUIOP  ", "            "},
+		{"qsdfghjklm *", "QSDFGHJKLM% ", "            "},
+		{"<wxcvbn,;:!", ">WXCVBN?./ ", "           "},
+	},
+	[KEYBOARD_LAYOUT_QWERTZ] = {
+		{" 1234567890  ", " !\" $%&/()=? ", "       {[]}\\ "},
+		{"qwertzuiop +", "QWERTZUIOP *", "@          ~"},
+		{"asdfghjkl  #", "ASDFGHJKL  '", "            "},
+		{"<yxcvbnm,.-", ">YXCVBNM;:_", "|          "},
+	},
+	[KEYBOARD_LAYOUT_CZECH] = {
+		{";+         = ", " 1234567890% ", "             "},
+		{"qwertzuiop )", "QWERTZUIOP/(", "\\|          "},
+		{"asdfghjkl   ", "ASDFGHJKL\"!'", "   []       "},
+		{"\\yxcvbnm,.-", "|YXCVBNM?:_", "           "},
+	},
+	[KEYBOARD_LAYOUT_DVORAK] = {
+		{"`1234567890[]", "~!@#$%^&*(){}", "             "},
+		{"',.pyfgcrl/=", "\"<>PYFGCRL?+", "            "},
+		{"aoeuidhtns-\\", "AOEUIDHTNS_|", "            "},
+		{" ;qjkxbmwvz", " :QJKXBMWVZ", "           "},
+	},
+};
+
+// Decodes one UTF-8 character. Returns the number of bytes consumed
+static size_t sim_host_decode_utf8(const char *s, uint32_t *codepoint) {
+	const uint8_t *u = (const uint8_t*)s;
+	if(u[0] < 0x80) {
+		*codepoint = u[0];
+		return 1;
+	} else if(u[0] < 0xE0) {
+		*codepoint = ((u[0] & 0x1F) << 6) | (u[1] & 0x3F);
+		return 2;
+	} else if(u[0] < 0xF0) {
+		*codepoint = ((u[0] & 0x0F) << 12) | ((u[1] & 0x3F) << 6) | (u[2] & 0x3F);
+		return 3;
+	}
+	*codepoint = ((u[0] & 0x07) << 18) | ((u[1] & 0x3F) << 12) | ((u[2] & 0x3F) << 6) | (u[3] & 0x3F);
+	return 4;
+}
+
+// Loads the lines like <Multi_key> <q> <a> <b> : "text" of the compose file. The other lines are ignored.
+static void sim_host_load_compose(const char *path) {
+	FILE *f = fopen(path, "r");
+	if(!f) {
+		perror(path);
+		exit(2);
+	}
+	char line[1024];
+	sim_host_compose_entry_num = 0;
+	while(fgets(line, sizeof(line), f) && sim_host_compose_entry_num < SIM_HOST_COMPOSE_ENTRIES_MAX) {
+		const char *p = line;
+		if(strncmp(p, "<Multi_key>", 11)) {
+			continue;
+		}
+		p += 11;
+		char *sequence = sim_host_compose_entries[sim_host_compose_entry_num].sequence;
+		size_t sequence_length = 0;
+		while(*p == ' ' && p[1] == '<') {
+			if(p[3] != '>' || sequence_length >= SIM_HOST_COMPOSE_SEQUENCE_LENGTH_MAX) {
+				break; // Not a single-character keysym
+			}
+			sequence[sequence_length++] = p[2];
+			p += 4;
+		}
+		sequence[sequence_length] = '\0';
+		p = strstr(p, ": \"");
+		if(!sequence_length || !p) {
+			continue;
+		}
+		p += 3;
+		size_t text_length = 0;
+		while(*p && *p != '"' && text_length < SIM_HOST_COMPOSE_TEXT_LENGTH_MAX) {
+			if(*p == '\\' && p[1]) {
+				p++;
+			}
+			p += sim_host_decode_utf8(p, &sim_host_compose_entries[sim_host_compose_entry_num].text[text_length++]);
+		}
+		sim_host_compose_entries[sim_host_compose_entry_num].text_length = text_length;
+		sim_host_compose_entry_num++;
+	}
+	fclose(f);
+}
+
+void sim_host_init(void) {
+	sim_host_leds = sim_config.host_leds;
+	memset(sim_host_report_prev, 0, sizeof(sim_host_report_prev));
+	sim_host_text_length = 0;
+	sim_host_state = SIM_HOST_STATE_NORMAL;
+	sim_host_hex_length = 0;
+	sim_host_ralt_alone = 0;
+	sim_host_high_surrogate = 0;
+	sim_host_compose_sequence_length = 0;
+	sim_host_helper_codepoint = 0;
+	sim_host_helper_continuation = 0;
+	if(sim_config.host_input_method == SIM_HOST_INPUT_METHOD_COMPOSE && !sim_host_compose_entry_num) {
+		sim_host_load_compose(sim_config.compose_path);
+	}
+	// The host tells the keyboard about the lock state right after the enumeration
+	sim_usb_schedule_led_report(sim_host_leds);
+}
+
+uint8_t sim_host_get_leds(void) {
+	return sim_host_leds;
+}
+
+static void sim_host_emit(uint32_t codepoint) {
+	if(codepoint == '\b') {
+		if(sim_host_text_length) {
+			sim_host_text_length--;
+		}
+		return;
+	}
+	if(codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+		sim_host_high_surrogate = codepoint;
+		return;
+	}
+	if(codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+		codepoint = 0x10000 + ((sim_host_high_surrogate-0xD800) << 10) + (codepoint-0xDC00);
+		sim_host_high_surrogate = 0;
+	}
+	if(sim_host_text_length < SIM_HOST_TEXT_LENGTH_MAX) {
+		sim_host_text[sim_host_text_length++] = codepoint;
+	}
+}
+
+static uint32_t sim_host_parse_hex(const char *hex, size_t length) {
+	uint32_t ret = 0;
+	for(size_t i=0; i<length; i++) {
+		ret = (ret << 4) | (hex[i] <= '9' ? hex[i]-'0' : hex[i]-'a'+10);
+	}
+	return ret;
+}
+
+// Returns the character typed by the key, or 0 if it doesn't type anything
+static char sim_host_key_to_char(uint8_t modifiers, uint8_t key) {
+	if(key >= HID_KEY_KEYPAD_1 && key <= HID_KEY_KEYPAD_0) {
+		// Without Num Lock, the keypad keys are navigation keys
+		if(!(sim_host_leds & KEYBOARD_LED_NUMLOCK)) {
+			return 0;
+		}
+		return key == HID_KEY_KEYPAD_0 ? '0' : '1'+key-HID_KEY_KEYPAD_1;
+	}
+	if(key == HID_KEY_BACKSPACE) {
+		return '\b';
+	}
+	// Unicode Hex Input is a layout by itself
+	enum keyboard_layout layout = (sim_config.host_input_method == SIM_HOST_INPUT_METHOD_MACOS) ? KEYBOARD_LAYOUT_QWERTY : sim_config.host_layout;
+	char levels[3] = {0, 0, 0}; // Without modifier, with shift, with AltGr
+	if(key < sizeof(sim_host_us_layout)/sizeof(*sim_host_us_layout)) {
+		memcpy(levels, sim_host_us_layout[key], 2);
+	}
+	if(sim_host_layouts[layout][0][0] != NULL) {
+		for(size_t row=0; row<4; row++) {
+			const uint8_t *p = memchr(sim_host_layout_keys[row], key, strlen(sim_host_layouts[layout][row][0]));
+			if(p != NULL) {
+				for(size_t level=0; level<3; level++) {
+					char c = sim_host_layouts[layout][row][level][p-sim_host_layout_keys[row]];
+					levels[level] = (c == ' ') ? 0 : c;
+				}
+			}
+		}
+	}
+	if(modifiers & KEYBOARD_MODIFIER_RIGHTALT) {
+		return levels[2];
+	}
+	uint8_t shift = (modifiers & (KEYBOARD_MODIFIER_LEFTSHIFT|KEYBOARD_MODIFIER_RIGHTSHIFT)) != 0;
+	if(levels[0] >= 'a' && levels[0] <= 'z' && (sim_host_leds & KEYBOARD_LED_CAPSLOCK)) {
+		shift = !shift;
+	}
+	return levels[shift];
+}
+
+static uint8_t sim_host_is_hex(char c) {
+	return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+}
+
+static void sim_host_hex_push(char c) {
+	if(sim_host_hex_length < SIM_HOST_HEX_LENGTH_MAX) {
+		sim_host_hex[sim_host_hex_length++] = c;
+	}
+}
+
+static void sim_host_key_pressed(uint8_t modifiers, uint8_t key) {
+	const uint8_t ctrl = modifiers & (KEYBOARD_MODIFIER_LEFTCTRL|KEYBOARD_MODIFIER_RIGHTCTRL);
+	const uint8_t shift = modifiers & (KEYBOARD_MODIFIER_LEFTSHIFT|KEYBOARD_MODIFIER_RIGHTSHIFT);
+	const uint8_t left_alt = modifiers & KEYBOARD_MODIFIER_LEFTALT;
+
+	switch(key) {
+		case HID_KEY_NUM_LOCK:
+		case HID_KEY_CAPS_LOCK:
+		case HID_KEY_SCROLL_LOCK:
+			sim_host_leds ^= key == HID_KEY_NUM_LOCK ? KEYBOARD_LED_NUMLOCK : (key == HID_KEY_CAPS_LOCK ? KEYBOARD_LED_CAPSLOCK : KEYBOARD_LED_SCROLLLOCK);
+			sim_usb_schedule_led_report(sim_host_leds);
+		return;
+	}
+
+	char c = sim_host_key_to_char(modifiers, key);
+	switch(sim_host_state) {
+		case SIM_HOST_STATE_NORMAL:
+			if(sim_config.host_input_method == SIM_HOST_INPUT_METHOD_LINUX && ctrl && shift && (c == 'U' || c == 'u')) {
+				sim_host_state = SIM_HOST_STATE_LINUX_HEX;
+				sim_host_hex_length = 0;
+			} else if(sim_config.host_input_method == SIM_HOST_INPUT_METHOD_MACOS && left_alt) {
+				if(sim_host_is_hex(c)) {
+					sim_host_hex_push(c);
+					if(sim_host_hex_length == 4) {
+						sim_host_emit(sim_host_parse_hex(sim_host_hex, 4));
+						sim_host_hex_length = 0;
+					}
+				}
+			} else if(c && !ctrl && !left_alt) {
+				sim_host_emit(c);
+			}
+		break;
+		case SIM_HOST_STATE_WINDOWS_COMPOSE:
+			if(c == 'u') {
+				sim_host_state = SIM_HOST_STATE_WINDOWS_HEX;
+				sim_host_hex_length = 0;
+			} else {
+				sim_host_state = SIM_HOST_STATE_NORMAL; // Unknown compose sequence. WinCompose discards it.
+			}
+		break;
+		case SIM_HOST_STATE_WINDOWS_HEX:
+			if(sim_host_is_hex(c)) {
+				sim_host_hex_push(c);
+			} else {
+				if(c == '\n' && sim_host_hex_length) {
+					sim_host_emit(sim_host_parse_hex(sim_host_hex, sim_host_hex_length));
+				}
+				sim_host_state = SIM_HOST_STATE_NORMAL;
+			}
+		break;
+		case SIM_HOST_STATE_LINUX_HEX:
+			if(sim_host_is_hex(c)) {
+				sim_host_hex_push(c);
+			} else if(c == '\b') {
+				if(sim_host_hex_length) {
+					sim_host_hex_length--;
+				}
+			} else if(c == ' ' || c == '\n') {
+				if(sim_host_hex_length) {
+					sim_host_emit(sim_host_parse_hex(sim_host_hex, sim_host_hex_length));
+				}
+				sim_host_state = SIM_HOST_STATE_NORMAL;
+			}
+			// ibus ignores the other keys, including the navigation keys of the numpad without Num Lock
+		break;
+		case SIM_HOST_STATE_COMPOSE_SEQUENCE:
+		{
+			if(!c || sim_host_compose_sequence_length >= SIM_HOST_COMPOSE_SEQUENCE_LENGTH_MAX) {
+				sim_host_state = SIM_HOST_STATE_NORMAL;
+				break;
+			}
+			sim_host_compose_sequence[sim_host_compose_sequence_length++] = c;
+			uint8_t is_prefix = 0;
+			for(size_t i=0; i<sim_host_compose_entry_num; i++) {
+				if(strncmp(sim_host_compose_entries[i].sequence, sim_host_compose_sequence, sim_host_compose_sequence_length)) {
+					continue;
+				}
+				if(sim_host_compose_entries[i].sequence[sim_host_compose_sequence_length] == '\0') {
+					for(size_t j=0; j<sim_host_compose_entries[i].text_length; j++) {
+						sim_host_emit(sim_host_compose_entries[i].text[j]);
+					}
+					sim_host_state = SIM_HOST_STATE_NORMAL;
+					return;
+				}
+				is_prefix = 1;
+			}
+			if(!is_prefix) {
+				sim_host_state = SIM_HOST_STATE_NORMAL; // Unknown compose sequence. It's discarded.
+			}
+		}
+		break;
+	}
+}
+
+void sim_host_receive_report(const uint8_t report[8]) {
+	const uint8_t modifiers = report[0];
+	const uint8_t modifiers_prev = sim_host_report_prev[0];
+	uint8_t any_key_pressed = 0;
+
+	// Modifier only transitions
+	if((modifiers & KEYBOARD_MODIFIER_RIGHTALT) && !(modifiers_prev & KEYBOARD_MODIFIER_RIGHTALT)) {
+		sim_host_ralt_alone = 1;
+	}
+	if((modifiers_prev & KEYBOARD_MODIFIER_LEFTALT) && !(modifiers & KEYBOARD_MODIFIER_LEFTALT)) {
+		sim_host_hex_length = 0; // macOS: releasing Option discards incomplete input
+	}
+
+	for(size_t i=2; i<8; i++) {
+		uint8_t key = report[i];
+		if(key == HID_KEY_NONE || memchr(&sim_host_report_prev[2], key, 6)) {
+			continue;
+		}
+		any_key_pressed = 1;
+		sim_host_ralt_alone = 0;
+		sim_host_key_pressed(modifiers, key);
+	}
+
+	if(!any_key_pressed && (modifiers_prev & KEYBOARD_MODIFIER_RIGHTALT) && !(modifiers & KEYBOARD_MODIFIER_RIGHTALT) && sim_host_ralt_alone) {
+		sim_host_ralt_alone = 0;
+		if(sim_config.host_input_method == SIM_HOST_INPUT_METHOD_WINDOWS) {
+			sim_host_state = SIM_HOST_STATE_WINDOWS_COMPOSE;
+		} else if(sim_config.host_input_method == SIM_HOST_INPUT_METHOD_COMPOSE) {
+			sim_host_state = SIM_HOST_STATE_COMPOSE_SEQUENCE;
+			sim_host_compose_sequence_length = 0;
+		}
+	}
+
+	memcpy(sim_host_report_prev, report, sizeof(sim_host_report_prev));
+}
+
+// The helper types the UTF-8 stream from the vendor interface as is. A codepoint might be split across reports.
+void sim_host_receive_vendor_report(const uint8_t report[8]) {
+	for(size_t i=1; i<=report[0] && i<8; i++) {
+		uint8_t b = report[i];
+		if(sim_host_helper_continuation && (b & 0xC0) == 0x80) {
+			sim_host_helper_codepoint = (sim_host_helper_codepoint << 6) | (b & 0x3F);
+			if(!--sim_host_helper_continuation) {
+				sim_host_emit(sim_host_helper_codepoint);
+			}
+			continue;
+		}
+		sim_host_helper_continuation = b < 0x80 ? 0 : (b < 0xE0 ? 1 : (b < 0xF0 ? 2 : 3));
+		sim_host_helper_codepoint = b & (0x7F >> sim_host_helper_continuation);
+		if(!sim_host_helper_continuation) {
+			sim_host_emit(sim_host_helper_codepoint);
+		}
+	}
+}
+
+static void sim_host_write_utf8(FILE *f) {
+	for(size_t i=0; i<sim_host_text_length; i++) {
+		uint32_t c = sim_host_text[i];
+		if(c < 0x80) {
+			fputc(c, f);
+		} else if(c < 0x800) {
+			fputc(0xC0 | (c >> 6), f);
+			fputc(0x80 | (c & 0x3F), f);
+		} else if(c < 0x10000) {
+			fputc(0xE0 | (c >> 12), f);
+			fputc(0x80 | ((c >> 6) & 0x3F), f);
+			fputc(0x80 | (c & 0x3F), f);
+		} else {
+			fputc(0xF0 | (c >> 18), f);
+			fputc(0x80 | ((c >> 12) & 0x3F), f);
+			fputc(0x80 | ((c >> 6) & 0x3F), f);
+			fputc(0x80 | (c & 0x3F), f);
+		}
+	}
+}
+
+void sim_host_write_text(const char *path) {
+	FILE *f = fopen(path, "wb");
+	if(!f) {
+		perror(path);
+		return;
+	}
+	sim_host_write_utf8(f);
+	fclose(f);
+}
+
+size_t sim_host_get_text(const uint32_t **text) {
+	*text = sim_host_text;
+	return sim_host_text_length;
+}
+
+void sim_host_print_text(void) {
+	sim_host_write_utf8(stdout);
+	fputc('\n', stdout);
+}
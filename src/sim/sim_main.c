@@ -0,0 +1,265 @@
+// Copyright 2025 Wong Cho Ching <https://sadale.net>
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+// OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Command line front-end of the simulator. See README.MD for the timeline format.
+
+#include "sim.h"
+#include "ch32fun.h"
+#include "lookup.h"
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+int ilonena_main(void);
+
+#define SIM_MAIN_LINE_LENGTH_MAX (1024)
+#define SIM_MAIN_TAIL_MS (3000) // Keep running after the last event so that the output gets fully typed out
+
+static uint64_t sim_main_time; // Unit: cycles
+static uint32_t sim_main_press_ms = 50;
+static uint32_t sim_main_gap_ms = 50;
+
+// Returns enum ilonena_key_id, or ILONENA_KEY_NONE if the name is invalid
+static uint8_t sim_main_parse_key(const char *name) {
+	static const char single_keys[] = "123456qwertyasdfg";
+	if(!strcmp(name, "ala")) {
+		return ILONENA_KEY_ALA;
+	} else if(!strcmp(name, "weka")) {
+		return ILONENA_KEY_WEKA;
+	} else if(!strcmp(name, "pana")) {
+		return ILONENA_KEY_PANA;
+	} else if(strlen(name) == 1 && name[0] && strchr(single_keys, name[0])) {
+		return ILONENA_KEY_1+(strchr(single_keys, name[0])-single_keys);
+	}
+	return ILONENA_KEY_NONE;
+}
+
+static void sim_main_tap(uint8_t key_id, uint32_t press_ms) {
+	sim_schedule_key(sim_main_time, key_id, 1);
+	sim_main_time += press_ms*SIM_CYCLES_PER_MS;
+	sim_schedule_key(sim_main_time, key_id, 0);
+	sim_main_time += sim_main_gap_ms*SIM_CYCLES_PER_MS;
+}
+
+static int sim_main_parse_number(const char *str, uint32_t *out) {
+	char *end;
+	errno = 0;
+	unsigned long value = str ? strtoul(str, &end, 10) : 0;
+	if(!str || errno || *end || end == str) {
+		return 1;
+	}
+	*out = value;
+	return 0;
+}
+
+static int sim_main_load_timeline(const char *path) {
+	FILE *f = strcmp(path, "-") ? fopen(path, "r") : stdin;
+	if(!f) {
+		perror(path);
+		return 1;
+	}
+	char line[SIM_MAIN_LINE_LENGTH_MAX];
+	size_t line_number = 0;
+	int ret = 0;
+	while(!ret && fgets(line, sizeof(line), f)) {
+		line_number++;
+		char *comment = strchr(line, '#');
+		if(comment) {
+			*comment = '\0';
+		}
+		char *command = strtok(line, " \t\r\n");
+		if(!command) {
+			continue;
+		}
+		char *arg = strtok(NULL, " \t\r\n");
+		uint32_t value = 0;
+		if(!strcmp(command, "wait")) {
+			ret = sim_main_parse_number(arg, &value);
+			sim_main_time += value*SIM_CYCLES_PER_MS;
+		} else if(!strcmp(command, "tap")) {
+			ret = !arg;
+			for(; arg && !ret; arg = strtok(NULL, " \t\r\n")) {
+				uint8_t key_id = sim_main_parse_key(arg);
+				ret = key_id == ILONENA_KEY_NONE;
+				if(!ret) {
+					sim_main_tap(key_id, sim_main_press_ms);
+				}
+			}
+		} else if(!strcmp(command, "hold")) {
+			uint8_t key_id = arg ? sim_main_parse_key(arg) : ILONENA_KEY_NONE;
+			ret = key_id == ILONENA_KEY_NONE || sim_main_parse_number(strtok(NULL, " \t\r\n"), &value);
+			if(!ret) {
+				sim_main_tap(key_id, value);
+			}
+		} else if(!strcmp(command, "press") || !strcmp(command, "release")) {
+			uint8_t key_id = arg ? sim_main_parse_key(arg) : ILONENA_KEY_NONE;
+			ret = key_id == ILONENA_KEY_NONE;
+			if(!ret) {
+				sim_schedule_key(sim_main_time, key_id, command[0] == 'p');
+			}
+		} else if(!strcmp(command, "type")) {
+			ret = !arg;
+			for(const char *c = arg; c && *c && !ret; c++) {
+				char name[2] = {*c, '\0'};
+				uint8_t key_id = sim_main_parse_key(name);
+				ret = key_id == ILONENA_KEY_NONE;
+				if(!ret) {
+					sim_main_tap(key_id, sim_main_press_ms);
+				}
+			}
+		} else if(!strcmp(command, "set")) {
+			char *name = arg;
+			ret = !name || sim_main_parse_number(strtok(NULL, " \t\r\n"), &value);
+			if(!ret && !strcmp(name, "press_ms")) {
+				sim_main_press_ms = value;
+			} else if(!ret && !strcmp(name, "gap_ms")) {
+				sim_main_gap_ms = value;
+			} else {
+				ret = 1;
+			}
+		} else {
+			ret = 1;
+		}
+		if(ret) {
+			fprintf(stderr, "%s:%zu: invalid command\n", path, line_number);
+		}
+	}
+	if(f != stdin) {
+		fclose(f);
+	}
+	return ret;
+}
+
+static void sim_main_usage(const char *name) {
+	fprintf(stderr,
+		"Usage: %s [options] TIMELINE\n"
+		"  TIMELINE  Key timeline file. '-' for stdin\n"
+		"  -o DIR    Write hid.log, typed.txt and frame_NNNNN.pbm to DIR\n"
+		"  -m MODE   Output mode stored in the option bytes: latin, windows, linux, macos, compose (default: latin)\n"
+		"  -k LAYOUT Keyboard layout of the host, also stored in the option bytes: qwerty, azerty, qwertz, czech, dvorak\n"
+		"            (default: qwerty). Ignored by the macos mode\n"
+		"  -x FILE   Compose file of the host for the compose mode (default: %s)\n"
+		"  -H        The host runs the helper of the vendor interface, which types the UTF-8 text sent by the firmware\n"
+		"  -s        Set the sitelen pona punctuation/extra trailing space option\n"
+		"  -E        Set the eager commit option\n"
+		"  -u US     USB polling interval of the host (default: %u)\n"
+		"  -l LEDS   Initial lock LED state of the host. Bit 0: Num Lock, bit 1: Caps Lock, bit 2: Scroll Lock\n"
+		"  -e US     Delay of the LED output report of the host. Negative: never sent (default: %d)\n"
+		"  -c N      CPU cycles per executed basic block (default: %u)\n"
+		"  -i HZ     The display doesn't acknowledge the transfers faster than this I2C clock rate (default: no limit)\n",
+		name, sim_config.compose_path, (unsigned)sim_config.usb_poll_interval_us, (int)sim_config.host_led_echo_delay_us, (unsigned)sim_config.cycles_per_block);
+}
+
+int main(int argc, char *argv[]) {
+	static const char *mode_names[] = {"latin", "windows", "linux", "macos", "compose"};
+	static const char *layout_names[] = {"qwerty", "azerty", "qwertz", "czech", "dvorak"};
+	uint8_t config = 0;
+	int opt;
+	while((opt = getopt(argc, argv, "o:m:k:x:HsEu:l:e:c:i:h")) != -1) {
+		switch(opt) {
+			case 'o':
+				sim_config.output_dir = optarg;
+			break;
+			case 'm':
+			{
+				size_t i;
+				for(i=0; i<sizeof(mode_names)/sizeof(*mode_names) && strcmp(optarg, mode_names[i]); i++);
+				if(i >= sizeof(mode_names)/sizeof(*mode_names)) {
+					sim_main_usage(argv[0]);
+					return 2;
+				}
+				config = (config & ~0x07) | i;
+				sim_config.host_input_method = i;
+			}
+			break;
+			case 'k':
+			{
+				size_t i;
+				for(i=0; i<sizeof(layout_names)/sizeof(*layout_names) && strcmp(optarg, layout_names[i]); i++);
+				if(i >= sizeof(layout_names)/sizeof(*layout_names)) {
+					sim_main_usage(argv[0]);
+					return 2;
+				}
+				config = (config & ~0xE0) | (i << 5);
+				sim_config.host_layout = i;
+			}
+			break;
+			case 'x':
+				sim_config.compose_path = optarg;
+			break;
+			case 'H':
+				sim_config.host_helper = 1;
+			break;
+			case 's':
+				config |= 0x08;
+			break;
+			case 'E':
+				config |= 0x10;
+			break;
+			case 'u':
+				sim_config.usb_poll_interval_us = strtoul(optarg, NULL, 0);
+			break;
+			case 'l':
+				sim_config.host_leds = strtoul(optarg, NULL, 0);
+			break;
+			case 'e':
+				sim_config.host_led_echo_delay_us = strtol(optarg, NULL, 0);
+			break;
+			case 'c':
+				sim_config.cycles_per_block = strtoul(optarg, NULL, 0);
+			break;
+			case 'i':
+				sim_config.i2c_clockrate_max = strtoul(optarg, NULL, 0);
+			break;
+			default:
+				sim_main_usage(argv[0]);
+				return 2;
+		}
+	}
+	if(optind+1 != argc || !sim_config.usb_poll_interval_us) {
+		sim_main_usage(argv[0]);
+		return 2;
+	}
+	if(sim_config.output_dir) {
+		mkdir(sim_config.output_dir, 0777);
+	}
+
+	// Option bytes: struct ilonena_config in Data0, with the inverted copy in the upper byte
+	OB->Data0 = ((~config & 0xFF) << 8) | config;
+
+	if(sim_main_load_timeline(argv[optind])) {
+		return 2;
+	}
+	int ret = sim_run(ilonena_main, sim_main_time + SIM_MAIN_TAIL_MS*SIM_CYCLES_PER_MS);
+	sim_write_report();
+	printf("typed text:\n");
+	sim_host_print_text();
+	return ret;
+}
@@ -0,0 +1,98 @@
+#!/usr/bin/python3
+
+# Copyright 2025 Wong Cho Ching <https://sadale.net>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# Compares the strings decoded by the firmware (./bench_strings -d) with unpack_ascii_string() of
+# generate_lookup_table.py, for every string of LOOKUP_CODEPAGE_0 and LOOKUP_CODEPAGE_1 in generated.c.
+# Usage: python3 test_ascii_strings.py (or make test)
+
+import ast
+import os
+import re
+import subprocess
+import sys
+
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+GENERATOR_PATH = os.path.join(SIM_DIR, '..', 'scripts', 'generate_lookup_table.py')
+GENERATED_PATH = os.path.join(SIM_DIR, '..', 'generated.c')
+
+# The generator can't be imported: it generates the tables on import. Take the functions and constants out of it.
+def load_generator(names):
+	with open(GENERATOR_PATH) as f:
+		tree = ast.parse(f.read())
+	body = []
+	for node in tree.body:
+		if isinstance(node, ast.FunctionDef) and node.name in names:
+			body.append(node)
+		elif isinstance(node, ast.Assign) and any(isinstance(t, ast.Name) and t.id in names for t in node.targets):
+			body.append(node)
+	namespace = {}
+	exec(compile(ast.Module(body=body, type_ignores=[]), GENERATOR_PATH, 'exec'), namespace)
+	return namespace
+
+def load_array(source, name):
+	array = re.search(r'const uint\d+_t ' + name + r'\[\] = \{(.*?)\};', source, re.S).group(1)
+	return [int(value, 16) for value in re.findall(r'0x([0-9A-F]+)', array)]
+
+def load_symbols(data):
+	stream = int.from_bytes(bytes(data), 'little')
+	return [(stream >> (i*5)) & 0x1F for i in range(len(data)*8//5)]
+
+with open(GENERATED_PATH) as f:
+	generated_source = f.read()
+generator = load_generator(['ASCII_STRING_SYMBOL_EXTRA', 'ASCII_STRING_SYMBOL_ESCAPE', 'LOOKUP_STRING_CHECKPOINT_INTERVAL', 'unpack_ascii_string'])
+extra_symbols = ast.literal_eval(re.search(r'const char LOOKUP_ASCII_STRING_EXTRA_SYMBOLS\[\] = ("(?:[^"\\]|\\.)*");', generated_source).group(1))
+codepages = {}
+for codepage in (0, 1):
+	name = f'LOOKUP_CODEPAGE_{codepage}'
+	codepages[codepage] = (load_symbols(load_array(generated_source, name)),
+		load_array(generated_source, name + '_CHECKPOINT'),
+		load_array(generated_source, name + '_OFFSET'))
+
+output = subprocess.run([os.path.join(SIM_DIR, 'bench_strings'), '-d'], check=True, capture_output=True, text=True).stdout
+errors = 0
+count = 0
+for line in output.split('\n'):
+	if not line:
+		continue
+	fields = line.split(' ')
+	codepage = int(fields[0])
+	index = int(fields[1])
+	actual = bytes.fromhex(fields[2]).decode()
+	symbols, checkpoints, offsets = codepages[codepage]
+	position = checkpoints[index//generator['LOOKUP_STRING_CHECKPOINT_INTERVAL']] + offsets[index]
+	expected = generator['unpack_ascii_string'](symbols, position, extra_symbols)
+	count += 1
+	if actual != expected:
+		print(f'Mismatch for string #{index} of codepage {codepage}: expected {expected!r}, got {actual!r}')
+		errors += 1
+
+if count != sum(len(offsets) for _, _, offsets in codepages.values()):
+	print(f'{count} strings got decoded, but there are more in generated.c')
+	errors += 1
+print(f'{count} strings compared with unpack_ascii_string(), {errors} errors')
+sys.exit(1 if errors else 0)
@@ -0,0 +1,95 @@
+#!/usr/bin/python3
+
+# Copyright 2025 Wong Cho Ching <https://sadale.net>
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# Compares the images decompressed by the firmware (./bench_font -d) with font_decompress() of
+# generate_lookup_table.py, for every image of FONT_CODEPAGE_* in generated.c.
+# Usage: python3 test_font_decompress.py (or make test)
+
+import ast
+import os
+import re
+import subprocess
+import sys
+
+SIM_DIR = os.path.dirname(os.path.abspath(__file__))
+GENERATOR_PATH = os.path.join(SIM_DIR, '..', 'scripts', 'generate_lookup_table.py')
+GENERATED_PATH = os.path.join(SIM_DIR, '..', 'generated.c')
+
+# The generator can't be imported: it generates the tables on import. Take font_decompress() out of it.
+def load_font_decompress():
+	with open(GENERATOR_PATH) as f:
+		tree = ast.parse(f.read())
+	function = next(node for node in tree.body if isinstance(node, ast.FunctionDef) and node.name == 'font_decompress')
+	namespace = {}
+	exec(compile(ast.Module(body=[function], type_ignores=[]), GENERATOR_PATH, 'exec'), namespace)
+	return namespace['font_decompress']
+
+# Each image of the FONT_CODEPAGE_* arrays is on its own line, followed by a comment with its codepoint
+def load_compressed_images(source):
+	ret = {}
+	for line in source.split('\n'):
+		match = re.match(r'\t((?:0x[0-9A-F]{2}, )+)// U\+([0-9A-F]+)$', line)
+		if match:
+			ret[int(match.group(2), 16)] = bytes(int(b, 16) for b in re.findall(r'0x([0-9A-F]{2})', match.group(1)))
+	return ret
+
+# (FONT_DICTIONARY_INDEX_BITS, FONT_DICTIONARY)
+def load_font_dictionary(source):
+	index_bits = int(re.search(r'const uint8_t FONT_DICTIONARY_INDEX_BITS = (\d+);', source).group(1))
+	dictionary = re.search(r'const uint16_t FONT_DICTIONARY\[\] = \{(.*?)\};', source, re.S).group(1)
+	return index_bits, [int(u16, 16) for u16 in re.findall(r'0x([0-9A-F]{4})U', dictionary)]
+
+with open(GENERATED_PATH) as f:
+	generated_source = f.read()
+font_decompress = load_font_decompress()
+compressed_images = load_compressed_images(generated_source)
+font_dictionary = load_font_dictionary(generated_source)
+
+output = subprocess.run([os.path.join(SIM_DIR, 'bench_font'), '-d'], check=True, capture_output=True, text=True).stdout
+errors = 0
+count = 0
+for line in output.split('\n'):
+	if not line:
+		continue
+	fields = line.split()
+	codepoint = int(fields[0], 16)
+	actual = [int(column, 16) for column in fields[1:]]
+	data = font_decompress(compressed_images[codepoint], font_dictionary)
+	expected = [data[i*2] | (data[i*2+1] << 8) for i in range(15)]
+	count += 1
+	if actual != expected:
+		print(f'Mismatch for U+{codepoint:X}')
+		print(' '.join([f'{c:04X}' for c in expected]))
+		print(' '.join([f'{c:04X}' for c in actual]))
+		errors += 1
+
+if count != len(compressed_images):
+	print(f'{len(compressed_images)} images in generated.c, but {count} of them got decompressed')
+	errors += 1
+print(f'{count} images compared with font_decompress(), {errors} errors')
+sys.exit(1 if errors else 0)
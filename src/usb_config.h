@@ -15,8 +15,18 @@
 #define STR_PRODUCT      u"ilo nena"
 #define STR_SERIAL       u""
 
+// 1: Adds the vendor-defined interface for the helper on the host, on endpoint 2. See vendor_hid_desc below.
+// It takes about 1KB of flash, which doesn't fit along with the rest.
+#ifndef USB_VENDOR_INTERFACE
+#define USB_VENDOR_INTERFACE (0)
+#endif
+
 //Defines the number of endpoints for this device. (Always add one for EP0). For two EPs, this should be 3.
+#if USB_VENDOR_INTERFACE
+#define ENDPOINTS 3
+#else
 #define ENDPOINTS 2
+#endif
 
 #define USB_PORT C     // [A,C,D] GPIO Port to use with D+, D- and DPU
 #define USB_PIN_DP 4   // [0-4] GPIO Number for USB D+ Pin
@@ -97,6 +107,26 @@ static const uint8_t keyboard_hid_desc[] = {   /* USB report descriptor */
     HID_COLLECTION_END,                               // END_COLLECTION
 };
 
+#if USB_VENDOR_INTERFACE
+// Vendor-defined interface for sending the committed text as UTF-8 to the helper on the host (scripts/ilonena_helper.py).
+// Input report: the amount of bytes used (0~7), then the bytes of the UTF-8 stream. A codepoint might be split across reports.
+// Output report: sent by the helper for announcing itself. See keyboard_vendor_is_active() in keyboard.c
+static const uint8_t vendor_hid_desc[] = {
+	HID_USAGE_PAGE_N( HID_USAGE_PAGE_VENDOR, 2 ),    // USAGE_PAGE (Vendor Defined 0xFF00)
+	HID_USAGE( 0x01 ),                                // USAGE (0x01)
+	HID_COLLECTION ( HID_COLLECTION_APPLICATION ),    // COLLECTION (Application)
+		HID_REPORT_SIZE( 8 ),                         //     REPORT_SIZE (8)
+		HID_REPORT_COUNT( 8 ),                        //     REPORT_COUNT (8)
+		HID_LOGICAL_MIN( 0 ),                         //     LOGICAL_MINIMUM (0)
+		HID_LOGICAL_MAX_N( 0xFF, 2 ),                 //     LOGICAL_MAXIMUM (255)
+		HID_USAGE( 0x02 ),                            //     USAGE (0x02)
+		HID_INPUT( 0x02 ),                            //     INPUT (Data,Var,Abs) ; Length and UTF-8 bytes
+		HID_USAGE( 0x03 ),                            //     USAGE (0x03)
+		HID_OUTPUT( 0x02 ),                           //     OUTPUT (Data,Var,Abs) ; Announcement of the helper
+	HID_COLLECTION_END,                               // END_COLLECTION
+};
+#endif
+
 //Ever wonder how you have more than 6 keys down at the same time on a USB keyboard?  It's easy. Enumerate two keyboards!
 // No, really, that's what some hardware manufacturers do.
 
@@ -105,8 +135,13 @@ static const uint8_t config_descriptor[] = {  //Mostly stolen from a USB mouse I
 	// Configuration Descriptor
 	9, 					// bLength;
 	2,					// bDescriptorType;
+#if USB_VENDOR_INTERFACE
+	0x42, 0x00,			// wTotalLength 
+	0x02,					// bNumInterfaces (Keyboard and vendor)
+#else
 	0x22, 0x00,			// wTotalLength 
 	0x01,					// bNumInterfaces (Normally 1)
+#endif
 	0x01,					// bConfigurationValue
 	0x00,					// iConfiguration
 	0x80,					// bmAttributes (was 0xa0)
@@ -139,6 +174,44 @@ static const uint8_t config_descriptor[] = {  //Mostly stolen from a USB mouse I
 	0x03, //Attributes (Transfer type: Interrupt)
 	0x08,	0x00, //Size (8 bytes)
 	3, //Interval Number of milliseconds between polls.
+
+#if USB_VENDOR_INTERFACE
+	// Vendor, Interface Descriptor
+	9,					// bLength
+	4,					// bDescriptorType
+	1,					// bInterfaceNumber
+	0,					// bAlternateSetting
+	2,					// bNumEndpoints
+	0x03,					// bInterfaceClass (0x03 = HID)
+	0x00,					// bInterfaceSubClass (No boot interface)
+	0x00,					// bInterfaceProtocol (None)
+	0,					// iInterface
+
+	// HID descriptor
+	9,					// bLength
+	0x21,					// bDescriptorType (HID)
+	0x10,0x01,		// bcdHID HID class specification release number (bcd 1.1)
+	0x00, // bCountryCode
+	0x01, // bNumDescriptors Number of HID class descriptors to follow
+	0x22, // bDescriptorType (HID)
+	sizeof(vendor_hid_desc), 0x00, // wDescriptorLength
+
+	// Endpoint descriptor
+	7, //endpoint descriptor (For endpoint 2)
+	0x05, //Endpoint Descriptor (Must be 5)
+	0x82, //Endpoint Address (IN endpoint, endpoint #2)
+	0x03, //Attributes (Transfer type: Interrupt)
+	0x08,	0x00, //Size (8 bytes)
+	3, //Interval Number of milliseconds between polls.
+
+	// Endpoint descriptor
+	7, //endpoint descriptor (For endpoint 2)
+	0x05, //Endpoint Descriptor (Must be 5)
+	0x02, //Endpoint Address (OUT endpoint, endpoint #2)
+	0x03, //Attributes (Transfer type: Interrupt)
+	0x08,	0x00, //Size (8 bytes)
+	10, //Interval Number of milliseconds between polls.
+#endif
 };
 
 struct usb_string_descriptor_struct {
@@ -177,6 +250,9 @@ const static struct descriptor_list_struct {
 	{0x00000100, device_descriptor, sizeof(device_descriptor)},
 	{0x00000200, config_descriptor, sizeof(config_descriptor)},
 	{0x00002200, keyboard_hid_desc, sizeof(keyboard_hid_desc)},
+#if USB_VENDOR_INTERFACE
+	{0x00012200, vendor_hid_desc, sizeof(vendor_hid_desc)},
+#endif
 	{0x00000300, (const uint8_t *)&string0, 4},
 	{0x04090301, (const uint8_t *)&string1, sizeof(STR_MANUFACTURER)},
 	{0x04090302, (const uint8_t *)&string2, sizeof(STR_PRODUCT)},	